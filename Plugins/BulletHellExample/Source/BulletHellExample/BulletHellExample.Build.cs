@@ -26,7 +26,7 @@ public class BulletHellExample : ModuleRules
 			new string[]
 			{
 				"Core","MassAIBehavior", "MassEntity", "MassCommon",
-				"MassNavigation", "MassSpawner", "MassMovement", "MassSignals", "MassLOD"
+				"MassNavigation", "MassSpawner", "MassMovement", "MassSignals", "MassLOD", "MassSpatialIndex"
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
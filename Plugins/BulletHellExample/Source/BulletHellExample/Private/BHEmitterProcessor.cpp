@@ -0,0 +1,127 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BHEmitterProcessor.h"
+
+#include "BHEmitterTrait.h"
+#include "BulletHellSubsystem.h"
+#include "MassCommonFragments.h"
+#include "MassExecutionContext.h"
+#include "ProfilingDebugging/ScopedTimers.h"
+
+
+/**
+ * @brief UBHEmitterProcessor类构造函数
+ */
+UBHEmitterProcessor::UBHEmitterProcessor()
+	: EntityQuery(*this)
+{
+}
+
+/**
+ * @brief 配置发射器查询条件
+ *
+ * 要求实体具有发射器状态片段(读写权限)、变换片段(只读权限)、发射器参数共享片段，
+ * 以及BulletHell子系统(读写权限，用于提交生成请求)
+ *
+ * @param EntityManager 共享引用的实体管理器
+ */
+void UBHEmitterProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddRequirement<FBHEmitterStateFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddConstSharedRequirement<FBHEmitterParams>();
+	EntityQuery.AddTagRequirement<FBHEmitterTag>(EMassFragmentPresence::All);
+	EntityQuery.AddSubsystemRequirement<UBulletHellSubsystem>(EMassFragmentAccess::ReadWrite);
+}
+
+/**
+ * @brief 为到期的发射器生成子弹请求
+ *
+ * 每个块在工作线程上独立生成本块所有发射器的子弹请求，整块一次性提交给子系统排队，
+ * 子系统在本帧 Tick 中按子弹配置合并、按发射器排序后批量生成。发射角度只取决于模拟刻度，
+ * 生成顺序只取决于发射器，因此结果可复现。
+ *
+ * @param EntityManager 实体管理器引用
+ * @param Context 执行上下文引用
+ */
+void UBHEmitterProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	// 性能统计：记录发射器更新的耗时
+	BulletHell::Stats::EmitterTimeSec = 0.0;
+	FScopedDurationTimer DurationTimer(BulletHell::Stats::EmitterTimeSec);
+
+	EntityQuery.ParallelForEachEntityChunk(Context, [](FMassExecutionContext& Context)
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(UpdateBulletEmitters)
+
+			auto& BulletHellSubsystem = Context.GetMutableSubsystemChecked<UBulletHellSubsystem>();
+			const FBHEmitterParams& Params = Context.GetConstSharedFragment<FBHEmitterParams>();
+			auto StateFragments = Context.GetMutableFragmentView<FBHEmitterStateFragment>();
+			auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
+
+			if (!Params.BulletConfig)
+			{
+				return;
+			}
+
+			const uint32 CurrentTick = BulletHellSubsystem.GetCurrentTick();
+			const uint32 CadenceTicks = UBulletHellSubsystem::SecondsToTicks(Params.Cadence);
+			const int32 BulletsPerShot = FMath::Max(Params.BulletsPerShot, 1);
+			const float Time = CurrentTick * BulletHell::TickInterval;
+
+			const FBHTargetSet& Targets = BulletHellSubsystem.GetTargets();
+			FVector PlayerLocation;
+			BulletHellSubsystem.GetPlayerLocation(PlayerLocation);
+
+			TArray<FBHBulletSpawnRequest> Requests;
+
+			const int32 NumEntities = Context.GetNumEntities();
+			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+			{
+				auto& StateFragment = StateFragments[EntityIdx];
+				if (CurrentTick < StateFragment.NextShotTick)
+				{
+					continue;
+				}
+
+				// 落后超过一个间隔时不补发，直接从当前刻度重新计时
+				StateFragment.NextShotTick = FMath::Max(StateFragment.NextShotTick + CadenceTicks, CurrentTick + 1);
+
+				const FTransform& Transform = TransformFragments[EntityIdx].GetTransform();
+				const FVector Location = Transform.GetLocation();
+
+				// 根据模式计算第一颗子弹的角度和相邻子弹的角度间隔（度）
+				float BaseYaw = Transform.Rotator().Yaw;
+				float YawStep = 360.f / BulletsPerShot;
+				switch (Params.Pattern)
+				{
+				case EBHEmitterPattern::Spiral:
+					BaseYaw += Params.AngularVelocity * Time;
+					break;
+				case EBHEmitterPattern::AimedFan:
+				{
+					// 瞄准最近的目标
+					int32 TargetIdx = INDEX_NONE;
+					Targets.FindNearest(MakeArrayView(&Location, 1), MakeArrayView(&TargetIdx, 1));
+					const FVector AimLocation = TargetIdx != INDEX_NONE ? Targets.GetLocation(TargetIdx) : PlayerLocation;
+					BaseYaw = FMath::RadiansToDegrees(FMath::Atan2(AimLocation.Y - Location.Y, AimLocation.X - Location.X));
+					YawStep = BulletsPerShot > 1 ? Params.FanAngle / (BulletsPerShot - 1) : 0.f;
+					BaseYaw -= YawStep * (BulletsPerShot - 1) * 0.5f;
+					break;
+				}
+				default:
+					break;
+				}
+
+				for (int32 BulletIdx = 0; BulletIdx < BulletsPerShot; BulletIdx++)
+				{
+					float Sin, Cos;
+					FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(BaseYaw + YawStep * BulletIdx));
+					Requests.Add({ Location, FVector(Cos, Sin, 0.f), Context.GetEntity(EntityIdx) });
+				}
+			}
+
+			BulletHellSubsystem.QueueBulletSpawns(Params.BulletConfig, Requests);
+		});
+}
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BHEmitterTrait.h"
+
+#include "MassCommonFragments.h"
+#include "MassEntityTemplateRegistry.h"
+#include "MassEntityUtils.h"
+#include "Engine/World.h"
+
+/**
+ * 构建发射器实体模板
+ * @param BuildContext 实体模板构建上下文
+ * @param World 当前游戏世界
+ */
+void UBHEmitterTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+	FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
+
+	// 相同参数的发射器共用一个常量共享片段
+	const FConstSharedStruct& ParamsSharedStruct = EntityManager.GetOrCreateConstSharedFragment(EmitterParams);
+	BuildContext.AddConstSharedFragment(ParamsSharedStruct);
+
+	BuildContext.AddFragment<FBHEmitterStateFragment>();
+	BuildContext.AddTag<FBHEmitterTag>();
+	BuildContext.RequireFragment<FTransformFragment>();
+}
@@ -3,6 +3,7 @@
 
 #include "BHEnemyProcessor.h"
 
+#include "BHFlowFieldSubsystem.h"
 #include "BulletHellEnemyTrait.h"
 
 #include "BulletHellSubsystem.h"
@@ -10,90 +11,116 @@
 #include "MassExecutionContext.h"
 #include "MassNavigationFragments.h"
 #include "MassSimulationLOD.h"
+#include "ProfilingDebugging/ScopedTimers.h"
 
+//沿流场方向设置移动目标时的前视距离
+static float FlowLookAhead = 100.f;
 
 /**
- * @brief UBHEnemyProcessor๹캯
+ * @brief UBHEnemyProcessor类构造函数
  * 
- * ʼEntityQueryUpdateHashGridQueryѯ󣬽ǰʵΪ
+ * 初始化EntityQuery查询对象，将当前处理器实例作为参数传入
  */
 UBHEnemyProcessor::UBHEnemyProcessor()
-	: EntityQuery(*this),
-	UpdateHashGridQuery(*this)
+	: EntityQuery(*this)
 {
 }
 
 /**
- * @brief ʵѯ
+ * @brief 配置实体查询条件
  * 
- * Ҫѯ(EntityQueryUpdateHashGridQuery)ƬΡϵͳͱǩҪ
- * ںBullet HellϷϵͳдʵ
+ * 设置EntityQuery所需的片段、子系统和标签要求，用于后续在Bullet Hell游戏系统中处理敌人实体。
+ * 敌人在网格中的位置由统一空间索引每帧更新，这里不再维护
  * 
- * @param EntityManager õʵṩʵݷʺ͹
+ * @param EntityManager 共享引用的实体管理器，提供实体数据访问和管理功能
  */
 void UBHEnemyProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
-	// ʵѯڴ˵ƶΪ߼
-	// ҪʵƶĿƬ(дȨ)任Ƭ(ֻȨ)BulletHellϵͳ(ֻȨ)
-	// ˱ǩѡ԰ģ̶ȿƬŻ
+	// 配置主实体查询条件：用于处理敌人的移动和行为逻辑
+	// 要求实体具有移动目标片段(读写权限)、变换片段(只读权限)、BulletHell子系统和流场子系统(只读权限)
+	// 必须包含敌人标签，可选择性包含模拟变量刻度块片段用于性能优化
 	EntityQuery.AddRequirement<FMassMoveTargetFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery.AddSubsystemRequirement<UBulletHellSubsystem>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddSubsystemRequirement<UBHFlowFieldSubsystem>(EMassFragmentAccess::ReadOnly);
 	EntityQuery.AddTagRequirement<FBHEnemyTag>(EMassFragmentPresence::All);
 
 	EntityQuery.AddChunkRequirement<FMassSimulationVariableTickChunkFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
 	EntityQuery.SetChunkFilter(FMassSimulationVariableTickChunkFragment::ShouldTickChunkThisFrame);
-
-	// ø¹ϣѯάڿռеλϢ
-	// ҪʵеƬ(дȨ)任Ƭ(ֻȨ)BulletHellϵͳ(дȨ)
-	// ѡ԰ģ̶ȿƬŻ
-	UpdateHashGridQuery.AddRequirement<FBHEnemyFragment>(EMassFragmentAccess::ReadWrite);
-	UpdateHashGridQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
-	UpdateHashGridQuery.AddSubsystemRequirement<UBulletHellSubsystem>(EMassFragmentAccess::ReadWrite);
-
-	UpdateHashGridQuery.AddChunkRequirement<FMassSimulationVariableTickChunkFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
-	UpdateHashGridQuery.SetChunkFilter(FMassSimulationVariableTickChunkFragment::ShouldTickChunkThisFrame);
 }
 
 /**
- * @brief ִе˵Ϊ߼£ƶĿĸϣλõĸ¡
+ * @brief 执行敌人的行为逻辑更新。
  *
- * ˺ͨʵ飨Entity ChunkķʽʵΪ߼Ҫ
- * 1. ÿ˵ƶĿ꣬ʹ䳯ңݾǷҪʼƶֹͣ
- * 2. µڹϣеλϢںĿռѯײŻ
+ * 此函数通过遍历实体块（Entity Chunk）的方式处理大量敌人实体的行为逻辑：
+ * 采样流场更新每个敌人的移动目标，使其绕开障碍物朝向最近的目标，并根据距离决定是否需要开始移动或停止。
  *
- * @param EntityManager ʵãṩʵ弰ķ
- * @param Context ǰִģǰδʵԼϵͳϢ
+ * @param EntityManager 实体管理器引用，提供对所有实体及其组件的访问能力。
+ * @param Context 当前执行上下文，包含当前批次处理的实体以及相关子系统等信息。
  */
 void UBHEnemyProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
 {
-	// ʵԸµ˵ƶĿ
+	// 性能统计：记录敌人移动的耗时
+	BulletHell::Stats::EnemyTimeSec = 0.0;
+	FScopedDurationTimer DurationTimer(BulletHell::Stats::EnemyTimeSec);
+
+	// 遍历实体块以更新敌人的移动目标
 	EntityQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
 		{
 			SCOPED_NAMED_EVENT(STAT_UpdateMoveTarget, FColor::Red);
 
-			// ȡϵͳƬͼ
+			// 获取所需子系统及片段视图
 			auto BulletHellSubsystem = Context.GetSubsystem<UBulletHellSubsystem>();
+			auto FlowFieldSubsystem = Context.GetSubsystem<UBHFlowFieldSubsystem>();
 			auto MoveTargetFragments = Context.GetMutableFragmentView<FMassMoveTargetFragment>();
 			auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
 
 			const int32 NumEntities = Context.GetNumEntities();
 
-			// ǰÿһʵ
+			// 整块一次查询每个敌人最近的目标
+			TArray<FVector, TInlineAllocator<256>> EntityLocations;
+			EntityLocations.SetNumUninitialized(NumEntities);
 			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
 			{
-				auto& MoveTargetFragment = MoveTargetFragments[EntityIdx];
-				auto& TransformFragment = TransformFragments[EntityIdx];
+				EntityLocations[EntityIdx] = TransformFragments[EntityIdx].GetTransform().GetLocation();
+			}
 
-				// ƶĿΪĵ㣨λã
-				BulletHellSubsystem->GetPlayerLocation(MoveTargetFragment.Center);
+			const FBHTargetSet& Targets = BulletHellSubsystem->GetTargets();
+			TArray<int32, TInlineAllocator<256>> NearestTargets;
+			NearestTargets.SetNumUninitialized(NumEntities);
+			Targets.FindNearest(EntityLocations, NearestTargets);
 
-				// 㵱ǰλõĿľͷ
-				auto EntityLocation = TransformFragment.GetTransform().GetLocation();
-				MoveTargetFragment.DistanceToGoal = FVector::Dist(EntityLocation, MoveTargetFragment.Center);
-				MoveTargetFragment.Forward = (MoveTargetFragment.Center - EntityLocation).GetSafeNormal();
+			// 遍历当前块中每一个实体
+			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+			{
+				auto& MoveTargetFragment = MoveTargetFragments[EntityIdx];
+				const FVector& EntityLocation = EntityLocations[EntityIdx];
+
+				// 优先采样流场：移动目标为沿流场方向前方一个格子的位置，距离为到玩家的路径距离
+				FVector FlowDirection;
+				float FlowDistance;
+				if (FlowFieldSubsystem && FlowFieldSubsystem->SampleFlowField(EntityLocation, FlowDirection, FlowDistance))
+				{
+					MoveTargetFragment.Center = EntityLocation + FlowDirection * FMath::Min(FlowDistance, FlowLookAhead);
+					MoveTargetFragment.DistanceToGoal = FlowDistance;
+					MoveTargetFragment.Forward = FlowDirection;
+				}
+				else
+				{
+					// 流场外或已在目标所在格子时，直接以最近目标的位置为移动目标
+					if (NearestTargets[EntityIdx] != INDEX_NONE)
+					{
+						MoveTargetFragment.Center = Targets.GetLocation(NearestTargets[EntityIdx]);
+					}
+					else
+					{
+						BulletHellSubsystem->GetPlayerLocation(MoveTargetFragment.Center);
+					}
+					MoveTargetFragment.DistanceToGoal = FVector::Dist(EntityLocation, MoveTargetFragment.Center);
+					MoveTargetFragment.Forward = (MoveTargetFragment.Center - EntityLocation).GetSafeNormal();
+				}
 
-				// ݵǰ״̬;лվʱԶΪƶƶʱӽΪվ
+				// 根据当前动作状态和距离切换动作：站立时若远离则改为移动；移动时接近则改为站立
 				if (MoveTargetFragment.GetCurrentAction() == EMassMovementAction::Stand && MoveTargetFragment.DistanceToGoal > 50.f)
 				{
 					MoveTargetFragment.CreateNewAction(EMassMovementAction::Move, *Context.GetWorld());
@@ -105,150 +132,4 @@ void UBHEnemyProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutio
 				}
 			}
 		});
-
-	// ʵԸµڹϣеλ
-	UpdateHashGridQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
-		{
-			SCOPED_NAMED_EVENT(STAT_UpdateHashGrid, FColor::Red);
-
-			// ȡɱϵͳƬͼ
-			auto BulletHellSubsystem = Context.GetMutableSubsystem<UBulletHellSubsystem>();
-			auto BHEnemyFragments = Context.GetMutableFragmentView<FBHEnemyFragment>();
-			auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
-
-			const int32 NumEntities = Context.GetNumEntities();
-
-			// ǰÿһʵ
-			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
-			{
-				auto TransformFragment = TransformFragments[EntityIdx];
-				auto& BHEnemyFragment = BHEnemyFragments[EntityIdx];
-
-				// ȡʵ겢ڹϣеĸλ
-				auto Location = TransformFragment.GetTransform().GetLocation();
-				BHEnemyFragment.CellLocation = BulletHellSubsystem->GetHashGrid_Mutable().Move(
-					Context.GetEntity(EntityIdx),
-					BHEnemyFragment.CellLocation,
-					FBox::BuildAABB(Location, BHEnemyFragment.CollisionExtent)
-				);
-			}
-		});
-}
-
-
-
-/**
- * 캯ʼUBHEnemyInitializer
- * 
- * ʼEntityQueryԱù۲ΪFBHEnemyTagṹ壬
- * ΪӲ
- */
-UBHEnemyInitializer::UBHEnemyInitializer()
-	: EntityQuery(*this)
-{
-	ObservedType = FBHEnemyTag::StaticStruct();
-	Operation = EMassObservedOperation::Add;
-}
-
-/**
- * ʵѯҪ
- * 
- * @param EntityManager õʵڹʵ
- * 
- * úΪEntityQueryӱҪҪ
- * - FTransformFragmentֻʣڻȡʵ任Ϣ
- * - FBHEnemyFragmentдʣڴ
- * - UBulletHellSubsystemдʣڷӵϵͳ
- */
-void UBHEnemyInitializer::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
-{
-	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
-	EntityQuery.AddRequirement<FBHEnemyFragment>(EMassFragmentAccess::ReadWrite);
-	EntityQuery.AddSubsystemRequirement<UBulletHellSubsystem>(EMassFragmentAccess::ReadWrite);
-}
-
-/**
- * @brief ˳ʼִкÿʵгʼ˵ĹϣλϢ
- * 
- * @param EntityManager ʵãڹϷеʵ
- * @param Context ִãṩǰִлϢͲӿ
- */
-void UBHEnemyInitializer::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
-{
-	// ʵ飬ΪÿʵʼڹϣеλϢ
-	EntityQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
-		{
-			// ȡ任ƬΡƬκӵϵͳͼ
-			auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
-			auto BHEnemyFragments = Context.GetMutableFragmentView<FBHEnemyFragment>();
-			auto BulletHellSubsystem = Context.GetMutableSubsystem<UBulletHellSubsystem>();
-			auto& HashGrid = BulletHellSubsystem->GetHashGrid_Mutable();
-
-			const int32 NumEntities = Context.GetNumEntities();
-			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
-			{
-				// ȡǰʵĵƬκλϢӵϣ
-				auto& BHEnemyFragment = BHEnemyFragments[EntityIdx];
-				auto TransformFragment = TransformFragments[EntityIdx];
-				auto Location = TransformFragment.GetTransform().GetLocation();
-
-				BHEnemyFragment.CellLocation = HashGrid.Add(Context.GetEntity(EntityIdx), FBox::BuildAABB(Location, BHEnemyFragment.CollisionExtent));
-			}
-		});
-}
-
-
-/**
- * 캯ʼUBHEnemyDestructor
- * 
- * ʼEntityQueryù۲ΪFBHEnemyFragmentṹ壬
- * ΪƳ
- */
-UBHEnemyDestructor::UBHEnemyDestructor()
-	: EntityQuery(*this)
-{
-	ObservedType = FBHEnemyFragment::StaticStruct();
-	Operation = EMassObservedOperation::Remove;
 }
-
-/**
- * òѯ
- * 
- * @param EntityManager ʵĹãòѯƬκϵͳҪ
- * 
- * ӶFBHEnemyFragmentƬεֻͶUBulletHellSubsystemϵͳĶд
- */
-void UBHEnemyDestructor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
-{
-	EntityQuery.AddRequirement<FBHEnemyFragment>(EMassFragmentAccess::ReadOnly);
-	EntityQuery.AddSubsystemRequirement<UBulletHellSubsystem>(EMassFragmentAccess::ReadWrite);
-}
-
-/**
- * ִ߼
- * 
- * @param EntityManager ʵãڹʵ
- * @param Context ִãǰִлϢ
- * 
- * ʵ飬ӹϣƳ˵λϢ
- */
-void UBHEnemyDestructor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
-{
-	EntityQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
-		{
-			// ȡƬͼӵϵͳ
-			auto BHEnemyFragments = Context.GetFragmentView<FBHEnemyFragment>();
-			auto BulletHellSubsystem = Context.GetMutableSubsystem<UBulletHellSubsystem>();
-			auto& HashGrid = BulletHellSubsystem->GetHashGrid_Mutable();
-
-			// ǰеʵ
-			const int32 NumEntities = Context.GetNumEntities();
-			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
-			{
-				auto& BHEnemyFragment = BHEnemyFragments[EntityIdx];
-
-				// ӹϣƳʵ弰λϢ
-				HashGrid.Remove(Context.GetEntity(EntityIdx), BHEnemyFragment.CellLocation);
-			}
-		});
-}
\ No newline at end of file
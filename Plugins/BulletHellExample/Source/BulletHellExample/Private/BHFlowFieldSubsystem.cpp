@@ -0,0 +1,360 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BHFlowFieldSubsystem.h"
+
+#include "BulletHellSubsystem.h"
+#include "CollisionQueryParams.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/ScopedTimers.h"
+
+//流场单元格边长
+static float FlowFieldCellSize = 100.f;
+static FAutoConsoleVariableRef CVarFlowFieldCellSize(TEXT("BulletHell.FlowField.CellSize"), FlowFieldCellSize, TEXT("流场单元格边长"));
+
+//流场每边的格子数，覆盖范围为 CellSize * GridSize
+static int32 FlowFieldGridSize = 128;
+static FAutoConsoleVariableRef CVarFlowFieldGridSize(TEXT("BulletHell.FlowField.GridSize"), FlowFieldGridSize, TEXT("流场每边的格子数"));
+
+//每帧最多执行的障碍物探测次数
+static int32 FlowFieldProbeBudget = 2048;
+static FAutoConsoleVariableRef CVarFlowFieldProbeBudget(TEXT("BulletHell.FlowField.ProbeBudget"), FlowFieldProbeBudget, TEXT("每帧最多执行的障碍物探测次数"));
+
+//障碍物探测盒的半高，探测盒以目标高度为中心，避免与地面相交
+static float FlowFieldProbeHalfHeight = 40.f;
+static FAutoConsoleVariableRef CVarFlowFieldProbeHalfHeight(TEXT("BulletHell.FlowField.ProbeHalfHeight"), FlowFieldProbeHalfHeight, TEXT("障碍物探测盒的半高"));
+
+namespace BulletHell::FlowField
+{
+	struct FOpenNode
+	{
+		float Distance;
+		int32 CellIndex;
+
+		bool operator<(const FOpenNode& Other) const { return Distance < Other.Distance; }
+	};
+
+	/**
+	 * 在工作线程上构建流场
+	 * @param Field 已设置好 Origin/CellSize/Size 的流场
+	 * @param Blocked 每个格子是否阻挡
+	 * @param Targets 目标的世界坐标（XY），作为 Dijkstra 的源点
+	 */
+	static void Build(FBHFlowField& Field, const TArray<uint8>& Blocked, const TArray<FVector2D>& Targets)
+	{
+		const int32 Size = Field.Size;
+		const int32 NumCells = Size * Size;
+		Field.Distance.Init(MAX_flt, NumCells);
+		Field.Direction.Init(FVector2f::ZeroVector, NumCells);
+
+		static const FIntPoint Offsets[8] = {
+			{ 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 },
+			{ 1, 1 }, { 1, -1 }, { -1, 1 }, { -1, -1 }
+		};
+
+		TArray<FOpenNode> Open;
+		Open.Reserve(NumCells);
+
+		// 目标所在格子作为源点
+		for (const FVector2D& Target : Targets)
+		{
+			const int32 X = FMath::FloorToInt32((Target.X - Field.Origin.X) / Field.CellSize);
+			const int32 Y = FMath::FloorToInt32((Target.Y - Field.Origin.Y) / Field.CellSize);
+			if (X < 0 || Y < 0 || X >= Size || Y >= Size)
+			{
+				continue;
+			}
+
+			const int32 CellIndex = Y * Size + X;
+			Field.Distance[CellIndex] = 0.f;
+			Open.HeapPush({ 0.f, CellIndex });
+		}
+
+		// Dijkstra，8邻域，对角移动不允许穿过阻挡格子的拐角
+		const float StraightCost = Field.CellSize;
+		const float DiagonalCost = Field.CellSize * UE_SQRT_2;
+		while (Open.Num() > 0)
+		{
+			FOpenNode Node;
+			Open.HeapPop(Node, EAllowShrinking::No);
+			if (Node.Distance > Field.Distance[Node.CellIndex])
+			{
+				continue;
+			}
+
+			const int32 X = Node.CellIndex % Size;
+			const int32 Y = Node.CellIndex / Size;
+			for (int32 OffsetIdx = 0; OffsetIdx < 8; OffsetIdx++)
+			{
+				const FIntPoint& Offset = Offsets[OffsetIdx];
+				const int32 NX = X + Offset.X;
+				const int32 NY = Y + Offset.Y;
+				if (NX < 0 || NY < 0 || NX >= Size || NY >= Size)
+				{
+					continue;
+				}
+
+				const int32 NeighborIndex = NY * Size + NX;
+				if (Blocked[NeighborIndex])
+				{
+					continue;
+				}
+
+				const bool bDiagonal = OffsetIdx >= 4;
+				if (bDiagonal && (Blocked[Y * Size + NX] || Blocked[NY * Size + X]))
+				{
+					continue;
+				}
+
+				const float NewDistance = Node.Distance + (bDiagonal ? DiagonalCost : StraightCost);
+				if (NewDistance < Field.Distance[NeighborIndex])
+				{
+					Field.Distance[NeighborIndex] = NewDistance;
+					Open.HeapPush({ NewDistance, NeighborIndex });
+				}
+			}
+		}
+
+		// 每个格子指向距离最小的可达邻格
+		for (int32 CellIndex = 0; CellIndex < NumCells; CellIndex++)
+		{
+			const float CellDistance = Field.Distance[CellIndex];
+			if (CellDistance == MAX_flt || CellDistance == 0.f)
+			{
+				continue;
+			}
+
+			const int32 X = CellIndex % Size;
+			const int32 Y = CellIndex / Size;
+			float BestDistance = CellDistance;
+			FVector2f BestDirection = FVector2f::ZeroVector;
+			for (int32 OffsetIdx = 0; OffsetIdx < 8; OffsetIdx++)
+			{
+				const FIntPoint& Offset = Offsets[OffsetIdx];
+				const int32 NX = X + Offset.X;
+				const int32 NY = Y + Offset.Y;
+				if (NX < 0 || NY < 0 || NX >= Size || NY >= Size)
+				{
+					continue;
+				}
+
+				// 与距离传播一致，对角方向不允许穿过阻挡格子的拐角
+				if (OffsetIdx >= 4 && (Blocked[Y * Size + NX] || Blocked[NY * Size + X]))
+				{
+					continue;
+				}
+
+				const float NeighborDistance = Field.Distance[NY * Size + NX];
+				if (NeighborDistance < BestDistance)
+				{
+					BestDistance = NeighborDistance;
+					BestDirection = FVector2f(Offset.X, Offset.Y);
+				}
+			}
+
+			Field.Direction[CellIndex] = BestDirection.GetSafeNormal();
+		}
+	}
+}
+
+bool FBHFlowField::Sample(const FVector& Location, FVector& OutDirection, float& OutDistance) const
+{
+	const int32 X = FMath::FloorToInt32((Location.X - Origin.X) / CellSize);
+	const int32 Y = FMath::FloorToInt32((Location.Y - Origin.Y) / CellSize);
+	if (X < 0 || Y < 0 || X >= Size || Y >= Size)
+	{
+		return false;
+	}
+
+	const int32 CellIndex = Y * Size + X;
+	const FVector2f& CellDirection = Direction[CellIndex];
+	if (Distance[CellIndex] == MAX_flt || CellDirection.IsZero())
+	{
+		return false;
+	}
+
+	OutDirection = FVector(CellDirection.X, CellDirection.Y, 0.f);
+	OutDistance = Distance[CellIndex];
+	return true;
+}
+
+/**
+ * 采样当前流场
+ * @param Location 采样位置
+ * @param OutDirection 输出前进方向
+ * @param OutDistance 输出到目标的路径距离
+ * @return 流场有效且位置可达时返回true
+ */
+bool UBHFlowFieldSubsystem::SampleFlowField(const FVector& Location, FVector& OutDirection, float& OutDistance) const
+{
+	return CurrentField.IsValid() && CurrentField->Sample(Location, OutDirection, OutDistance);
+}
+
+/**
+ * 子系统销毁时等待正在构建的流场任务结束
+ */
+void UBHFlowFieldSubsystem::Deinitialize()
+{
+	if (BuildTask.IsValid())
+	{
+		BuildTask.Wait();
+	}
+
+	Super::Deinitialize();
+}
+
+/**
+ * 每帧更新：取回已完成的流场，并在任一目标跨格、目标增减或障碍物尚未探测完时启动新的构建任务
+ * @param DeltaTime 距离上一帧的时间间隔（秒）
+ */
+void UBHFlowFieldSubsystem::Tick(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UpdateFlowField)
+
+	// 性能统计：记录游戏线程上流场更新（不含工作线程构建）的耗时
+	BulletHell::Stats::FlowFieldTimeSec = 0.0;
+	FScopedDurationTimer DurationTimer(BulletHell::Stats::FlowFieldTimeSec);
+
+	// 取回已完成的流场
+	if (BuildTask.IsValid())
+	{
+		if (!BuildTask.IsCompleted())
+		{
+			return;
+		}
+
+		CurrentField = BuildTask.GetResult();
+		BuildTask = UE::Tasks::TTask<TSharedPtr<FBHFlowField, ESPMode::ThreadSafe>>();
+	}
+
+	const UBulletHellSubsystem* BulletHellSubsystem = GetWorld()->GetSubsystem<UBulletHellSubsystem>();
+	if (!BulletHellSubsystem)
+	{
+		return;
+	}
+
+	const FBHTargetSet& TargetSet = BulletHellSubsystem->GetTargets();
+	if (TargetSet.IsEmpty())
+	{
+		return;
+	}
+
+	const float CellSize = FMath::Max(FlowFieldCellSize, 1.f);
+	const int32 Size = FMath::Clamp(FlowFieldGridSize, 8, 1024);
+
+	// 障碍物缓存以世界格子为键，格子边长变化后需要重新探测
+	if (CellSize != BlockedCellCacheCellSize)
+	{
+		BlockedCellCache.Reset();
+		BlockedCellCacheCellSize = CellSize;
+		LastTargetCells.Reset();
+	}
+
+	// 所有目标所在的世界格子，网格以它们的包围盒中心为中心；落在网格外的目标不参与构建
+	TArray<FIntPoint> TargetCells;
+	float ProbeZ = 0.f;
+	FIntRect TargetBounds(MAX_int32, MAX_int32, MIN_int32, MIN_int32);
+	for (int32 TargetIdx = 0; TargetIdx < TargetSet.Num(); TargetIdx++)
+	{
+		const FVector TargetLocation = TargetSet.GetLocation(TargetIdx);
+		const FIntPoint TargetCell(FMath::FloorToInt32(TargetLocation.X / CellSize), FMath::FloorToInt32(TargetLocation.Y / CellSize));
+		TargetCells.Add(TargetCell);
+		TargetBounds.Include(TargetCell);
+		ProbeZ += TargetLocation.Z / TargetSet.Num();
+	}
+
+	const bool bFieldIncomplete = CurrentField.IsValid() && CurrentField->NumUnprobedCells > 0;
+	if (TargetCells == LastTargetCells && !bFieldIncomplete)
+	{
+		return;
+	}
+
+	// 网格对齐到世界格子，使障碍物缓存可以在多次构建之间复用
+	const FIntPoint CenterCell = (TargetBounds.Min + TargetBounds.Max) / 2;
+	const FVector2D Origin((CenterCell.X - Size / 2) * CellSize, (CenterCell.Y - Size / 2) * CellSize);
+
+	TArray<uint8> Blocked;
+	const int32 NumUnprobedCells = GatherObstacles(Origin, CellSize, Size, ProbeZ, Blocked);
+
+	LastTargetCells = MoveTemp(TargetCells);
+
+	TArray<FVector2D> Targets;
+	for (int32 TargetIdx = 0; TargetIdx < TargetSet.Num(); TargetIdx++)
+	{
+		Targets.Add(FVector2D(TargetSet.GetLocation(TargetIdx)));
+	}
+
+	BuildTask = UE::Tasks::Launch(UE_SOURCE_LOCATION,
+		[Origin, CellSize, Size, NumUnprobedCells, Blocked = MoveTemp(Blocked), Targets = MoveTemp(Targets)]()
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(BuildFlowField)
+
+			TSharedPtr<FBHFlowField, ESPMode::ThreadSafe> Field = MakeShared<FBHFlowField, ESPMode::ThreadSafe>();
+			Field->Origin = Origin;
+			Field->CellSize = CellSize;
+			Field->Size = Size;
+			Field->NumUnprobedCells = NumUnprobedCells;
+			BulletHell::FlowField::Build(*Field, Blocked, Targets);
+			return Field;
+		});
+}
+
+/**
+ * 收集网格范围内的静态阻挡信息，已探测的格子直接读取缓存
+ * @param Origin 网格左下角世界坐标
+ * @param CellSize 单元格边长
+ * @param Size 网格每边的格子数
+ * @param ProbeZ 探测盒中心高度
+ * @param OutBlocked 输出每个格子是否阻挡，未探测的格子视为可通行
+ * @return 因超出本帧预算而未探测的格子数
+ */
+int32 UBHFlowFieldSubsystem::GatherObstacles(const FVector2D& Origin, float CellSize, int32 Size, float ProbeZ, TArray<uint8>& OutBlocked)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(GatherFlowFieldObstacles)
+
+	UWorld* World = GetWorld();
+	const FCollisionObjectQueryParams ObjectQueryParams(ECC_WorldStatic);
+	const FCollisionShape ProbeShape = FCollisionShape::MakeBox(FVector(CellSize * 0.45f, CellSize * 0.45f, FlowFieldProbeHalfHeight));
+	const FIntPoint OriginCell(FMath::RoundToInt32(Origin.X / CellSize), FMath::RoundToInt32(Origin.Y / CellSize));
+
+	int32 ProbesLeft = FlowFieldProbeBudget;
+	int32 NumUnprobedCells = 0;
+
+	OutBlocked.SetNumZeroed(Size * Size);
+	for (int32 Y = 0; Y < Size; Y++)
+	{
+		for (int32 X = 0; X < Size; X++)
+		{
+			const FIntPoint WorldCell(OriginCell.X + X, OriginCell.Y + Y);
+			if (const bool* bCachedBlocked = BlockedCellCache.Find(WorldCell))
+			{
+				OutBlocked[Y * Size + X] = *bCachedBlocked;
+				continue;
+			}
+
+			if (ProbesLeft <= 0)
+			{
+				NumUnprobedCells++;
+				continue;
+			}
+
+			ProbesLeft--;
+			const FVector CellCenter((WorldCell.X + 0.5f) * CellSize, (WorldCell.Y + 0.5f) * CellSize, ProbeZ);
+			const bool bBlocked = World->OverlapAnyTestByObjectType(CellCenter, FQuat::Identity, ObjectQueryParams, ProbeShape);
+			BlockedCellCache.Add(WorldCell, bBlocked);
+			OutBlocked[Y * Size + X] = bBlocked;
+		}
+	}
+
+	return NumUnprobedCells;
+}
+
+/**
+ * 获取统计ID函数，用于性能统计系统
+ * @return 返回当前子系统的统计标识符
+ */
+TStatId UBHFlowFieldSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBHFlowFieldSubsystem, STATGROUP_Tickables);
+}
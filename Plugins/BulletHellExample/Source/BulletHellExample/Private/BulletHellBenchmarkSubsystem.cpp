@@ -0,0 +1,290 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BulletHellBenchmarkSubsystem.h"
+
+#include "BulletHellSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformMisc.h"
+#include "MassEntityConfigAsset.h"
+#include "MassSpawnerSubsystem.h"
+#include "MassSpawnerTypes.h"
+#include "MassSpawnLocationProcessor.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+static FAutoConsoleCommandWithWorldAndArgs BenchmarkCommand(
+	TEXT("BulletHell.Benchmark"),
+	TEXT("运行 BulletHell 压测。参数：EnemyConfig= BulletConfig= Enemies= Bullets= Warmup= Frames= Radius= OrbitRadius= OrbitSpeed= Seed= -Exit。")
+	TEXT("Enemies>0 时必须指定 EnemyConfig=（没有默认的敌人配置），只压测子弹请传 Enemies=0；BulletConfig= 省略时使用 BulletHellSubsystem 的子弹配置"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UBulletHellBenchmarkSubsystem* BenchmarkSubsystem = World ? World->GetSubsystem<UBulletHellBenchmarkSubsystem>() : nullptr;
+			if (!BenchmarkSubsystem)
+			{
+				return;
+			}
+
+			FBHBenchmarkSettings Settings;
+			Settings.Parse(*FString::Join(Args, TEXT(" ")));
+			BenchmarkSubsystem->StartBenchmark(Settings);
+		}));
+
+/**
+ * 从 Key=Value 形式的字符串解析参数
+ * @param Stream 参数字符串
+ */
+void FBHBenchmarkSettings::Parse(const TCHAR* Stream)
+{
+	FParse::Value(Stream, TEXT("EnemyConfig="), EnemyConfigPath);
+	FParse::Value(Stream, TEXT("BulletConfig="), BulletConfigPath);
+	FParse::Value(Stream, TEXT("Enemies="), NumEnemies);
+	FParse::Value(Stream, TEXT("Bullets="), BulletsPerFrame);
+	FParse::Value(Stream, TEXT("Warmup="), WarmupFrames);
+	FParse::Value(Stream, TEXT("Frames="), NumFrames);
+	FParse::Value(Stream, TEXT("Radius="), SpawnRadius);
+	FParse::Value(Stream, TEXT("OrbitRadius="), TargetOrbitRadius);
+	FParse::Value(Stream, TEXT("OrbitSpeed="), TargetOrbitSpeed);
+	FParse::Value(Stream, TEXT("Seed="), Seed);
+	bExitWhenDone |= FParse::Param(Stream, TEXT("Exit"));
+
+	NumEnemies = FMath::Max(NumEnemies, 0);
+	BulletsPerFrame = FMath::Max(BulletsPerFrame, 0);
+	WarmupFrames = FMath::Max(WarmupFrames, 0);
+	NumFrames = FMath::Max(NumFrames, 1);
+}
+
+/**
+ * 开始压测：切换为合成目标，按种子生成敌人
+ * @param InSettings 压测参数
+ * @return 配置资产加载失败时返回false
+ */
+bool UBulletHellBenchmarkSubsystem::StartBenchmark(const FBHBenchmarkSettings& InSettings)
+{
+	if (bRunning)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("BulletHell benchmark is already running"));
+		return false;
+	}
+
+	UWorld* World = GetWorld();
+	UBulletHellSubsystem* BulletHellSubsystem = World->GetSubsystem<UBulletHellSubsystem>();
+	UMassSpawnerSubsystem* SpawnerSubsystem = World->GetSubsystem<UMassSpawnerSubsystem>();
+	if (!BulletHellSubsystem || !SpawnerSubsystem)
+	{
+		return false;
+	}
+
+	Settings = InSettings;
+
+	// 敌人配置没有默认值，未指定时直接失败，避免静默跑出零碰撞的结果
+	if (Settings.NumEnemies > 0 && Settings.EnemyConfigPath.IsEmpty())
+	{
+		UE_LOG(LogTemp, Error, TEXT("BulletHell benchmark: Enemies=%d requires EnemyConfig=, pass Enemies=0 to benchmark bullets only"),
+			Settings.NumEnemies);
+		return false;
+	}
+
+	UMassEntityConfigAsset* EnemyConfig = Settings.NumEnemies > 0 ? LoadObject<UMassEntityConfigAsset>(nullptr, *Settings.EnemyConfigPath) : nullptr;
+	BulletConfig = Settings.BulletConfigPath.IsEmpty() ? BulletHellSubsystem->BulletConfigAsset
+		: LoadObject<UMassEntityConfigAsset>(nullptr, *Settings.BulletConfigPath);
+	if ((Settings.NumEnemies > 0 && !EnemyConfig) || (Settings.BulletsPerFrame > 0 && !BulletConfig))
+	{
+		UE_LOG(LogTemp, Error, TEXT("BulletHell benchmark: failed to load entity configs (EnemyConfig=%s BulletConfig=%s)"),
+			*Settings.EnemyConfigPath, *Settings.BulletConfigPath);
+		return false;
+	}
+
+	RandomStream.Initialize(Settings.Seed);
+
+	// 合成目标绕原点运动，敌人在其外侧的环形区域生成
+	BulletHellSubsystem->SetSyntheticTarget(FVector::ZeroVector, Settings.TargetOrbitRadius, Settings.TargetOrbitSpeed);
+
+	if (Settings.NumEnemies > 0)
+	{
+		FMassTransformsSpawnData SpawnData;
+		SpawnData.Transforms.Reserve(Settings.NumEnemies);
+		for (int32 EnemyIdx = 0; EnemyIdx < Settings.NumEnemies; EnemyIdx++)
+		{
+			const float Angle = RandomStream.FRandRange(0.f, UE_TWO_PI);
+			const float Distance = RandomStream.FRandRange(Settings.SpawnRadius * 0.5f, Settings.SpawnRadius);
+			SpawnData.Transforms.Emplace(FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f) * Distance);
+		}
+
+		const FMassEntityTemplate& EntityTemplate = EnemyConfig->GetOrCreateEntityTemplate(*World);
+		TArray<FMassEntityHandle> EntitiesSpawned;
+		SpawnerSubsystem->SpawnEntities(EntityTemplate.GetTemplateID(), Settings.NumEnemies, FConstStructView::Make(SpawnData),
+			UMassSpawnLocationProcessor::StaticClass(), EntitiesSpawned);
+	}
+
+	// 丢弃此前累计的计数
+	BulletHell::Stats::NumBulletsSpawned = 0;
+	BulletHell::Stats::NumBulletsIntegrated = 0;
+	BulletHell::Stats::NumCollisions = 0;
+
+	Samples.Reset(Settings.NumFrames);
+	FrameCounter = 0;
+	LastFrameTime = FPlatformTime::Seconds();
+	bRunning = true;
+
+	UE_LOG(LogTemp, Log, TEXT("BulletHell benchmark started: %d enemies, %d bullets/frame, %d frames"),
+		Settings.NumEnemies, Settings.BulletsPerFrame, Settings.NumFrames);
+	return true;
+}
+
+/**
+ * 命令行带有 -BulletHellBenchmark="..." 时自动开始压测
+ * @param InWorld 当前世界
+ */
+void UBulletHellBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	FString Args;
+	if (FParse::Value(FCommandLine::Get(), TEXT("BulletHellBenchmark="), Args, false))
+	{
+		FBHBenchmarkSettings CommandLineSettings;
+		CommandLineSettings.bExitWhenDone = true;
+		CommandLineSettings.Parse(*Args);
+
+		// 无头运行时参数错误直接以非零状态退出，避免进程挂起
+		if (!StartBenchmark(CommandLineSettings))
+		{
+			FPlatformMisc::RequestExitWithStatus(false, 1, TEXT("BulletHellBenchmark"));
+		}
+	}
+}
+
+/**
+ * 记录上一帧的数据，并让合成目标发射本帧的子弹
+ * @param DeltaTime 距离上一帧的时间间隔（秒）
+ */
+void UBulletHellBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	if (!bRunning)
+	{
+		return;
+	}
+
+	// 可Tick的世界子系统在所有 Mass 处理阶段之后更新，此时各统计值均属于本帧
+	const double Now = FPlatformTime::Seconds();
+	if (FrameCounter >= Settings.WarmupFrames)
+	{
+		FFrameSample& Sample = Samples.AddDefaulted_GetRef();
+		Sample.FrameSec = Now - LastFrameTime;
+		Sample.NumEnemies = GetWorld()->GetSubsystem<UBulletHellSubsystem>()->GetNumEnemies();
+		Sample.BulletsSpawned = BulletHell::Stats::NumBulletsSpawned.exchange(0);
+		Sample.BulletsIntegrated = BulletHell::Stats::NumBulletsIntegrated.exchange(0);
+		Sample.Collisions = BulletHell::Stats::NumCollisions.exchange(0);
+		Sample.bEnemiesQueryBullets = BulletHell::Stats::bEnemiesQueryBullets;
+		Sample.EnemySec = BulletHell::Stats::EnemyTimeSec;
+		Sample.EmitterSec = BulletHell::Stats::EmitterTimeSec;
+		Sample.FlowFieldSec = BulletHell::Stats::FlowFieldTimeSec;
+		Sample.BulletInitializeSec = BulletHell::Stats::BulletInitializeTimeSec;
+		Sample.BulletIntegrationSec = BulletHell::Stats::BulletIntegrationTimeSec;
+		Sample.BulletCollisionSec = BulletHell::Stats::BulletCollisionTimeSec;
+		Sample.BulletExpirySec = BulletHell::Stats::BulletExpiryTimeSec;
+	}
+	else
+	{
+		BulletHell::Stats::NumBulletsSpawned = 0;
+		BulletHell::Stats::NumBulletsIntegrated = 0;
+		BulletHell::Stats::NumCollisions = 0;
+	}
+	LastFrameTime = Now;
+	FrameCounter++;
+
+	if (Samples.Num() >= Settings.NumFrames)
+	{
+		FinishBenchmark();
+		return;
+	}
+
+	FireBullets();
+}
+
+/**
+ * 合成目标向四周均匀发射子弹，整体相位随帧数旋转并带少量随机抖动
+ */
+void UBulletHellBenchmarkSubsystem::FireBullets()
+{
+	if (Settings.BulletsPerFrame <= 0 || !BulletConfig)
+	{
+		return;
+	}
+
+	UBulletHellSubsystem* BulletHellSubsystem = GetWorld()->GetSubsystem<UBulletHellSubsystem>();
+
+	FVector TargetLocation;
+	BulletHellSubsystem->GetPlayerLocation(TargetLocation);
+
+	const float AngleStep = UE_TWO_PI / Settings.BulletsPerFrame;
+	const float Phase = FrameCounter * 0.1f;
+
+	FBHBulletSpawnData SpawnData;
+	SpawnData.Requests.Reserve(Settings.BulletsPerFrame);
+	for (int32 BulletIdx = 0; BulletIdx < Settings.BulletsPerFrame; BulletIdx++)
+	{
+		const float Angle = Phase + BulletIdx * AngleStep + RandomStream.FRandRange(-0.5f, 0.5f) * AngleStep;
+		SpawnData.Requests.Emplace(TargetLocation, FVector(FMath::Cos(Angle), FMath::Sin(Angle), 0.f));
+	}
+	BulletHellSubsystem->SpawnBullets(BulletConfig, SpawnData);
+}
+
+/**
+ * 写出逐帧 CSV 并在日志中输出汇总，恢复合成目标之前的目标
+ */
+void UBulletHellBenchmarkSubsystem::FinishBenchmark()
+{
+	bRunning = false;
+
+	// 恢复为追踪玩家
+	if (UBulletHellSubsystem* BulletHellSubsystem = GetWorld()->GetSubsystem<UBulletHellSubsystem>())
+	{
+		BulletHellSubsystem->ClearSyntheticTarget();
+	}
+
+	constexpr double ToMs = 1000.0;
+	double TotalSec = 0.0;
+	int64 TotalBulletsIntegrated = 0;
+	int64 TotalBulletsSpawned = 0;
+	int64 TotalCollisions = 0;
+
+	FString Csv = TEXT("Frame,FrameMs,Enemies,BulletsSpawned,BulletsIntegrated,Collisions,CollisionMode,EnemyMs,EmitterMs,FlowFieldMs,BulletInitializeMs,BulletIntegrationMs,BulletCollisionMs,BulletExpiryMs\n");
+	for (int32 FrameIdx = 0; FrameIdx < Samples.Num(); FrameIdx++)
+	{
+		const FFrameSample& Sample = Samples[FrameIdx];
+		Csv += FString::Printf(TEXT("%d,%.4f,%d,%lld,%lld,%lld,%s,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n"),
+			FrameIdx, Sample.FrameSec * ToMs, Sample.NumEnemies, Sample.BulletsSpawned, Sample.BulletsIntegrated, Sample.Collisions,
+			Sample.bEnemiesQueryBullets ? TEXT("EnemyQuery") : TEXT("BulletQuery"),
+			Sample.EnemySec * ToMs, Sample.EmitterSec * ToMs, Sample.FlowFieldSec * ToMs, Sample.BulletInitializeSec * ToMs,
+			Sample.BulletIntegrationSec * ToMs, Sample.BulletCollisionSec * ToMs, Sample.BulletExpirySec * ToMs);
+
+		TotalSec += Sample.FrameSec;
+		TotalBulletsIntegrated += Sample.BulletsIntegrated;
+		TotalBulletsSpawned += Sample.BulletsSpawned;
+		TotalCollisions += Sample.Collisions;
+	}
+
+	const FString FileName = FPaths::ProfilingDir() / TEXT("BulletHell") /
+		FString::Printf(TEXT("Benchmark_%s.csv"), *FDateTime::Now().ToString(TEXT("%Y%m%d_%H%M%S")));
+	FFileHelper::SaveStringToFile(Csv, *FileName);
+
+	const double SafeTotalSec = FMath::Max(TotalSec, UE_DOUBLE_SMALL_NUMBER);
+	UE_LOG(LogTemp, Log, TEXT("BulletHell benchmark finished: %d frames, avg %.3f ms/frame, %.0f bullet updates/sec, %.0f bullets spawned/sec, %.0f collisions/sec. CSV: %s"),
+		Samples.Num(), TotalSec * ToMs / FMath::Max(Samples.Num(), 1), TotalBulletsIntegrated / SafeTotalSec,
+		TotalBulletsSpawned / SafeTotalSec, TotalCollisions / SafeTotalSec, *FPaths::ConvertRelativePathToFull(FileName));
+
+	if (Settings.bExitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false, TEXT("BulletHellBenchmark"));
+	}
+}
+
+TStatId UBulletHellBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBulletHellBenchmarkSubsystem, STATGROUP_Tickables);
+}
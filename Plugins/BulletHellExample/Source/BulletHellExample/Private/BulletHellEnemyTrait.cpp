@@ -4,9 +4,17 @@
 #include "BulletHellEnemyTrait.h"
 
 #include "MassEntityTemplateRegistry.h"
+#include "MassSpatialIndexFragments.h"
 
 void UBulletHellEnemyTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
 {
 	BuildContext.AddFragment(FConstStructView::Make(BHEnemyFragment));
 	BuildContext.AddTag<FBHEnemyTag>();
+
+	// 加入统一空间索引，按 FBHEnemyTag 归入敌人图层；其他特性已经添加时沿用它们的设置
+	if (!BuildContext.HasFragment<FMassSpatialIndexFragment>())
+	{
+		FMassSpatialIndexFragment& SpatialIndexFragment = BuildContext.AddFragment_GetRef<FMassSpatialIndexFragment>();
+		SpatialIndexFragment.Radius = FMath::Max(BHEnemyFragment.CollisionExtent.X, BHEnemyFragment.CollisionExtent.Y);
+	}
 }
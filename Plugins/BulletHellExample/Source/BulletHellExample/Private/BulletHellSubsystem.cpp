@@ -3,27 +3,188 @@
 
 #include "BulletHellSubsystem.h"
 
+#include "BulletHellEnemyTrait.h"
+#include "BulletProcessor.h"
 #include "BulletTrait.h"
+#include "GameFramework/Pawn.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
 #include "MassEntityConfigAsset.h"
 #include "MassEntitySubsystem.h"
 #include "MassSignalSubsystem.h"
 #include "MassSpawnerSubsystem.h"
 
-const FBHEntityHashGrid& UBulletHellSubsystem::GetHashGrid() const
+const FName UBulletHellSubsystem::EnemyLayerName = FName(TEXT("BulletHellEnemy"));
+
+/**
+ * 初始化子系统，在统一空间索引中注册敌人图层
+ * @param Collection 子系统集合
+ */
+void UBulletHellSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SpatialIndex = Collection.InitializeDependency<UMassSpatialIndexSubsystem>();
+	if (SpatialIndex)
+	{
+		EnemyLayerMask = SpatialIndex->RegisterLayer(EnemyLayerName, FBHEnemyTag::StaticStruct());
+	}
+}
+
+/**
+ * 统计统一空间索引中敌人图层的实体数量
+ * @return 敌人数量
+ */
+int32 UBulletHellSubsystem::GetNumEnemies() const
+{
+	return SpatialIndex ? SpatialIndex->GetNumItems(EnemyLayerMask) : 0;
+}
+
+/**
+ * 登记实体的到期刻度
+ * @param Entity 实体句柄
+ * @param ExpiryTick 到期刻度
+ */
+void FBHTimingWheel::Schedule(const FMassEntityHandle Entity, uint32 ExpiryTick)
+{
+	// 已经处理过的刻度不会再被访问，推迟到下一个刻度
+	ExpiryTick = FMath::Max(ExpiryTick, LastTick + 1);
+	Slots[ExpiryTick & (NumSlots - 1)].Add({ Entity, ExpiryTick });
+	NumScheduled++;
+}
+
+/**
+ * 推进时间轮并取出到期实体
+ * @param Tick 推进到的刻度（包含）
+ * @param OutExpired 追加输出到期的实体
+ */
+void FBHTimingWheel::Advance(uint32 Tick, TArray<FMassEntityHandle>& OutExpired)
+{
+	if (Tick <= LastTick)
+	{
+		return;
+	}
+
+	// 跨度超过一圈时每个槽只需访问一次
+	const uint32 NumTicks = FMath::Min(Tick - LastTick, NumSlots);
+	for (uint32 Step = 1; Step <= NumTicks; Step++)
+	{
+		TArray<FEntry>& Slot = Slots[(Tick - NumTicks + Step) & (NumSlots - 1)];
+
+		// 保留尚未到期（属于后面几圈）的条目，其余全部取出
+		int32 NumKept = 0;
+		for (int32 EntryIdx = 0; EntryIdx < Slot.Num(); EntryIdx++)
+		{
+			const FEntry& Entry = Slot[EntryIdx];
+			if (Entry.ExpiryTick <= Tick)
+			{
+				OutExpired.Add(Entry.Entity);
+			}
+			else
+			{
+				Slot[NumKept++] = Entry;
+			}
+		}
+
+		NumScheduled -= Slot.Num() - NumKept;
+		Slot.SetNum(NumKept, EAllowShrinking::No);
+	}
+
+	LastTick = Tick;
+}
+
+void FBHTargetSet::Reset()
 {
-	// TODO: ڴ˴ return 
-	return EntityHashGrid;
+	X.Reset();
+	Y.Reset();
+	Z.Reset();
 }
 
-FBHEntityHashGrid& UBulletHellSubsystem::GetHashGrid_Mutable()
+/**
+ * 添加目标
+ * @param Location 目标位置
+ */
+void FBHTargetSet::Add(const FVector& Location)
+{
+	if (Num() >= BulletHell::MaxTargets)
+	{
+		return;
+	}
+
+	X.Add(Location.X);
+	Y.Add(Location.Y);
+	Z.Add(Location.Z);
+}
+
+/**
+ * 查询每个位置最近的目标
+ *
+ * 4个查询位置转置为一组向量寄存器，再与每个目标的广播坐标比较，
+ * 用比较掩码同时更新最近距离与目标下标。
+ *
+ * @param Locations 查询位置
+ * @param OutTargetIndices 输出最近目标的下标
+ */
+void FBHTargetSet::FindNearest(TConstArrayView<FVector> Locations, TArrayView<int32> OutTargetIndices) const
 {
-	// TODO: ڴ˴ return 
-	return EntityHashGrid;
+	check(OutTargetIndices.Num() >= Locations.Num());
+
+	const int32 NumLocations = Locations.Num();
+	const int32 NumTargets = Num();
+	if (NumTargets <= 1)
+	{
+		for (int32 LocationIdx = 0; LocationIdx < NumLocations; LocationIdx++)
+		{
+			OutTargetIndices[LocationIdx] = NumTargets == 1 ? 0 : INDEX_NONE;
+		}
+		return;
+	}
+
+	for (int32 Base = 0; Base < NumLocations; Base += 4)
+	{
+		// 转置为 SoA，不足4个时重复最后一个位置
+		alignas(16) float QueryX[4];
+		alignas(16) float QueryY[4];
+		alignas(16) float QueryZ[4];
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			const FVector& Location = Locations[FMath::Min(Base + Lane, NumLocations - 1)];
+			QueryX[Lane] = static_cast<float>(Location.X);
+			QueryY[Lane] = static_cast<float>(Location.Y);
+			QueryZ[Lane] = static_cast<float>(Location.Z);
+		}
+
+		const VectorRegister4Float PX = VectorLoadAligned(QueryX);
+		const VectorRegister4Float PY = VectorLoadAligned(QueryY);
+		const VectorRegister4Float PZ = VectorLoadAligned(QueryZ);
+
+		VectorRegister4Float BestDistSq = VectorSetFloat1(MAX_flt);
+		VectorRegister4Float BestIndex = VectorZeroFloat();
+		for (int32 TargetIdx = 0; TargetIdx < NumTargets; TargetIdx++)
+		{
+			const VectorRegister4Float DX = VectorSubtract(PX, VectorSetFloat1(X[TargetIdx]));
+			const VectorRegister4Float DY = VectorSubtract(PY, VectorSetFloat1(Y[TargetIdx]));
+			const VectorRegister4Float DZ = VectorSubtract(PZ, VectorSetFloat1(Z[TargetIdx]));
+			const VectorRegister4Float DistSq = VectorMultiplyAdd(DX, DX, VectorMultiplyAdd(DY, DY, VectorMultiply(DZ, DZ)));
+
+			const VectorRegister4Float Closer = VectorCompareLT(DistSq, BestDistSq);
+			BestDistSq = VectorSelect(Closer, DistSq, BestDistSq);
+			BestIndex = VectorSelect(Closer, VectorSetFloat1(static_cast<float>(TargetIdx)), BestIndex);
+		}
+
+		alignas(16) float Indices[4];
+		VectorStoreAligned(BestIndex, Indices);
+		const int32 NumLanes = FMath::Min(4, NumLocations - Base);
+		for (int32 Lane = 0; Lane < NumLanes; Lane++)
+		{
+			OutTargetIndices[Base + Lane] = static_cast<int32>(Indices[Lane]);
+		}
+	}
 }
 
 /**
- * ȡλ
- * @param OutLocation ڷҵλϢ
+ * 获取主目标位置
+ * @param OutLocation 输出参数，用于返回玩家的位置信息
  */
 void UBulletHellSubsystem::GetPlayerLocation(FVector& OutLocation) const
 {
@@ -31,60 +192,242 @@ void UBulletHellSubsystem::GetPlayerLocation(FVector& OutLocation) const
 }
 
 /**
- * ӵʵ
- * @param BulletConfig ӵʲӵԺΪ
- * @param Location ӵɵλ
- * @param Direction ӵƶķ
+ * 启用合成目标
+ * @param Center 圆周中心
+ * @param OrbitRadius 圆周半径
+ * @param OrbitSpeed 角速度（度/秒）
+ */
+void UBulletHellSubsystem::SetSyntheticTarget(const FVector& Center, float OrbitRadius, float OrbitSpeed)
+{
+	bUseSyntheticTarget = true;
+	SyntheticTargetCenter = Center;
+	SyntheticTargetRadius = OrbitRadius;
+	SyntheticTargetSpeed = OrbitSpeed;
+	UpdateTargets();
+}
+
+/**
+ * 恢复为跟随玩家 Pawn
+ */
+void UBulletHellSubsystem::ClearSyntheticTarget()
+{
+	bUseSyntheticTarget = false;
+}
+
+/**
+ * 将秒数换算为刻度数
+ * @param Seconds 时长（秒）
+ * @return 刻度数，至少为1
+ */
+uint32 UBulletHellSubsystem::SecondsToTicks(float Seconds)
+{
+	return FMath::Max(1u, static_cast<uint32>(FMath::CeilToInt32(Seconds / BulletHell::TickInterval)));
+}
+
+/**
+ * 登记子弹的到期刻度
+ * @param Entity 子弹实体
+ * @param ExpiryTick 到期刻度
+ */
+void UBulletHellSubsystem::ScheduleExpiry(const FMassEntityHandle Entity, uint32 ExpiryTick)
+{
+	LifetimeWheel.Schedule(Entity, ExpiryTick);
+}
+
+/**
+ * 取出截至当前刻度到期的所有实体
+ * @param OutExpired 追加输出到期的实体
+ */
+void UBulletHellSubsystem::CollectExpired(TArray<FMassEntityHandle>& OutExpired)
+{
+	LifetimeWheel.Advance(CurrentTick, OutExpired);
+}
+
+/**
+ * 生成子弹实体
+ * @param BulletConfig 子弹配置资产，定义了子弹的属性和行为
+ * @param Location 子弹生成的位置坐标
+ * @param Direction 子弹移动的方向向量
  */
 void UBulletHellSubsystem::SpawnBullet(UMassEntityConfigAsset* BulletConfig, const FVector& Location, const FVector& Direction)
+{
+	FBHBulletSpawnData SpawnData;
+	SpawnData.Requests.Add({ Location, Direction });
+	SpawnBullets(BulletConfig, SpawnData);
+}
+
+/**
+ * 批量生成子弹实体
+ *
+ * 所有子弹通过一次 SpawnEntities 调用创建，生成位置与方向由 UBulletSpawnDataInitializer
+ * 按块写入，随后用一次批量信号触发子弹初始化。
+ *
+ * @param BulletConfig 子弹配置资产，定义了子弹的属性和行为
+ * @param SpawnData 生成请求
+ */
+void UBulletHellSubsystem::SpawnBullets(UMassEntityConfigAsset* BulletConfig, const FBHBulletSpawnData& SpawnData)
 {
 	check(BulletConfig);
+	if (SpawnData.Requests.IsEmpty())
+	{
+		return;
+	}
 
-	// ȡҪϵͳ͹
+	// 获取必要的子系统
 	auto SignalSubsystem = GetWorld()->GetSubsystem<UMassSignalSubsystem>();
 	auto SpawnerSystem = GetWorld()->GetSubsystem<UMassSpawnerSubsystem>();
-	auto& EntityManager = GetWorld()->GetSubsystem<UMassEntitySubsystem>()->GetMutableEntityManager();
 
-	// ӵʵ
+	// 批量生成子弹实体，并由初始化处理器写入子弹片段数据
+	const FMassEntityTemplate& EntityTemplate = BulletConfig->GetOrCreateEntityTemplate(*GetWorld());
 	TArray<FMassEntityHandle> EntitiesSpawned;
-	SpawnerSystem->SpawnEntities(BulletConfig->GetOrCreateEntityTemplate(*GetWorld()), 1, EntitiesSpawned);
+	SpawnerSystem->SpawnEntities(EntityTemplate.GetTemplateID(), SpawnData.Requests.Num(), FConstStructView::Make(SpawnData),
+		UBulletSpawnDataInitializer::StaticClass(), EntitiesSpawned);
 
-	// ӵƬ
-	auto& BulletFragment = EntityManager.GetFragmentDataChecked<FBulletFragment>(EntitiesSpawned[0]);
-	BulletFragment.Direction = Direction;
-	BulletFragment.SpawnLocation = Location;
+	// 发送子弹生成信号
+	SignalSubsystem->SignalEntities(BulletHell::Signals::BulletSpawned, EntitiesSpawned);
+	BulletHell::Stats::NumBulletsSpawned += EntitiesSpawned.Num();
+}
+
+/**
+ * 将生成请求加入队列
+ * @param BulletConfig 子弹配置资产
+ * @param Requests 生成请求
+ */
+void UBulletHellSubsystem::QueueBulletSpawns(UMassEntityConfigAsset* BulletConfig, TConstArrayView<FBHBulletSpawnRequest> Requests)
+{
+	if (!BulletConfig || Requests.IsEmpty())
+	{
+		return;
+	}
 
-	// ӵź
-	SignalSubsystem->SignalEntity(BulletHell::Signals::BulletSpawned, EntitiesSpawned[0]);
+	FScopeLock Lock(&PendingBulletSpawnsLock);
+	PendingBulletSpawns.FindOrAdd(BulletConfig).Requests.Append(Requests.GetData(), Requests.Num());
 }
 
 
 /**
- * ÿ֡ºڸλϢ
- * @param DeltaTime һ֡ʱ룩
+ * 每帧更新函数，用于推进模拟刻度并更新玩家位置信息
+ * @param DeltaTime 距离上一帧的时间间隔（秒）
  */
 void UBulletHellSubsystem::Tick(float DeltaTime)
 {
-	// pawnڣȡҵǰλ
-	if (CachedPlayerPawn)
+	// 按固定刻度累计时间
+	TickAccumulator += DeltaTime;
+	while (TickAccumulator >= BulletHell::TickInterval)
+	{
+		TickAccumulator -= BulletHell::TickInterval;
+		CurrentTick++;
+	}
+
+	// 按子弹配置批量生成本帧排队的子弹
+	if (PendingBulletSpawns.Num() > 0)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(SpawnQueuedBullets)
+
+		TMap<TObjectPtr<UMassEntityConfigAsset>, FBHBulletSpawnData> BulletSpawns;
+		{
+			FScopeLock Lock(&PendingBulletSpawnsLock);
+			BulletSpawns = MoveTemp(PendingBulletSpawns);
+			PendingBulletSpawns.Reset();
+		}
+
+		// 各块的请求按工作线程完成的先后追加，排序后实体句柄与块布局才可复现。
+		// 同一发射器的请求在一次提交中连续且有序，稳定排序即可保留发射器内的顺序
+		for (auto& Pair : BulletSpawns)
+		{
+			Pair.Value.Requests.StableSort([](const FBHBulletSpawnRequest& A, const FBHBulletSpawnRequest& B)
+				{
+					return A.Emitter.Index < B.Emitter.Index;
+				});
+		}
+
+		// 不同配置按各自最小的发射器排序，TMap 的插入顺序同样取决于线程
+		BulletSpawns.ValueSort([](const FBHBulletSpawnData& A, const FBHBulletSpawnData& B)
+			{
+				return A.Requests[0].Emitter.Index < B.Requests[0].Emitter.Index;
+			});
+
+		for (const auto& Pair : BulletSpawns)
+		{
+			SpawnBullets(Pair.Key, Pair.Value);
+		}
+	}
+
+	UpdateTargets();
+}
+
+/**
+ * 登记额外的追踪目标
+ * @param Actor 目标 Actor
+ */
+void UBulletHellSubsystem::RegisterTarget(AActor* Actor)
+{
+	if (Actor)
+	{
+		RegisteredTargets.AddUnique(Actor);
+	}
+}
+
+/**
+ * 取消登记的追踪目标
+ * @param Actor 目标 Actor
+ */
+void UBulletHellSubsystem::UnregisterTarget(AActor* Actor)
+{
+	RegisteredTargets.Remove(Actor);
+}
+
+/**
+ * 重建目标集合：合成目标或所有玩家控制的 Pawn，加上额外登记的目标
+ */
+void UBulletHellSubsystem::UpdateTargets()
+{
+	Targets.Reset();
+
+	if (bUseSyntheticTarget)
+	{
+		// 合成目标的位置只取决于模拟刻度，保证压测可复现
+		float Sin, Cos;
+		FMath::SinCos(&Sin, &Cos, FMath::DegreesToRadians(SyntheticTargetSpeed * CurrentTick * BulletHell::TickInterval));
+		Targets.Add(SyntheticTargetCenter + FVector(Cos, Sin, 0.f) * SyntheticTargetRadius);
+	}
+	else
+	{
+		// 开始游戏时可能尚未控制 Pawn，无头运行时可能没有玩家控制器
+		for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+		{
+			const APlayerController* PlayerController = It->Get();
+			if (const APawn* Pawn = PlayerController ? PlayerController->GetPawn() : nullptr)
+			{
+				Targets.Add(Pawn->GetActorLocation());
+			}
+		}
+	}
+
+	RegisteredTargets.RemoveAllSwap([](const TWeakObjectPtr<AActor>& Actor) { return !Actor.IsValid(); }, EAllowShrinking::No);
+	for (const TWeakObjectPtr<AActor>& Actor : RegisteredTargets)
+	{
+		Targets.Add(Actor->GetActorLocation());
+	}
+
+	if (!Targets.IsEmpty())
 	{
-		PlayerLocation = CachedPlayerPawn->GetActorLocation();
+		PlayerLocation = Targets.GetLocation(0);
 	}
 }
 
 /**
- * 翪ʼʱĳʼصڻȡpawn
- * @param InWorld ǰϷ
+ * 世界开始播放时的初始化回调函数，用于构建初始的目标集合
+ * @param InWorld 当前游戏世界的引用
  */
 void UBulletHellSubsystem::OnWorldBeginPlay(UWorld& InWorld)
 {
-	// ȡһҿpawn󲢻
-	CachedPlayerPawn = InWorld.GetFirstPlayerController()->GetPawn();
+	UpdateTargets();
 }
 
 /**
- * ȡͳIDͳϵͳ
- * @return صǰϵͳͳƱʶ
+ * 获取统计ID函数，用于性能统计系统
+ * @return 返回当前子系统的统计标识符
  */
 TStatId UBulletHellSubsystem::GetStatId() const
 {
@@ -5,14 +5,21 @@
 
 #include "BulletTrait.h"
 #include "BulletHellSubsystem.h"
+#include "BulletHellEnemyTrait.h"
+#include "Algo/Unique.h"
+#include "HAL/IConsoleManager.h"
 #include "MassCommonFragments.h"
 #include "MassEntitySubsystem.h"
 #include "MassExecutionContext.h"
+#include "MassCommonTypes.h"
 #include "MassMovementFragments.h"
 #include "MassSignalSubsystem.h"
+#include "MassSpatialIndexProcessors.h"
+#include "MassSpatialIndexSubsystem.h"
+#include "ProfilingDebugging/ScopedTimers.h"
 
 /**
- * @brief 캯ʼ EntityQuery 󶨵ǰ
+ * @brief 构造函数，初始化 EntityQuery 并绑定到当前对象。
  */
 UBulletInitializerProcessor::UBulletInitializerProcessor()
 	: EntityQuery(*this)
@@ -20,83 +27,93 @@ UBulletInitializerProcessor::UBulletInitializerProcessor()
 }
 
 /**
- * @brief òѯָʵıǩƬҪ
+ * @brief 配置查询条件，指定处理实体所需的标签和片段要求。
  *
- * @param EntityManager ʵãòѯ
+ * @param EntityManager 实体管理器引用，用于配置查询。
  */
 void UBulletInitializerProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
-	// ӱӵ FBulletTag ǩʵҪ
+	// 添加必须拥有 FBulletTag 标签的实体要求
 	EntityQuery.AddTagRequirement<FBulletTag>(EMassFragmentPresence::All);
 	
-	// Ӷٶȡӵݺͱ任ƬεĶдֻȨҪ
-	EntityQuery.AddRequirement<FMassVelocityFragment>(EMassFragmentAccess::ReadWrite);
+	// 添加对子弹数据、寿命、运动状态和变换片段的读写或只读访问权限要求
 	EntityQuery.AddRequirement<FBulletFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FBulletLifetimeFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FBulletOriginFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FBulletVelocityFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FBulletPositionFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
 
-	// ӶźϵͳĶдȨ
-	EntityQuery.AddSubsystemRequirement<UMassSignalSubsystem>(EMassFragmentAccess::ReadWrite);
+	// 添加对子弹地狱子系统的读写权限需求（登记寿命时间轮）
+	EntityQuery.AddSubsystemRequirement<UBulletHellSubsystem>(EMassFragmentAccess::ReadWrite);
 }
 
 /**
- * @brief ʼڲ״̬źš
+ * @brief 初始化处理器内部状态，并订阅相关信号。
  *
- * @param Owner  UObject 
- * @param EntityManager ʵá
+ * @param Owner 处理器的所有者 UObject 对象。
+ * @param EntityManager 实体管理器引用。
  */
 void UBulletInitializerProcessor::InitializeInternal(UObject& Owner, const TSharedRef<FMassEntityManager>& EntityManager)
 {
-	// øʼ߼
+	// 调用父类初始化逻辑
 	Super::InitializeInternal(Owner, EntityManager);
 
-	// ȡе Mass źϵͳӵź
+	// 获取世界中的 Mass 信号子系统并订阅子弹生成信号
 	UMassSignalSubsystem* SignalSubsystem = UWorld::GetSubsystem<UMassSignalSubsystem>(Owner.GetWorld());
 	SubscribeToSignal(*SignalSubsystem, BulletHell::Signals::BulletSpawned);
 }
 
 /**
- * @brief Ӧź¼ʵ鲢ÿʵгʼ
+ * @brief 响应信号事件，遍历符合条件的实体块并对每个实体进行初始化操作。
  *
- * @param EntityManager ʵ
- * @param Context ִģṩִлϢ
- * @param EntitySignals ʵźƲұ
+ * @param EntityManager 实体管理器。
+ * @param Context 执行上下文，提供执行环境信息。
+ * @param EntitySignals 实体信号名称查找表。
  */
 void UBulletInitializerProcessor::SignalEntities(FMassEntityManager& EntityManager, FMassExecutionContext& Context, FMassSignalNameLookup& EntitySignals)
 {
-	// ƥѯʵ
+	// 性能统计：记录子弹初始化的耗时
+	BulletHell::Stats::BulletInitializeTimeSec = 0.0;
+	FScopedDurationTimer DurationTimer(BulletHell::Stats::BulletInitializeTimeSec);
+
+	// 遍历所有匹配查询条件的实体块
 	EntityQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
 		{
-			// ȡɱźϵͳʵ
-			auto SignalSubsystem = Context.GetMutableSubsystem<UMassSignalSubsystem>();
+			// 获取可变的子弹地狱子系统实例
+			auto BulletHellSubsystem = Context.GetMutableSubsystem<UBulletHellSubsystem>();
+			const uint32 CurrentTick = BulletHellSubsystem->GetCurrentTick();
 
-			// ȡӵصƬͼֻ/д
+			// 获取子弹相关的片段视图（只读/可写）
 			auto BulletFragments = Context.GetFragmentView<FBulletFragment>();
-			auto VelocityFragments = Context.GetMutableFragmentView<FMassVelocityFragment>();
+			auto LifetimeFragments = Context.GetMutableFragmentView<FBulletLifetimeFragment>();
+			auto OriginFragments = Context.GetMutableFragmentView<FBulletOriginFragment>();
+			auto VelocityFragments = Context.GetMutableFragmentView<FBulletVelocityFragment>();
+			auto PositionFragments = Context.GetMutableFragmentView<FBulletPositionFragment>();
 			auto TransformFragments = Context.GetMutableFragmentView<FTransformFragment>();
 
 			const int32 NumEntities = Context.GetNumEntities();
 
-			// ǰÿһʵ
+			// 遍历当前块中每一个实体
 			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
 			{
-				// øƬε
+				// 引用各个片段的数据
 				auto& BulletFragment = BulletFragments[EntityIdx];
-				auto& VelocityFragment = VelocityFragments[EntityIdx];
 				auto& TransformFragment = TransformFragments[EntityIdx];
 
-				// ʵٶȣ׼ٶֵ
-				VelocityFragment.Value = BulletFragment.Direction.GetSafeNormal() * BulletFragment.Speed;
+				// 设置实体的速度：方向标准化后乘以速度值；不写入 FMassVelocityFragment，避免通用移动处理器再次移动子弹
+				VelocityFragments[EntityIdx].Value = FVector3f(BulletFragment.Direction.GetSafeNormal() * BulletFragment.Speed);
 
-				// ʵλΪλ
+				// 设置实体的位置为出生点位置，作为固定刻度积分的起点
+				OriginFragments[EntityIdx].Value = FVector3f(BulletFragment.SpawnLocation);
+				PositionFragments[EntityIdx].Value = OriginFragments[EntityIdx].Value;
 				TransformFragment.GetMutableTransform().SetLocation(BulletFragment.SpawnLocation);
 
-				// ӳٷźţڽ󴥷
-				SignalSubsystem->DelaySignalEntityDeferred(
-					Context,
-					BulletHell::Signals::BulletDestroy,
-					Context.GetEntity(EntityIdx),
-					BulletFragment.Lifetime
-				);
+				// 记录生成与到期刻度并登记到寿命时间轮，到期后批量销毁
+				auto& LifetimeFragment = LifetimeFragments[EntityIdx];
+				LifetimeFragment.SpawnTick = CurrentTick;
+				LifetimeFragment.ExpiryTick = CurrentTick + UBulletHellSubsystem::SecondsToTicks(BulletFragment.Lifetime);
+				BulletHellSubsystem->ScheduleExpiry(Context.GetEntity(EntityIdx), LifetimeFragment.ExpiryTick);
 			}
 		});
 }
@@ -104,132 +121,418 @@ void UBulletInitializerProcessor::SignalEntities(FMassEntityManager& EntityManag
 
 
 /**
- * ʵѯ
- * @param EntityManager ʵãڹϷеʵ
+ * @brief 构造函数，该处理器只在 UMassSpawnerSubsystem::SpawnEntities 中针对新生成的实体执行
  */
-void UBulletDestroyerProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+UBulletSpawnDataInitializer::UBulletSpawnDataInitializer()
+	: EntityQuery(*this)
 {
-	// ӱǩҪֻFBulletTagǩʵ
-	EntityQuery.AddTagRequirement<FBulletTag>(EMassFragmentPresence::All);
+	bAutoRegisterWithProcessingPhases = false;
 }
 
 /**
- * ʼڲ״̬
- * @param Owner ߶
- * @param EntityManager ʵãڹϷеʵ
+ * @brief 配置查询条件
+ *
+ * @param EntityManager 实体管理器引用，用于配置查询。
  */
-void UBulletDestroyerProcessor::InitializeInternal(UObject& Owner, const TSharedRef<FMassEntityManager>& EntityManager)
+void UBulletSpawnDataInitializer::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
-	// øʼ
-	Super::InitializeInternal(Owner, EntityManager);
+	EntityQuery.AddRequirement<FBulletFragment>(EMassFragmentAccess::ReadWrite);
+}
 
-	// ȡеźϵͳӵź
-	UMassSignalSubsystem* SignalSubsystem = UWorld::GetSubsystem<UMassSignalSubsystem>(Owner.GetWorld());
-	SubscribeToSignal(*SignalSubsystem, BulletHell::Signals::BulletDestroy);
+/**
+ * @brief 按顺序把生成请求写入新生成的子弹片段
+ *
+ * 同一批生成的子弹彼此等价，因此请求与实体之间只需一一对应，不要求特定顺序。
+ *
+ * @param EntityManager 实体管理器引用
+ * @param Context 执行上下文引用，辅助数据为 FBHBulletSpawnData
+ */
+void UBulletSpawnDataInitializer::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	if (!ensure(Context.ValidateAuxDataType<FBHBulletSpawnData>()))
+	{
+		return;
+	}
+
+	const FBHBulletSpawnData& SpawnData = Context.GetAuxData().Get<FBHBulletSpawnData>();
+	int32 RequestIdx = 0;
+
+	EntityQuery.ForEachEntityChunk(Context, [&SpawnData, &RequestIdx](FMassExecutionContext& Context)
+		{
+			auto BulletFragments = Context.GetMutableFragmentView<FBulletFragment>();
+
+			const int32 NumEntities = Context.GetNumEntities();
+			for (int EntityIdx = 0; EntityIdx < NumEntities && RequestIdx < SpawnData.Requests.Num(); EntityIdx++, RequestIdx++)
+			{
+				const FBHBulletSpawnRequest& Request = SpawnData.Requests[RequestIdx];
+				BulletFragments[EntityIdx].SpawnLocation = Request.Location;
+				BulletFragments[EntityIdx].Direction = Request.Direction;
+			}
+		});
 }
 
+
+// 积分内核把片段数组视为连续的 float 数组
+static_assert(sizeof(FBulletOriginFragment) == sizeof(FVector3f), "FBulletOriginFragment must be tightly packed");
+static_assert(sizeof(FBulletVelocityFragment) == sizeof(FVector3f), "FBulletVelocityFragment must be tightly packed");
+static_assert(sizeof(FBulletPositionFragment) == sizeof(FVector3f), "FBulletPositionFragment must be tightly packed");
+
 /**
- * յźŵʵ壬зʵ
- * @param EntityManager ʵãڹϷеʵ
- * @param Context ִģǰʵϢ
- * @param EntitySignals ʵźƲʶͬź
+ * @brief 构造函数，在移动处理组中执行
  */
-void UBulletDestroyerProcessor::SignalEntities(FMassEntityManager& EntityManager, FMassExecutionContext& Context, FMassSignalNameLookup& EntitySignals)
+UBulletIntegrationProcessor::UBulletIntegrationProcessor()
+	: EntityQuery(*this)
 {
-	// зʵ飬еʵ
-	EntityQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
+	ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::Movement;
+}
+
+/**
+ * @brief 配置查询条件：只读取子弹积分所需的紧凑片段
+ *
+ * @param EntityManager 实体管理器引用，用于配置查询。
+ */
+void UBulletIntegrationProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddTagRequirement<FBulletTag>(EMassFragmentPresence::All);
+	EntityQuery.AddRequirement<FBulletLifetimeFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FBulletOriginFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FBulletVelocityFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FBulletPositionFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddSubsystemRequirement<UBulletHellSubsystem>(EMassFragmentAccess::ReadOnly);
+}
+
+/**
+ * @brief 按固定刻度计算子弹位置
+ *
+ * 位置 = 出生位置 + 速度 * (已经过的刻度数 * 刻度时长)。
+ * 结果只取决于整数刻度数而不是每帧的 DeltaTime，也不会在多帧之间累积舍入误差，
+ * 因此相同的输入在任意帧率下都能逐位复现。
+ * 计算在块内连续的 float 数组上逐分量进行，编译器可以直接向量化。
+ *
+ * @param EntityManager 实体管理器引用
+ * @param Context 执行上下文引用
+ */
+void UBulletIntegrationProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	// 性能统计：记录子弹积分的耗时
+	BulletHell::Stats::BulletIntegrationTimeSec = 0.0;
+	FScopedDurationTimer DurationTimer(BulletHell::Stats::BulletIntegrationTimeSec);
+
+	EntityQuery.ParallelForEachEntityChunk(Context, [](FMassExecutionContext& Context)
 		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(IntegrateBullets)
+
+			const uint32 CurrentTick = Context.GetSubsystemChecked<UBulletHellSubsystem>().GetCurrentTick();
+
+			const auto LifetimeFragments = Context.GetFragmentView<FBulletLifetimeFragment>();
+			const auto OriginFragments = Context.GetFragmentView<FBulletOriginFragment>();
+			const auto VelocityFragments = Context.GetFragmentView<FBulletVelocityFragment>();
+			const auto PositionFragments = Context.GetMutableFragmentView<FBulletPositionFragment>();
+			const auto TransformFragments = Context.GetMutableFragmentView<FTransformFragment>();
+
 			const int32 NumEntities = Context.GetNumEntities();
+			const int32 NumFloats = NumEntities * 3;
+
+			// 每个分量对应的已飞行时间
+			TArray<float, TInlineAllocator<1024>> ElapsedTimes;
+			ElapsedTimes.SetNumUninitialized(NumFloats);
+			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+			{
+				const float Elapsed = static_cast<float>(CurrentTick - LifetimeFragments[EntityIdx].SpawnTick) * BulletHell::TickInterval;
+				ElapsedTimes[EntityIdx * 3 + 0] = Elapsed;
+				ElapsedTimes[EntityIdx * 3 + 1] = Elapsed;
+				ElapsedTimes[EntityIdx * 3 + 2] = Elapsed;
+			}
+
+			// 连续 float 数组上的逐分量积分
+			const float* RESTRICT Origins = &OriginFragments[0].Value.X;
+			const float* RESTRICT Velocities = &VelocityFragments[0].Value.X;
+			const float* RESTRICT Times = ElapsedTimes.GetData();
+			float* RESTRICT Positions = &PositionFragments[0].Value.X;
+			for (int32 FloatIdx = 0; FloatIdx < NumFloats; FloatIdx++)
+			{
+				Positions[FloatIdx] = Origins[FloatIdx] + Velocities[FloatIdx] * Times[FloatIdx];
+			}
+
+			BulletHell::Stats::NumBulletsIntegrated += NumEntities;
+
+			// 写回变换，供可视化与碰撞使用
 			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
 			{
-				Context.Defer().DestroyEntity(Context.GetEntity(EntityIdx));
+				TransformFragments[EntityIdx].GetMutableTransform().SetLocation(FVector(PositionFragments[EntityIdx].Value));
 			}
 		});
 }
 
+
+/**
+ * @brief 构造函数，声明对子弹地狱子系统的读写访问，保证与其他访问时间轮的处理器串行
+ */
+UBulletExpiryProcessor::UBulletExpiryProcessor()
+{
+	ProcessorRequirements.AddSubsystemRequirement<UBulletHellSubsystem>(EMassFragmentAccess::ReadWrite);
+}
+
+/**
+ * @brief 初始化处理器，缓存子弹地狱子系统
+ *
+ * @param Owner 处理器的所有者对象
+ * @param EntityManager 实体管理器引用
+ */
+void UBulletExpiryProcessor::InitializeInternal(UObject& Owner, const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	Super::InitializeInternal(Owner, EntityManager);
+	BulletHellSubsystem = UWorld::GetSubsystem<UBulletHellSubsystem>(Owner.GetWorld());
+}
+
 /**
- * 캯ʼʵѯ
+ * @brief 取出本帧到期的子弹并批量销毁
+ *
+ * 已被碰撞提前销毁的子弹仍留在时间轮中，这里通过句柄有效性过滤掉。
+ *
+ * @param EntityManager 实体管理器引用
+ * @param Context 执行上下文引用
  */
-UBulletDestroyerProcessor::UBulletDestroyerProcessor()
-	:EntityQuery(*this)
+void UBulletExpiryProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
 {
+	// 性能统计：记录子弹过期回收的耗时
+	BulletHell::Stats::BulletExpiryTimeSec = 0.0;
+	FScopedDurationTimer DurationTimer(BulletHell::Stats::BulletExpiryTimeSec);
+
+	if (!BulletHellSubsystem)
+	{
+		return;
+	}
+
+	ExpiredEntities.Reset();
+	BulletHellSubsystem->CollectExpired(ExpiredEntities);
+
+	ExpiredEntities.RemoveAllSwap([&EntityManager](const FMassEntityHandle& Entity)
+		{
+			return !EntityManager.IsEntityValid(Entity);
+		}, EAllowShrinking::No);
+
+	if (ExpiredEntities.Num() > 0)
+	{
+		Context.Defer().DestroyEntities(ExpiredEntities);
+	}
 }
 
 
 
 
+//子弹命中半径
+static constexpr float BulletHitRadius = 50.f;
+
+//子弹查询敌人时每个工作线程复用的临时数组，区块之间与帧之间保留已分配的内存
+struct FBulletEnemyQueryScratch
+{
+	TArray<int32> EnemySlots;
+	TArray<TPair<FMassEntityHandle, FMassEntityHandle>> ChunkHits;
+};
+static thread_local FBulletEnemyQueryScratch BulletEnemyQueryScratch;
+
+//子弹与敌人碰撞的查询方向：0 按数量自动选择，1 子弹查询敌人网格，2 敌人查询子弹网格
+static int32 BulletCollisionQueryMode = 0;
+static FAutoConsoleVariableRef CVarBulletCollisionQueryMode(TEXT("BulletHell.Collision.QueryMode"), BulletCollisionQueryMode, TEXT("子弹碰撞查询方向：0 自动，1 子弹查询敌人，2 敌人查询子弹"));
+
+//自动模式下，子弹数量超过敌人数量的该倍数时改为敌人查询子弹网格（子弹网格需每帧重建，因此需要足够的倍数才划算）
+static float BulletCollisionEnemyQueryRatio = 4.f;
+static FAutoConsoleVariableRef CVarBulletCollisionEnemyQueryRatio(TEXT("BulletHell.Collision.EnemyQueryRatio"), BulletCollisionEnemyQueryRatio, TEXT("子弹数量超过敌人数量的该倍数时由敌人查询子弹网格"));
+
+//临时子弹网格中非空格子的目标平均子弹数，格子边长按子弹的密度计算
+static float BulletGridTargetOccupancy = 8.f;
+static FAutoConsoleVariableRef CVarBulletGridTargetOccupancy(TEXT("BulletHell.Collision.GridTargetOccupancy"), BulletGridTargetOccupancy, TEXT("临时子弹网格中每个格子的目标平均子弹数"));
+
 /**
- * @brief UBulletCollisionProcessor ๹캯
+ * @brief UBulletCollisionProcessor 类构造函数
  * 
- * ʼ EntityQuery Ա󶨵ǰʵ
+ * 初始化 EntityQuery 与 EnemyQuery，并将其绑定到当前实例。
+ * 排在统一空间索引的更新之后、Avoidance 组之前：这段时间内没有处理器移动敌人，
+ * 实时索引中敌人的格子与敌人当前的位置一致，两种查询方向看到的是同一组敌人。
  */
 UBulletCollisionProcessor::UBulletCollisionProcessor()
-	: EntityQuery(*this)
+	: EntityQuery(*this),
+	EnemyQuery(*this)
 {
+	ExecutionOrder.ExecuteAfter.Add(UMassSpatialIndexProcessor::StaticClass()->GetFName());
+	ExecutionOrder.ExecuteBefore.Add(UE::Mass::ProcessorGroupNames::Avoidance);
 }
 
 /**
- * @brief òѯָôҪʵͺ
+ * @brief 配置查询条件，指定该处理器需要处理的实体类型和数据需求
  * 
- * @param EntityManager õʵòѯ
+ * @param EntityManager 共享引用的实体管理器，用于配置查询
  * 
- * ú EntityQuery ѯıǩƬҪ
- * - Ҫʵ FBulletTag ǩ
- * - ֻ FTransformFragment Ƭ
- * - ֻ UBulletHellSubsystem ϵͳ
+ * 该函数设置查询所需的标签和片段要求：
+ * - EntityQuery：具有 FBulletTag 标签的子弹，只读访问 FTransformFragment、UBulletHellSubsystem 与统一空间索引
+ * - EnemyQuery：具有 FBHEnemyTag 标签的敌人，只读访问 FTransformFragment
  */
 void UBulletCollisionProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
 	EntityQuery.AddTagRequirement<FBulletTag>(EMassFragmentPresence::All);
 	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery.AddSubsystemRequirement<UBulletHellSubsystem>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddSubsystemRequirement<UMassSpatialIndexSubsystem>(EMassFragmentAccess::ReadOnly);
+
+	EnemyQuery.AddTagRequirement<FBHEnemyTag>(EMassFragmentPresence::All);
+	EnemyQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
 }
 
 /**
- * @brief ִײ߼ӵǷʵ巢ײʵ
+ * @brief 执行碰撞检测逻辑，检查子弹是否与敌人发生碰撞并销毁相关实体
  * 
- * @param EntityManager ʵãڻȡʵ
- * @param Context ִãṩִлϢ
+ * @param EntityManager 实体管理器引用，用于获取实体数据
+ * @param Context 执行上下文引用，提供执行环境信息
  * 
- * £
- * 1. зʵ飨Entity Chunk
- * 2. ÿʵ壺
- *    a. ȡλϢ
- *    b. ʹùϣɸѡײʵ
- *    c. һȷȷʵײ
- *    d. ײͬʱӵײʵ
+ * 命中条件是子弹与敌人当前位置的距离不超过 BulletHitRadius。根据两者的数量选择查询方向：
+ * - 子弹查询敌人：每颗子弹在统一空间索引的敌人图层中查询命中范围，再用敌人当前的位置判断，区块之间并行。
+ *   命中判定必须看到本帧的敌人，因此查询实时索引而不是上一帧的快照
+ * - 敌人查询子弹：先把子弹插入临时的子弹哈希网格（格子边长按本帧子弹的密度选择），再由每个敌人查询
+ * 两种方向的命中集合完全相同：都用子弹与敌人当前位置的距离判断，而候选集合都覆盖了所有可能命中的敌人。
+ * 实时索引在本处理器之前按敌人当前的位置更新，新生成的敌人在生成时就已加入，因此距离不超过 BulletHitRadius 的敌人
+ * 一定落在子弹查询范围重叠的格子中。
+ * 所有命中的子弹与敌人去重后一次性销毁。
  */
 void UBulletCollisionProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
 {
-	EntityQuery.ForEachEntityChunk(Context, [this, &EntityManager](FMassExecutionContext& Context)
+	// 性能统计：记录子弹碰撞检测的耗时
+	BulletHell::Stats::BulletCollisionTimeSec = 0.0;
+	FScopedDurationTimer DurationTimer(BulletHell::Stats::BulletCollisionTimeSec);
+
+	const int32 NumBullets = EntityQuery.GetNumMatchingEntities();
+	const int32 NumEnemies = EnemyQuery.GetNumMatchingEntities();
+
+	// 提前返回的帧也要更新统计，避免压测记录上一帧的方向
+	const bool bEnemiesQueryBullets = BulletCollisionQueryMode == 2
+		|| (BulletCollisionQueryMode == 0 && NumBullets > NumEnemies * BulletCollisionEnemyQueryRatio);
+	BulletHell::Stats::bEnemiesQueryBullets = bEnemiesQueryBullets;
+
+	if (NumBullets == 0 || NumEnemies == 0)
+	{
+		return;
+	}
+
+	// 命中的子弹-敌人对
+	TArray<TPair<FMassEntityHandle, FMassEntityHandle>> Hits;
+	TArray<FMassEntityHandle> Candidates;
+
+	auto GetLocation = [&EntityManager](const FMassEntityHandle Entity)
 		{
-			auto BulletHellSubsystem = Context.GetSubsystem<UBulletHellSubsystem>();
-			auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
-			const int32 NumEntities = Context.GetNumEntities();
-			
-			// ǰеÿһʵ
-			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+			return EntityManager.GetFragmentDataChecked<FTransformFragment>(Entity).GetTransform().GetLocation();
+		};
+
+	if (!bEnemiesQueryBullets)
+	{
+		// 每颗子弹查询实时索引中与命中范围重叠的敌人格子，再用敌人当前的位置判断；
+		// 各区块的命中合并到 Hits，之后会排序去重，因此合并顺序不影响结果
+		FCriticalSection HitsLock;
+		EntityQuery.ParallelForEachEntityChunk(Context, [&Hits, &HitsLock, &GetLocation](FMassExecutionContext& Context)
 			{
-				auto& TransformFragment = TransformFragments[EntityIdx];
-				auto Location = TransformFragment.GetTransform().GetLocation();
+				const UMassSpatialIndexSubsystem& IndexSubsystem = Context.GetSubsystemChecked<UMassSpatialIndexSubsystem>();
+				const FMassSpatialIndexLayerMask EnemyLayerMask = Context.GetSubsystemChecked<UBulletHellSubsystem>().GetEnemyLayerMask();
+				const auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
+				const int32 NumEntities = Context.GetNumEntities();
 
-				// ʹùϣгΧѯҳĺѡʵ
-				TArray<FMassEntityHandle> Entities;
-				BulletHellSubsystem->GetHashGrid().Query(FBox::BuildAABB(Location, FVector(50.f)), Entities);
+				// 区块的回调在同一线程上不会嵌套执行，线程局部的数组可以直接复用
+				FBulletEnemyQueryScratch& Scratch = BulletEnemyQueryScratch;
+				TArray<int32>& EnemySlots = Scratch.EnemySlots;
+				TArray<TPair<FMassEntityHandle, FMassEntityHandle>>& ChunkHits = Scratch.ChunkHits;
+				ChunkHits.Reset();
+				for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+				{
+					const FVector Location = TransformFragments[EntityIdx].GetTransform().GetLocation();
 
-				// Ժѡʵһȷľжϣ˳ײʵ
-				Entities = Entities.FilterByPredicate([&Location, &EntityManager](const FMassEntityHandle& Entity)
+					EnemySlots.Reset();
+					IndexSubsystem.Query(FBox::BuildAABB(Location, FVector(BulletHitRadius)), EnemyLayerMask, EnemySlots);
+					for (const int32 Slot : EnemySlots)
 					{
-						auto EntityLocation = EntityManager.GetFragmentDataPtr<FTransformFragment>(Entity)->GetTransform().GetLocation();
-						return FVector::Dist(Location, EntityLocation) <= 50.f;
-					});
+						const FMassEntityHandle Enemy = IndexSubsystem.GetEntity(Slot);
+						if (FVector::Dist(Location, GetLocation(Enemy)) <= BulletHitRadius)
+						{
+							ChunkHits.Emplace(Context.GetEntity(EntityIdx), Enemy);
+						}
+					}
+				}
 
-				// ײʵ壬򽫵ǰӵҲбһɾ
-				if (Entities.Num() > 0)
+				if (ChunkHits.Num() > 0)
 				{
-					Entities.Add(Context.GetEntity(EntityIdx));
-					Context.Defer().DestroyEntities(Entities); // Delete bullet as well
+					FScopeLock Lock(&HitsLock);
+					Hits.Append(ChunkHits);
 				}
-			}
-		});
+			});
+	}
+	else
+	{
+		// 先收集子弹的位置与范围，按平均密度选择格子边长，使每个格子大约有 BulletGridTargetOccupancy 颗子弹；
+		// 边长不小于命中范围，敌人的查询最多覆盖 2x2 个格子
+		TArray<TPair<FMassEntityHandle, FVector>> Bullets;
+		Bullets.Reserve(NumBullets);
+		FBox2D BulletBounds(ForceInit);
+		EntityQuery.ForEachEntityChunk(Context, [&Bullets, &BulletBounds](FMassExecutionContext& Context)
+			{
+				const auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
+				const int32 NumEntities = Context.GetNumEntities();
+
+				for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+				{
+					const FVector Location = TransformFragments[EntityIdx].GetTransform().GetLocation();
+					Bullets.Emplace(Context.GetEntity(EntityIdx), Location);
+					BulletBounds += FVector2D(Location);
+				}
+			});
+
+		const FVector2D BoundsSize = BulletBounds.GetSize();
+		const double AreaPerBullet = FMath::Max(BoundsSize.X, 1.0) * FMath::Max(BoundsSize.Y, 1.0) / FMath::Max(Bullets.Num(), 1);
+		const float CellSize = static_cast<float>(FMath::Max(FMath::Sqrt(AreaPerBullet * FMath::Max(BulletGridTargetOccupancy, 1.f)), 2.0 * BulletHitRadius));
+
+		// 子弹按点插入临时网格，再由每个敌人查询
+		FBHEntityHashGrid BulletHashGrid(CellSize);
+		for (const TPair<FMassEntityHandle, FVector>& Bullet : Bullets)
+		{
+			BulletHashGrid.Add(Bullet.Key, FBox(Bullet.Value, Bullet.Value));
+		}
+
+		EnemyQuery.ForEachEntityChunk(Context, [&BulletHashGrid, &Hits, &Candidates, &GetLocation](FMassExecutionContext& Context)
+			{
+				const auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
+				const int32 NumEntities = Context.GetNumEntities();
+
+				for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+				{
+					const FVector Location = TransformFragments[EntityIdx].GetTransform().GetLocation();
+
+					Candidates.Reset();
+					BulletHashGrid.Query(FBox::BuildAABB(Location, FVector(BulletHitRadius)), Candidates);
+					for (const FMassEntityHandle& Bullet : Candidates)
+					{
+						if (FVector::Dist(GetLocation(Bullet), Location) <= BulletHitRadius)
+						{
+							Hits.Emplace(Bullet, Context.GetEntity(EntityIdx));
+						}
+					}
+				}
+			});
+	}
+
+	if (Hits.IsEmpty())
+	{
+		return;
+	}
+
+	BulletHell::Stats::NumCollisions += Hits.Num();
+
+	// 一颗子弹可能命中多个敌人，一个敌人也可能被多颗子弹命中，去重后一次性销毁
+	TArray<FMassEntityHandle> EntitiesToDestroy;
+	EntitiesToDestroy.Reserve(Hits.Num() * 2);
+	for (const TPair<FMassEntityHandle, FMassEntityHandle>& Hit : Hits)
+	{
+		EntitiesToDestroy.Add(Hit.Key);
+		EntitiesToDestroy.Add(Hit.Value);
+	}
+	EntitiesToDestroy.Sort([](const FMassEntityHandle& A, const FMassEntityHandle& B) { return A.AsNumber() < B.AsNumber(); });
+	EntitiesToDestroy.SetNum(Algo::Unique(EntitiesToDestroy));
+
+	Context.Defer().DestroyEntities(EntitiesToDestroy);
 }
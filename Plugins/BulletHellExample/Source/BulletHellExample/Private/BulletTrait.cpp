@@ -2,11 +2,17 @@
 
 
 #include "BulletTrait.h"
+#include "MassCommonFragments.h"
 #include "MassEntityTemplateRegistry.h"
 
 void UBulletTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
 {
 
 	BuildContext.AddFragment(FConstStructView::Make(BulletFragment));
+	BuildContext.AddFragment<FBulletLifetimeFragment>();
+	BuildContext.AddFragment<FBulletOriginFragment>();
+	BuildContext.AddFragment<FBulletVelocityFragment>();
+	BuildContext.AddFragment<FBulletPositionFragment>();
+	BuildContext.RequireFragment<FTransformFragment>();
 	BuildContext.AddTag<FBulletTag>();
 }
@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MassProcessor.h"
+#include "BHEmitterProcessor.generated.h"
+
+/**
+ * 弹幕发射器处理器，在工作线程上为到期的发射器按模式生成子弹请求
+ */
+UCLASS()
+class BULLETHELLEXAMPLE_API UBHEmitterProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UBHEmitterProcessor();
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+	FMassEntityQuery EntityQuery;
+};
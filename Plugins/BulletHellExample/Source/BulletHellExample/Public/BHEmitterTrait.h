@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MassEntityTraitBase.h"
+#include "MassEntityTypes.h"
+#include "BHEmitterTrait.generated.h"
+
+class UMassEntityConfigAsset;
+
+/**
+ * @brief 弹幕发射模式
+ */
+UENUM()
+enum class EBHEmitterPattern : uint8
+{
+	/** 环形：每次发射沿一圈均匀分布，朝向固定 */
+	Radial,
+	/** 螺旋：与环形相同，但整圈按角速度持续旋转 */
+	Spiral,
+	/** 扇形瞄准：以指向玩家的方向为中心，在扇形角度内均匀分布 */
+	AimedFan
+};
+
+/**
+ * @brief 发射器参数，作为常量共享片段由同一配置的所有发射器共用
+ */
+USTRUCT()
+struct BULLETHELLEXAMPLE_API FBHEmitterParams : public FMassConstSharedFragment
+{
+	GENERATED_BODY()
+
+	/** 发射模式 */
+	UPROPERTY(Category = "Bullet Hell", EditAnywhere)
+	EBHEmitterPattern Pattern = EBHEmitterPattern::Radial;
+
+	/** 每次发射的子弹数 */
+	UPROPERTY(Category = "Bullet Hell", EditAnywhere, meta = (ClampMin = 1))
+	int32 BulletsPerShot = 12;
+
+	/** 两次发射之间的间隔（秒） */
+	UPROPERTY(Category = "Bullet Hell", EditAnywhere, meta = (ClampMin = 0.0))
+	float Cadence = 0.5f;
+
+	/** 螺旋模式的旋转角速度（度/秒） */
+	UPROPERTY(Category = "Bullet Hell", EditAnywhere)
+	float AngularVelocity = 90.f;
+
+	/** 扇形瞄准模式的扇形总角度（度） */
+	UPROPERTY(Category = "Bullet Hell", EditAnywhere, meta = (ClampMin = 0.0, ClampMax = 360.0))
+	float FanAngle = 60.f;
+
+	/** 发射的子弹配置 */
+	UPROPERTY(Category = "Bullet Hell", EditAnywhere)
+	TObjectPtr<UMassEntityConfigAsset> BulletConfig;
+};
+
+/**
+ * @brief 发射器运行状态
+ */
+USTRUCT()
+struct BULLETHELLEXAMPLE_API FBHEmitterStateFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	/** 下一次发射的模拟刻度 */
+	uint32 NextShotTick = 0;
+};
+
+/**
+ * @brief 发射器标签，用于标识弹幕发射器实体
+ */
+USTRUCT()
+struct BULLETHELLEXAMPLE_API FBHEmitterTag : public FMassTag
+{
+	GENERATED_BODY()
+};
+
+/**
+ * @brief 弹幕发射器特征类
+ *
+ * 发射器由 UBHEmitterProcessor 在工作线程上按参数生成子弹请求，
+ * 再由 UBulletHellSubsystem 按子弹配置合并后批量生成，不再需要蓝图逐颗调用 SpawnBullet。
+ */
+UCLASS()
+class BULLETHELLEXAMPLE_API UBHEmitterTrait : public UMassEntityTraitBase
+{
+	GENERATED_BODY()
+
+protected:
+	virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+
+	/** 发射器参数 */
+	UPROPERTY(Category = "Bullet Hell", EditAnywhere)
+	FBHEmitterParams EmitterParams;
+};
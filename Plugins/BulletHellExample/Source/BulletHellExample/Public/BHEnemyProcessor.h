@@ -3,8 +3,6 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "MassObserverProcessor.h"
-
 #include "MassProcessor.h"
 #include "BHEnemyProcessor.generated.h"
 
@@ -22,33 +20,4 @@ class BULLETHELLEXAMPLE_API UBHEnemyProcessor : public UMassProcessor
 	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
 
 	FMassEntityQuery EntityQuery;
-
-	FMassEntityQuery UpdateHashGridQuery;
-};
-
-
-UCLASS()
-class UBHEnemyInitializer : public UMassObserverProcessor
-{
-	GENERATED_BODY()
-
-public:
-	UBHEnemyInitializer();
-	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
-	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
-
-	FMassEntityQuery EntityQuery;
-};
-
-UCLASS()
-class UBHEnemyDestructor : public UMassObserverProcessor
-{
-	GENERATED_BODY()
-
-public:
-	UBHEnemyDestructor();
-	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
-	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
-
-	FMassEntityQuery EntityQuery;
 };
@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MassExternalSubsystemTraits.h"
+#include "MassSubsystemBase.h"
+#include "Tasks/Task.h"
+#include "BHFlowFieldSubsystem.generated.h"
+
+/**
+ * @brief 流场数据，以目标为中心的正方形网格
+ *
+ * 每个格子保存到最近目标的路径距离以及沿最短路径下降的单位方向。
+ * 构建完成后只读，可被任意工作线程同时采样。
+ */
+struct BULLETHELLEXAMPLE_API FBHFlowField
+{
+	/** 网格左下角的世界坐标（XY） */
+	FVector2D Origin = FVector2D::ZeroVector;
+
+	/** 单元格边长 */
+	float CellSize = 100.f;
+
+	/** 网格每边的格子数 */
+	int32 Size = 0;
+
+	/** 每个格子到最近目标的路径距离，不可达或阻挡为 MAX_flt */
+	TArray<float> Distance;
+
+	/** 每个格子指向路径距离下降最快邻格的单位方向 */
+	TArray<FVector2f> Direction;
+
+	/** 构建时尚未探测完障碍物的格子数，大于0表示下一次需要重建 */
+	int32 NumUnprobedCells = 0;
+
+	bool IsValid() const { return Size > 0; }
+
+	/**
+	 * 采样流场
+	 * @param Location 采样位置
+	 * @param OutDirection 输出沿流场前进的单位方向（Z为0）
+	 * @param OutDistance 输出到目标的路径距离
+	 * @return 位置在网格内且可达时返回true，否则调用者应回退为直线追踪
+	 */
+	bool Sample(const FVector& Location, FVector& OutDirection, float& OutDistance) const;
+};
+
+/**
+ * @brief 流场子系统，为敌人提供朝向最近目标的绕障导航方向
+ *
+ * 每帧在游戏线程上探测障碍物（结果按世界格子缓存，并有每帧预算），
+ * 再在工作线程上以所有目标为源点用 Dijkstra 计算距离场与方向场。敌人只需一次查表即可得到前进方向。
+ * 流场双缓冲：采样始终读取上一次构建完成的结果。
+ */
+UCLASS()
+class BULLETHELLEXAMPLE_API UBHFlowFieldSubsystem : public UMassTickableSubsystemBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * 采样当前流场，线程安全
+	 * @see FBHFlowField::Sample
+	 */
+	bool SampleFlowField(const FVector& Location, FVector& OutDirection, float& OutDistance) const;
+
+protected:
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	/** 在游戏线程上收集以网格原点为基准的阻挡信息，返回未探测的格子数 */
+	int32 GatherObstacles(const FVector2D& Origin, float CellSize, int32 Size, float ProbeZ, TArray<uint8>& OutBlocked);
+
+	/** 当前用于采样的流场 */
+	TSharedPtr<const FBHFlowField, ESPMode::ThreadSafe> CurrentField;
+
+	/** 正在工作线程上构建的流场 */
+	UE::Tasks::TTask<TSharedPtr<FBHFlowField, ESPMode::ThreadSafe>> BuildTask;
+
+	/** 静态障碍物探测缓存，键为世界格子坐标 */
+	TMap<FIntPoint, bool> BlockedCellCache;
+
+	/** 障碍物缓存对应的格子边长 */
+	float BlockedCellCacheCellSize = 0.f;
+
+	/** 上一次构建时各目标所在的世界格子 */
+	TArray<FIntPoint> LastTargetCells;
+};
+
+template<>
+struct TMassExternalSubsystemTraits<UBHFlowFieldSubsystem> final
+{
+	enum
+	{
+		GameThreadOnly = false
+	};
+};
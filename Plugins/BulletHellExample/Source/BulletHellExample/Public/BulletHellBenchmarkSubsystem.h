@@ -0,0 +1,123 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#include "MassSubsystemBase.h"
+#include "BulletHellBenchmarkSubsystem.generated.h"
+
+class UMassEntityConfigAsset;
+
+/**
+ * @brief 压测参数
+ *
+ * 可通过控制台参数或命令行 -BulletHellBenchmark="..." 以 Key=Value 形式覆盖，例如：
+ * BulletHell.Benchmark EnemyConfig=/Game/BH/DA_Enemy BulletConfig=/Game/BH/DA_Bullet Enemies=2000 Bullets=300 Frames=1200
+ */
+struct FBHBenchmarkSettings
+{
+	/** 敌人实体配置资产路径，没有默认值，NumEnemies 大于 0 时必须指定 */
+	FString EnemyConfigPath;
+
+	/** 子弹实体配置资产路径，为空时使用 UBulletHellSubsystem::BulletConfigAsset */
+	FString BulletConfigPath;
+
+	/** 开始时生成的敌人数量 */
+	int32 NumEnemies = 1000;
+
+	/** 合成玩家每帧发射的子弹数量 */
+	int32 BulletsPerFrame = 200;
+
+	/** 不计入汇总的预热帧数 */
+	int32 WarmupFrames = 60;
+
+	/** 采样帧数 */
+	int32 NumFrames = 600;
+
+	/** 敌人生成的环形区域外半径 */
+	float SpawnRadius = 4000.f;
+
+	/** 合成目标的圆周半径 */
+	float TargetOrbitRadius = 500.f;
+
+	/** 合成目标的角速度（度/秒） */
+	float TargetOrbitSpeed = 30.f;
+
+	/** 随机种子，相同种子生成相同的场景 */
+	int32 Seed = 1337;
+
+	/** 结束后退出进程，用于无头运行 */
+	bool bExitWhenDone = false;
+
+	/** 从 Key=Value 形式的字符串解析参数，未出现的键保持原值 */
+	void Parse(const TCHAR* Stream);
+};
+
+/**
+ * @brief BulletHell 无头压测子系统
+ *
+ * 使用脚本化的合成目标代替玩家，按固定种子生成敌人，并让目标每帧向四周发射子弹。
+ * 运行固定帧数后把逐帧数据（帧耗时、实体数量、子弹/碰撞计数、各处理器耗时）写入
+ * Saved/Profiling/BulletHell 下的 CSV，并在日志中输出汇总。
+ */
+UCLASS()
+class BULLETHELLEXAMPLE_API UBulletHellBenchmarkSubsystem : public UMassTickableSubsystemBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * 开始压测，正在运行时忽略
+	 * @return 配置资产加载失败时返回false
+	 */
+	bool StartBenchmark(const FBHBenchmarkSettings& InSettings);
+
+	bool IsRunning() const { return bRunning; }
+
+protected:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	/** 单帧采样 */
+	struct FFrameSample
+	{
+		double FrameSec = 0.0;
+		int32 NumEnemies = 0;
+		int64 BulletsSpawned = 0;
+		int64 BulletsIntegrated = 0;
+		int64 Collisions = 0;
+		bool bEnemiesQueryBullets = false;
+		double EnemySec = 0.0;
+		double EmitterSec = 0.0;
+		double FlowFieldSec = 0.0;
+		double BulletInitializeSec = 0.0;
+		double BulletIntegrationSec = 0.0;
+		double BulletCollisionSec = 0.0;
+		double BulletExpirySec = 0.0;
+	};
+
+	/** 合成目标发射本帧的子弹 */
+	void FireBullets();
+
+	/** 写出 CSV 与汇总并结束压测 */
+	void FinishBenchmark();
+
+	FBHBenchmarkSettings Settings;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UMassEntityConfigAsset> BulletConfig;
+
+	FRandomStream RandomStream;
+
+	TArray<FFrameSample> Samples;
+
+	/** 已运行的帧数（含预热） */
+	int32 FrameCounter = 0;
+
+	double LastFrameTime = 0.0;
+
+	bool bRunning = false;
+};
@@ -13,33 +13,30 @@
  * 
  */
 /**
- * @brief Ƭṹ壬ڴ洢˵ĻϢ
+ * @brief 敌人碎片结构体，用于存储敌人的基本属性信息
  * 
- * ýṹ̳FMassFragment˵˵ֵײΧλϢ
- * ҪڴģʵԹ
+ * 该结构体继承自FMassFragment，包含了敌人的生命值与碰撞范围，网格位置由统一空间索引维护，
+ * 主要用于大规模敌人实体的属性管理。
  */
 USTRUCT()
 struct BULLETHELLEXAMPLE_API FBHEnemyFragment : public FMassFragment
 {
 	GENERATED_BODY()
 
-	/** ֵڱ༭޸ */
+	/** 敌人生命值，可在编辑器中修改 */
 	UPROPERTY(EditAnywhere)
 	float Health;
 
-	/** ײķΧĬֵΪ(100, 100, 100) */
+	/** 敌人碰撞检测的范围，默认值为(100, 100, 100) */
 	UPROPERTY(EditAnywhere)
 	FVector CollisionExtent = FVector(100.f);
-
-	/** ʵϣеλϢ */
-	FBHEntityHashGrid::FCellLocation CellLocation;
 };
 
 /**
- * @brief ˱ǩṹ壬ڱʶʵΪ
+ * @brief 敌人标签结构体，用于标识实体为敌人类型
  * 
- * ýṹ̳FMassTagΪһǽṹֵʵ壬
- * ݳԱΪͱʶʹá
+ * 该结构体继承自FMassTag，作为一个标记结构体来区分敌人实体，
+ * 不包含具体的数据成员，仅作为类型标识使用。
  */
 USTRUCT()
 struct BULLETHELLEXAMPLE_API FBHEnemyTag : public FMassTag
@@ -48,10 +45,10 @@ struct BULLETHELLEXAMPLE_API FBHEnemyTag : public FMassTag
 };
 
 /**
- * @brief ӵ࣬ڹʵģ
+ * @brief 子弹地狱敌人特征类，用于构建敌人实体模板
  * 
- * ̳UMassEntityTraitBaseõʵģ壬
- * ˵Ƭݺá
+ * 该类继承自UMassEntityTraitBase，负责定义和配置敌人实体的特征模板，
+ * 包含了敌人碎片数据和其他相关属性设置。
  */
 UCLASS()
 class BULLETHELLEXAMPLE_API UBulletHellEnemyTrait : public UMassEntityTraitBase
@@ -61,17 +58,17 @@ class BULLETHELLEXAMPLE_API UBulletHellEnemyTrait : public UMassEntityTraitBase
 protected:
 
 	/**
-	 * @brief ʵģĺĺ
+	 * @brief 构建实体模板的核心函数
 	 * 
-	 * úд˸麯ڸݴĹĺϢ
-	 * úʹʵģ塣
+	 * 该函数重写了父类的虚函数，用于根据传入的构建上下文和世界信息
+	 * 来配置和创建敌人实体的模板。
 	 * 
-	 * @param BuildContext ʵģ幹ģҪĸϢ͹
-	 * @param World ǰϷãṩصϢ
+	 * @param BuildContext 实体模板构建上下文，包含构建过程中需要的各种信息和工具
+	 * @param World 当前的游戏世界引用，提供世界相关的上下文信息
 	 */
 	virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
 
-	/** Ƭݣ"Bullet Hell"£ڱ༭б༭ */
+	/** 敌人碎片数据，包含在"Bullet Hell"分类下，可在编辑器中编辑 */
 	UPROPERTY(Category = "Bullet Hell", EditAnywhere)
 	FBHEnemyFragment BHEnemyFragment;
 	
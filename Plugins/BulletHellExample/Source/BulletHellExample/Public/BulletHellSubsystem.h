@@ -4,7 +4,12 @@
 
 #include "CoreMinimal.h"
 
+#include <atomic>
+
+#include "Containers/StaticArray.h"
 #include "HierarchicalHashGrid2D.h"
+#include "MassEntityHandle.h"
+#include "MassSpatialIndexSubsystem.h"
 #include "MassSubsystemBase.h"
 
 #include "MassProcessor.h"
@@ -14,13 +19,155 @@
 namespace BulletHell::Signals
 {
 	const FName BulletSpawned = FName(TEXT("BulletSpawned"));
-	const FName BulletDestroy = FName(TEXT("BulletDestroy"));
 }
 
+namespace BulletHell
+{
+	/** 模拟刻度的时长（秒），子弹寿命以该刻度计量 */
+	constexpr float TickInterval = 1.f / 60.f;
+
+	/** 目标集合的容量上限 */
+	constexpr int32 MaxTargets = 64;
+}
+
+/**
+ * @brief 敌人追踪的目标集合（玩家、友军、诱饵）
+ *
+ * 坐标按 SoA 存储，每帧由子系统在游戏线程上重建一次，处理阶段只读。
+ * 最近目标查询每次处理4个查询位置，逐个目标广播比较，开销与目标数量成线性关系。
+ */
+struct BULLETHELLEXAMPLE_API FBHTargetSet
+{
+	void Reset();
+
+	/** 添加目标，超过 BulletHell::MaxTargets 时忽略 */
+	void Add(const FVector& Location);
+
+	int32 Num() const { return X.Num(); }
+	bool IsEmpty() const { return X.IsEmpty(); }
+
+	FVector GetLocation(int32 TargetIndex) const { return FVector(X[TargetIndex], Y[TargetIndex], Z[TargetIndex]); }
+
+	/**
+	 * 查询每个位置最近的目标
+	 * @param Locations 查询位置
+	 * @param OutTargetIndices 输出最近目标的下标，与 Locations 一一对应；集合为空时为 INDEX_NONE
+	 */
+	void FindNearest(TConstArrayView<FVector> Locations, TArrayView<int32> OutTargetIndices) const;
+
+	TArray<float, TInlineAllocator<8>> X;
+	TArray<float, TInlineAllocator<8>> Y;
+	TArray<float, TInlineAllocator<8>> Z;
+};
+
+/**
+ * @brief BulletHell 统计信息，供压测工具逐帧读取
+ *
+ * 计数器由处理器在工作线程上累加，读取方取走后清零；耗时为最近一帧的值（秒）。
+ */
+namespace BulletHell::Stats
+{
+	inline std::atomic<int64> NumBulletsSpawned = 0;
+	inline std::atomic<int64> NumBulletsIntegrated = 0;
+	inline std::atomic<int64> NumCollisions = 0;
+
+	/** 本帧子弹碰撞是否由敌人查询子弹网格（否则为子弹查询敌人网格） */
+	inline bool bEnemiesQueryBullets = false;
+
+	inline double EnemyTimeSec = 0.0;
+	inline double EmitterTimeSec = 0.0;
+	inline double BulletInitializeTimeSec = 0.0;
+	inline double BulletIntegrationTimeSec = 0.0;
+	inline double BulletCollisionTimeSec = 0.0;
+	inline double BulletExpiryTimeSec = 0.0;
+	inline double FlowFieldTimeSec = 0.0;
+}
 
+
+//子弹碰撞时临时构建的子弹网格；敌人由统一空间索引的 BulletHellEnemy 图层索引
 typedef THierarchicalHashGrid2D<2, 4, FMassEntityHandle> FBHEntityHashGrid;
 
+/**
+ * @brief 哈希时间轮，按到期刻度对实体分桶
+ *
+ * 刻度对槽数取模得到桶，插入为O(1)，每个刻度只需取出一个桶。
+ * 到期刻度超出一圈的实体会留在桶内，直到其真正到期的那一圈。
+ */
+struct BULLETHELLEXAMPLE_API FBHTimingWheel
+{
+	/** 槽数，必须为2的幂 */
+	static constexpr uint32 NumSlots = 512;
+
+	/**
+	 * 登记一个实体的到期刻度
+	 * @param Entity 实体句柄
+	 * @param ExpiryTick 到期刻度，早于当前刻度时会在下一刻度到期
+	 */
+	void Schedule(const FMassEntityHandle Entity, uint32 ExpiryTick);
+
+	/**
+	 * 推进时间轮到指定刻度，并取出期间到期的所有实体
+	 * @param Tick 推进到的刻度（包含）
+	 * @param OutExpired 追加输出到期的实体
+	 */
+	void Advance(uint32 Tick, TArray<FMassEntityHandle>& OutExpired);
+
+	/** 当前登记的实体数 */
+	int32 Num() const { return NumScheduled; }
+
+private:
+	struct FEntry
+	{
+		FMassEntityHandle Entity;
+		uint32 ExpiryTick;
+	};
+
+	TStaticArray<TArray<FEntry>, NumSlots> Slots;
+
+	/** 已经处理过的最后一个刻度 */
+	uint32 LastTick = 0;
+
+	int32 NumScheduled = 0;
+};
+
+class AActor;
 class UMassEntityConfigAsset;
+
+/**
+ * @brief 一次子弹生成请求
+ */
+USTRUCT()
+struct BULLETHELLEXAMPLE_API FBHBulletSpawnRequest
+{
+	GENERATED_BODY()
+
+	FBHBulletSpawnRequest() = default;
+	FBHBulletSpawnRequest(const FVector& InLocation, const FVector& InDirection, const FMassEntityHandle InEmitter = FMassEntityHandle())
+		: Location(InLocation), Direction(InDirection), Emitter(InEmitter)
+	{
+	}
+
+	/** 子弹生成位置 */
+	FVector Location = FVector::ZeroVector;
+
+	/** 子弹移动方向 */
+	FVector Direction = FVector::ForwardVector;
+
+	/** 发出该子弹的发射器，排队的请求按它排序，使生成顺序与工作线程的完成顺序无关 */
+	FMassEntityHandle Emitter;
+};
+
+/**
+ * @brief 一批使用同一子弹配置的生成请求，同时作为 UBulletSpawnDataInitializer 的生成数据
+ */
+USTRUCT()
+struct BULLETHELLEXAMPLE_API FBHBulletSpawnData
+{
+	GENERATED_BODY()
+
+	TArray<FBHBulletSpawnRequest> Requests;
+};
+
 /**
  * 
  */
@@ -30,30 +177,129 @@ class BULLETHELLEXAMPLE_API UBulletHellSubsystem : public UMassTickableSubsystem
 	GENERATED_BODY()
 
 public:
-	const FBHEntityHashGrid& GetHashGrid() const;
-	FBHEntityHashGrid& GetHashGrid_Mutable();
+	/** 敌人在统一空间索引中的图层名 */
+	static const FName EnemyLayerName;
 
+	/** 敌人在统一空间索引中的图层掩码 */
+	FMassSpatialIndexLayerMask GetEnemyLayerMask() const { return EnemyLayerMask; }
+
+	/** 当前的敌人数量 */
+	int32 GetNumEnemies() const;
+
+	/** 获取主目标（第一个目标）的位置，没有目标时为最后一次已知位置 */
 	void GetPlayerLocation(FVector& OutLocation) const;
 
+	/** 本帧的目标集合，处理阶段可在任意线程上只读访问 */
+	const FBHTargetSet& GetTargets() const { return Targets; }
+
+	/**
+	 * 登记额外的追踪目标（友军、诱饵等），每帧读取其位置
+	 * @param Actor 目标 Actor
+	 */
+	UFUNCTION(BlueprintCallable)
+	void RegisterTarget(AActor* Actor);
+
+	/** 取消登记的追踪目标 */
+	UFUNCTION(BlueprintCallable)
+	void UnregisterTarget(AActor* Actor);
+
+	/**
+	 * 使用脚本化的合成目标代替玩家 Pawn，目标以固定角速度绕中心做圆周运动。
+	 * 用于没有玩家的无头压测（-nullrhi）。
+	 * @param Center 圆周中心
+	 * @param OrbitRadius 圆周半径
+	 * @param OrbitSpeed 角速度（度/秒）
+	 */
+	void SetSyntheticTarget(const FVector& Center, float OrbitRadius, float OrbitSpeed);
+
+	/** 恢复为跟随玩家 Pawn */
+	void ClearSyntheticTarget();
+
+	/** 当前模拟刻度，每 BulletHell::TickInterval 秒递增一次 */
+	uint32 GetCurrentTick() const { return CurrentTick; }
+
+	/** 将秒数换算为刻度数（向上取整，至少为1） */
+	static uint32 SecondsToTicks(float Seconds);
+
+	/**
+	 * 登记子弹的到期刻度，到期后由 UBulletExpiryProcessor 批量销毁
+	 * @param Entity 子弹实体
+	 * @param ExpiryTick 到期刻度
+	 */
+	void ScheduleExpiry(const FMassEntityHandle Entity, uint32 ExpiryTick);
+
+	/**
+	 * 取出截至当前刻度到期的所有实体
+	 * @param OutExpired 追加输出到期的实体
+	 */
+	void CollectExpired(TArray<FMassEntityHandle>& OutExpired);
+
 	UFUNCTION(BlueprintCallable)
 	void SpawnBullet(UMassEntityConfigAsset* BulletConfig, const FVector& Location, const FVector& Direction);
 
+	/**
+	 * 用一次生成调用批量生成子弹
+	 * @param BulletConfig 子弹配置资产
+	 * @param SpawnData 生成请求
+	 */
+	void SpawnBullets(UMassEntityConfigAsset* BulletConfig, const FBHBulletSpawnData& SpawnData);
+
+	/**
+	 * 将生成请求加入队列，在本帧 Tick 中按配置合并后批量生成；可在工作线程上调用
+	 * 生成前按发射器排序，同一发射器的请求保持提交顺序，因此生成顺序与调用线程的先后无关
+	 * @param BulletConfig 子弹配置资产
+	 * @param Requests 生成请求
+	 */
+	void QueueBulletSpawns(UMassEntityConfigAsset* BulletConfig, TConstArrayView<FBHBulletSpawnRequest> Requests);
+
 	UPROPERTY(EditAnywhere)
 	UMassEntityConfigAsset* BulletConfigAsset;
 
 protected:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 	virtual void Tick(float DeltaTime) override;
 	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
 	virtual TStatId GetStatId() const override;
 
 private:
-	FVector PlayerLocation;
+	FVector PlayerLocation = FVector::ZeroVector;
+
+	/** 重建本帧的目标集合 */
+	void UpdateTargets();
+
+	/** 本帧的目标集合 */
+	FBHTargetSet Targets;
+
+	/** 额外登记的目标 */
+	TArray<TWeakObjectPtr<AActor>> RegisteredTargets;
+
+	/** 是否使用合成目标 */
+	bool bUseSyntheticTarget = false;
+
+	FVector SyntheticTargetCenter = FVector::ZeroVector;
+	float SyntheticTargetRadius = 0.f;
+	float SyntheticTargetSpeed = 0.f;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UMassSpatialIndexSubsystem> SpatialIndex;
+
+	FMassSpatialIndexLayerMask EnemyLayerMask = 0;
+
+	/** 子弹寿命时间轮 */
+	FBHTimingWheel LifetimeWheel;
+
+	/** 当前模拟刻度 */
+	uint32 CurrentTick = 0;
+
+	/** 尚未累计满一个刻度的时间 */
+	float TickAccumulator = 0.f;
 
-	UPROPERTY()
-	APawn* CachedPlayerPawn;
+	/** 等待批量生成的子弹，按子弹配置分组 */
+	UPROPERTY(Transient)
+	TMap<TObjectPtr<UMassEntityConfigAsset>, FBHBulletSpawnData> PendingBulletSpawns;
 
-	FBHEntityHashGrid EntityHashGrid;
-	
+	/** 保护 PendingBulletSpawns，发射器处理器会在多个工作线程上写入 */
+	FCriticalSection PendingBulletSpawnsLock;
 };
 
 template<>
@@ -8,6 +8,8 @@
 #include "MassSignalProcessorBase.h"
 #include "BulletProcessor.generated.h"
 
+class UBulletHellSubsystem;
+
 /**
  * 
  */
@@ -25,20 +27,51 @@ class BULLETHELLEXAMPLE_API UBulletInitializerProcessor : public UMassSignalProc
 	
 };
 
+//批量生成子弹时的初始化处理器，把 FBHBulletSpawnData 中的位置与方向写入新生成的子弹
 UCLASS()
-class UBulletDestroyerProcessor : public UMassSignalProcessorBase
+class BULLETHELLEXAMPLE_API UBulletSpawnDataInitializer : public UMassProcessor
 {
 	GENERATED_BODY()
 
 public:
+	UBulletSpawnDataInitializer();
 	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
-	virtual void InitializeInternal(UObject& Owner, const TSharedRef<FMassEntityManager>& EntityManager) override;
-	virtual void SignalEntities(FMassEntityManager& EntityManager, FMassExecutionContext& Context, FMassSignalNameLookup& EntitySignals) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
 
-	UBulletDestroyerProcessor();
 	FMassEntityQuery EntityQuery;
 };
 
+//以固定刻度推进子弹位置，结果只取决于刻度数，与帧率无关，可逐位复现
+UCLASS()
+class UBulletIntegrationProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UBulletIntegrationProcessor();
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+	FMassEntityQuery EntityQuery;
+};
+
+//每帧从 UBulletHellSubsystem 的寿命时间轮中取出到期的子弹，并一次性批量销毁
+UCLASS()
+class UBulletExpiryProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	UBulletExpiryProcessor();
+	virtual void InitializeInternal(UObject& Owner, const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+	UPROPERTY(Transient)
+	TObjectPtr<UBulletHellSubsystem> BulletHellSubsystem;
+
+	TArray<FMassEntityHandle> ExpiredEntities;
+};
+
 UCLASS()
 class UBulletCollisionProcessor : public UMassProcessor
 {
@@ -50,4 +83,7 @@ public:
 	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
 
 	FMassEntityQuery EntityQuery;
+
+	//敌人查询子弹网格时遍历的敌人
+	FMassEntityQuery EnemyQuery;
 };
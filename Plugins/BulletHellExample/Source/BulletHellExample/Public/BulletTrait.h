@@ -27,6 +27,44 @@ struct FBulletFragment : public FMassFragment
 	float Lifetime = 5.f;
 };
 
+//子弹的生成刻度与到期刻度，由 UBulletInitializerProcessor 根据 FBulletFragment::Lifetime 计算
+USTRUCT()
+struct FBulletLifetimeFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	uint32 SpawnTick = 0;
+
+	uint32 ExpiryTick = 0;
+};
+
+//子弹在生成刻度时的位置，块内为连续的 float3 数组
+USTRUCT()
+struct FBulletOriginFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector3f Value = FVector3f::ZeroVector;
+};
+
+//子弹速度，块内为连续的 float3 数组
+USTRUCT()
+struct FBulletVelocityFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector3f Value = FVector3f::ZeroVector;
+};
+
+//子弹在当前刻度的位置，由 UBulletIntegrationProcessor 写入
+USTRUCT()
+struct FBulletPositionFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	FVector3f Value = FVector3f::ZeroVector;
+};
+
 USTRUCT()
 struct FBulletTag : public FMassTag
 {
@@ -25,7 +25,7 @@ public class MassEntityCollision : ModuleRules
 		PublicDependencyModuleNames.AddRange(
 			new string[]
 			{
-				"Core","MassEntity", "MassEntity", "MassSignals", "MassSpawner",
+				"Core","MassEntity", "MassEntity", "MassSignals", "MassSpawner", "MassSpatialIndex",
 				// ... add other public dependencies that you statically link with here ...
 			}
 			);
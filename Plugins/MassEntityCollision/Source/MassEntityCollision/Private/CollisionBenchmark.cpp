@@ -0,0 +1,239 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CollisionSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "MassCommonFragments.h"
+#include "MassEntityManager.h"
+#include "MassEntitySubsystem.h"
+
+namespace UE::MassEntityCollision::Benchmark
+{
+	typedef THierarchicalHashGrid2D<2, 4, FMassEntityHandle> FEntityHashGrid;
+
+	/**
+	 * 旧的邻居检测方式，与改为槽位存储之前的 ResolveCollisions 相同：每个邻居只查找一次变换片段，
+	 * 重叠距离按当前实体半径的两倍计算（基准中所有智能体半径相同，与半径之和等价）
+	 */
+	static FVector ResolveByEntityLookup(FMassEntityManager& EntityManager, TConstArrayView<FMassEntityHandle> Neighbors,
+		const FVector& Location, float Radius, FVector& OutHitNormal)
+	{
+		FVector Correction(FVector::ZeroVector);
+		for (const FMassEntityHandle& Other : Neighbors)
+		{
+			const FTransformFragment* OtherTransform = EntityManager.GetFragmentDataPtr<FTransformFragment>(Other);
+			const FVector OtherLocation = OtherTransform->GetTransform().GetLocation();
+			const double DistSq = FVector::DistSquared(Location, OtherLocation);
+			if (DistSq < FMath::Square(Radius * 2))
+			{
+				FVector Direction = (Location - OtherLocation).GetSafeNormal();
+				Direction.Z = 0.f;
+				Correction += (Radius * 2 - FMath::Sqrt(DistSq) + 0.01f) / 2 * Direction;
+				OutHitNormal = Direction;
+			}
+		}
+		return Correction;
+	}
+
+	/**
+	 * 比较两种邻居数据访问方式的耗时：实体句柄查找片段 与 紧凑槽位存储。
+	 * 两者使用相同的分布、相同的网格查询，只有邻居数据的读取方式不同。
+	 * 用法：MassEntityCollision.Benchmark [Agents=50000] [Passes=10] [Radius=40]
+	 */
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		UMassEntitySubsystem* EntitySubsystem = World ? World->GetSubsystem<UMassEntitySubsystem>() : nullptr;
+		if (!EntitySubsystem)
+		{
+			return;
+		}
+
+		const FString Params = FString::Join(Args, TEXT(" "));
+		int32 NumAgents = 50000;
+		int32 NumPasses = 10;
+		float AgentRadius = 40.f;
+		FParse::Value(*Params, TEXT("Agents="), NumAgents);
+		FParse::Value(*Params, TEXT("Passes="), NumPasses);
+		FParse::Value(*Params, TEXT("Radius="), AgentRadius);
+		NumAgents = FMath::Max(NumAgents, 1);
+		NumPasses = FMath::Max(NumPasses, 1);
+
+		FMassEntityManager& EntityManager = EntitySubsystem->GetMutableEntityManager();
+
+		// 按每个智能体约占 (2R)^2 的密度随机分布，接近拥挤人群的邻居数量
+		const float HalfExtent = FMath::Sqrt(static_cast<float>(NumAgents)) * AgentRadius;
+		FRandomStream RandomStream(1337);
+
+		const FMassArchetypeHandle Archetype = EntityManager.CreateArchetype({ FTransformFragment::StaticStruct(), FAgentRadiusFragment::StaticStruct() });
+		TArray<FMassEntityHandle> Entities;
+		EntityManager.BatchCreateEntities(Archetype, NumAgents, Entities);
+
+		FEntityHashGrid EntityGrid(100);
+		FHashGridExample SlotGrid(100);
+		FCollisionSlotStore SlotStore;
+		TArray<int32> Slots;
+		Slots.Reserve(NumAgents);
+
+		for (const FMassEntityHandle& Entity : Entities)
+		{
+			const FVector Location(RandomStream.FRandRange(-HalfExtent, HalfExtent), RandomStream.FRandRange(-HalfExtent, HalfExtent), 0.f);
+			EntityManager.GetFragmentDataChecked<FTransformFragment>(Entity).GetMutableTransform().SetLocation(Location);
+			EntityManager.GetFragmentDataChecked<FAgentRadiusFragment>(Entity).Radius = AgentRadius;
+
+			const FBox Bounds = FBox::BuildAABB(Location, FVector(AgentRadius));
+			EntityGrid.Add(Entity, Bounds);
+
+			const int32 Slot = SlotStore.Allocate(Entity);
+			SlotStore.SetLocation(Slot, Location);
+			SlotStore.Radius[Slot] = AgentRadius;
+			SlotStore.MaxRadius = AgentRadius;
+			SlotGrid.Add(Slot, Bounds);
+			Slots.Add(Slot);
+		}
+
+		// 旧方式：邻居为实体句柄，逐个查找片段
+		double EntityLookupChecksum = 0.0;
+		const double EntityLookupStart = FPlatformTime::Seconds();
+		{
+			TArray<FMassEntityHandle> Neighbors;
+			for (int32 Pass = 0; Pass < NumPasses; Pass++)
+			{
+				for (const FMassEntityHandle& Entity : Entities)
+				{
+					const FVector Location = EntityManager.GetFragmentDataChecked<FTransformFragment>(Entity).GetTransform().GetLocation();
+					Neighbors.Reset();
+					EntityGrid.Query(FBox::BuildAABB(Location, FVector(AgentRadius * 2)), Neighbors);
+					Neighbors.RemoveSwap(Entity, EAllowShrinking::No);
+
+					FVector HitNormal(FVector::ZeroVector);
+					EntityLookupChecksum += ResolveByEntityLookup(EntityManager, Neighbors, Location, AgentRadius, HitNormal).Size();
+				}
+			}
+		}
+		const double EntityLookupSec = FPlatformTime::Seconds() - EntityLookupStart;
+
+		// 新方式：邻居为槽位下标，读取连续的 float 数组
+		double PackedChecksum = 0.0;
+		const double PackedStart = FPlatformTime::Seconds();
+		{
+			TArray<int32> Neighbors;
+			for (int32 Pass = 0; Pass < NumPasses; Pass++)
+			{
+				for (const int32 Slot : Slots)
+				{
+					const FVector Location(SlotStore.X[Slot], SlotStore.Y[Slot], SlotStore.Z[Slot]);
+					Neighbors.Reset();
+					SlotGrid.Query(FBox::BuildAABB(Location, FVector(AgentRadius * 2)), Neighbors);
+					Neighbors.RemoveSwap(Slot, EAllowShrinking::No);
+
+					FVector3f HitNormal(FVector3f::ZeroVector);
+					PackedChecksum += SlotStore.ResolveOverlaps(Slot, Neighbors, HitNormal).Size();
+				}
+			}
+		}
+		const double PackedSec = FPlatformTime::Seconds() - PackedStart;
+
+		EntityManager.BatchDestroyEntities(Entities);
+
+		UE_LOG(LogTemp, Log, TEXT("MassEntityCollision benchmark: %d agents x %d passes. Entity lookup %.3f ms/pass, packed %.3f ms/pass, speedup %.2fx (checksums %.1f / %.1f)"),
+			NumAgents, NumPasses, EntityLookupSec * 1000.0 / NumPasses, PackedSec * 1000.0 / NumPasses,
+			EntityLookupSec / FMath::Max(PackedSec, UE_DOUBLE_SMALL_NUMBER), EntityLookupChecksum, PackedChecksum);
+	}
+
+	/**
+	 * 窄相微基准：在相同的邻居列表上分别运行标量与向量版本，按邻居数量输出每个邻居的耗时，
+	 * 并检查两者结果的最大误差。
+	 * 用法：MassEntityCollision.NarrowPhaseBenchmark [Iterations=200000] [Radius=40]
+	 */
+	static void RunNarrowPhase(const TArray<FString>& Args)
+	{
+		const FString Params = FString::Join(Args, TEXT(" "));
+		int32 NumIterations = 200000;
+		float AgentRadius = 40.f;
+		FParse::Value(*Params, TEXT("Iterations="), NumIterations);
+		FParse::Value(*Params, TEXT("Radius="), AgentRadius);
+		NumIterations = FMath::Max(NumIterations, 1);
+
+		// 邻居分布在 2R 范围内，约一半与中心槽位重叠
+		constexpr int32 NumSlots = 1024;
+		constexpr int32 NumLists = 64;
+		FRandomStream RandomStream(1337);
+		FCollisionSlotStore SlotStore;
+		for (int32 Index = 0; Index < NumSlots; Index++)
+		{
+			const int32 Slot = SlotStore.Allocate(FMassEntityHandle());
+			SlotStore.SetLocation(Slot, FVector(RandomStream.FRandRange(-2 * AgentRadius, 2 * AgentRadius),
+				RandomStream.FRandRange(-2 * AgentRadius, 2 * AgentRadius), 0.f));
+			SlotStore.Radius[Slot] = AgentRadius * RandomStream.FRandRange(0.5f, 1.f);
+		}
+		SlotStore.MaxRadius = AgentRadius;
+
+		for (const int32 NumNeighbors : { 1, 2, 4, 8, 16, 32, 64 })
+		{
+			// 多组随机邻居列表轮流使用，避免每次读取完全相同的缓存行
+			TArray<int32> Centers;
+			TArray<TArray<int32>> Lists;
+			Lists.SetNum(NumLists);
+			for (TArray<int32>& List : Lists)
+			{
+				const int32 Center = RandomStream.RandHelper(NumSlots);
+				Centers.Add(Center);
+				while (List.Num() < NumNeighbors)
+				{
+					const int32 Other = RandomStream.RandHelper(NumSlots);
+					if (Other != Center)
+					{
+						List.Add(Other);
+					}
+				}
+			}
+
+			const int32 NumCalls = FMath::Max(NumIterations / NumNeighbors, NumLists);
+
+			float MaxError = 0.f;
+			for (int32 Index = 0; Index < NumLists; Index++)
+			{
+				FVector3f ScalarNormal(FVector3f::ZeroVector);
+				FVector3f SimdNormal(FVector3f::ZeroVector);
+				const FVector3f Scalar = SlotStore.ResolveOverlapsScalar(Centers[Index], Lists[Index], ScalarNormal);
+				const FVector3f Simd = SlotStore.ResolveOverlapsSimd(Centers[Index], Lists[Index], SimdNormal);
+				MaxError = FMath::Max3(MaxError, (Scalar - Simd).GetAbsMax(), (ScalarNormal - SimdNormal).GetAbsMax());
+			}
+
+			float ScalarChecksum = 0.f;
+			const double ScalarStart = FPlatformTime::Seconds();
+			for (int32 Call = 0; Call < NumCalls; Call++)
+			{
+				const int32 Index = Call % NumLists;
+				FVector3f HitNormal(FVector3f::ZeroVector);
+				ScalarChecksum += SlotStore.ResolveOverlapsScalar(Centers[Index], Lists[Index], HitNormal).X;
+			}
+			const double ScalarSec = FPlatformTime::Seconds() - ScalarStart;
+
+			float SimdChecksum = 0.f;
+			const double SimdStart = FPlatformTime::Seconds();
+			for (int32 Call = 0; Call < NumCalls; Call++)
+			{
+				const int32 Index = Call % NumLists;
+				FVector3f HitNormal(FVector3f::ZeroVector);
+				SimdChecksum += SlotStore.ResolveOverlapsSimd(Centers[Index], Lists[Index], HitNormal).X;
+			}
+			const double SimdSec = FPlatformTime::Seconds() - SimdStart;
+
+			const double NumTests = static_cast<double>(NumCalls) * NumNeighbors;
+			UE_LOG(LogTemp, Log, TEXT("MassEntityCollision narrow phase: %2d neighbors. Scalar %.2f ns/neighbor, SIMD %.2f ns/neighbor, speedup %.2fx, max error %g (checksums %.1f / %.1f)"),
+				NumNeighbors, ScalarSec * 1.e9 / NumTests, SimdSec * 1.e9 / NumTests,
+				ScalarSec / FMath::Max(SimdSec, UE_DOUBLE_SMALL_NUMBER), MaxError, ScalarChecksum, SimdChecksum);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs CollisionBenchmarkCommand(
+	TEXT("MassEntityCollision.Benchmark"),
+	TEXT("比较实体句柄查找与紧凑槽位存储两种邻居检测方式的耗时。参数：Agents= Passes= Radius="),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&UE::MassEntityCollision::Benchmark::Run));
+
+static FAutoConsoleCommand NarrowPhaseBenchmarkCommand(
+	TEXT("MassEntityCollision.NarrowPhaseBenchmark"),
+	TEXT("按邻居数量比较窄相重叠计算的标量与向量版本。参数：Iterations= Radius="),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&UE::MassEntityCollision::Benchmark::RunNarrowPhase));
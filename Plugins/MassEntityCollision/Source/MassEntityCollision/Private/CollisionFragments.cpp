@@ -3,8 +3,15 @@
 
 #include "CollisionFragments.h"
 #include "MassEntityTemplateRegistry.h"
+#include "MassSpatialIndexFragments.h"
 
 void UCollisionFragments::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
 {
     BuildContext.AddFragment<FCollisionFragment>();
+
+    // 邻居查询走统一空间索引，其他特性已经添加时不再重复添加
+    if (!BuildContext.HasFragment<FMassSpatialIndexFragment>())
+    {
+        BuildContext.AddFragment<FMassSpatialIndexFragment>();
+    }
 }
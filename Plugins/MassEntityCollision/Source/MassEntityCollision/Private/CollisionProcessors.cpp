@@ -4,22 +4,80 @@
 #include "CollisionProcessors.h"
 
 #include "CollisionFragments.h"
+#include "CollisionSDFSubsystem.h"
 #include "CollisionSubsystem.h"
 #include "MassCommonFragments.h"
 #include "MassCommonTypes.h"
 #include "MassExecutionContext.h"
 #include "MassLODFragments.h"
 #include "MassMovementFragments.h"
+#include "MassSimulationLOD.h"
+#include "MassSpatialIndexFragments.h"
+#include "Engine/World.h"
+#include "Async/ParallelFor.h"
+#include "HAL/IConsoleManager.h"
 
-//ԪײΧ뾶ڼײ߽
+//没有 FAgentRadiusFragment 的实体使用的默认碰撞半径
 static float HalfRange = 25.f;
 
+//每帧碰撞求解的迭代次数，迭代越多重叠消除越彻底
+static int32 SolverIterations = 1;
+static FAutoConsoleVariableRef CVarSolverIterations(TEXT("MassEntityCollision.SolverIterations"), SolverIterations, TEXT("每帧碰撞求解的迭代次数"));
+
+//是否跨帧缓存候选邻居，只为移动超过迟滞距离一半的实体重新查询网格
+static bool bUseContactCache = true;
+static FAutoConsoleVariableRef CVarUseContactCache(TEXT("MassEntityCollision.ContactCache.Enable"), bUseContactCache, TEXT("是否跨帧缓存候选邻居"));
+
+//邻居缓存的迟滞距离
+static float ContactCacheMargin = 10.f;
+static FAutoConsoleVariableRef CVarContactCacheMargin(TEXT("MassEntityCollision.ContactCache.Margin"), ContactCacheMargin, TEXT("邻居缓存的迟滞距离，实体移动超过一半时重新查询"));
+
+//同时用完整的网格查询计算一遍，检查缓存结果是否一致
+static bool bValidateContactCache = false;
+static FAutoConsoleVariableRef CVarValidateContactCache(TEXT("MassEntityCollision.ContactCache.Validate"), bValidateContactCache, TEXT("用完整的网格查询校验邻居缓存的结果"));
+
+//是否每帧发布接触事件
+static bool bPublishContactEvents = true;
+static FAutoConsoleVariableRef CVarPublishContactEvents(TEXT("MassEntityCollision.ContactEvents.Enable"), bPublishContactEvents, TEXT("是否每帧发布接触事件"));
+
+//达到该模拟 LOD 的区块只做包围盒分离，不做精确的窄相计算（0 高，1 中，2 低）
+static int32 BroadphaseOnlyLOD = EMassLOD::Low;
+static FAutoConsoleVariableRef CVarBroadphaseOnlyLOD(TEXT("MassEntityCollision.LOD.BroadphaseOnlyLOD"), BroadphaseOnlyLOD, TEXT("达到该模拟 LOD 的区块只做包围盒分离（0 高，1 中，2 低）"));
+
+//是否为快速移动的实体分步扫过移动路径
+static bool bEnableSubsteps = true;
+static FAutoConsoleVariableRef CVarEnableSubsteps(TEXT("MassEntityCollision.Substep.Enable"), bEnableSubsteps, TEXT("是否为快速移动的实体分步扫过移动路径"));
+
+//一帧的位移超过半径的多少倍时视为快速移动
+static float SubstepThreshold = 1.f;
+static FAutoConsoleVariableRef CVarSubstepThreshold(TEXT("MassEntityCollision.Substep.Threshold"), SubstepThreshold, TEXT("一帧的位移超过半径的多少倍时分步求解"));
+
+//每个快速移动实体最多的分步数，每步不超过半径的一半，更长的位移被截断在最后一步
+static int32 SubstepMaxSteps = 16;
+static FAutoConsoleVariableRef CVarSubstepMaxSteps(TEXT("MassEntityCollision.Substep.MaxSteps"), SubstepMaxSteps, TEXT("每个快速移动实体最多的分步数，更长的位移被截断"));
+
+//是否启用睡眠，关闭后所有实体每帧都参与求解
+static bool bEnableSleep = true;
+static FAutoConsoleVariableRef CVarEnableSleep(TEXT("MassEntityCollision.Sleep.Enable"), bEnableSleep, TEXT("是否让静止的实体进入睡眠"));
+
+//速度与位移折算速度都低于该值（厘米/秒）时视为静止
+static float SleepSpeedThreshold = 5.f;
+static FAutoConsoleVariableRef CVarSleepSpeedThreshold(TEXT("MassEntityCollision.Sleep.SpeedThreshold"), SleepSpeedThreshold, TEXT("低于该速度（厘米/秒）视为静止"));
+
+//连续静止多少帧后进入睡眠
+static int32 SleepFrames = 30;
+static FAutoConsoleVariableRef CVarSleepFrames(TEXT("MassEntityCollision.Sleep.Frames"), SleepFrames, TEXT("连续静止多少帧后进入睡眠"));
+
+//两个睡眠实体距离小于半径之和加上该值时属于同一睡眠分组，会被一起唤醒
+static float SleepContactMargin = 2.f;
+static FAutoConsoleVariableRef CVarSleepContactMargin(TEXT("MassEntityCollision.Sleep.ContactMargin"), SleepContactMargin, TEXT("判定睡眠实体互相接触的额外距离"));
+
 
 /**
- * @brief ollisionʼ캯
+ * @brief ollision初始化处理器构造函数
  * 
- * ʼʵѯ󣬲ù۲ƬΪFCollisionFragment
- * ΪӲ
+ * 初始化实体查询对象，并设置观察的片段类型为FCollisionFragment，
+ * 操作类型为添加操作。
  */
 UCollisionInitializerProcessor::UCollisionInitializerProcessor() :
 	EntityQuery(*this)
@@ -29,45 +87,49 @@ UCollisionInitializerProcessor::UCollisionInitializerProcessor() :
 }
 
 /**
- * @brief òѯ
+ * @brief 配置查询需求
  * 
- * @param EntityManager ʵãòѯƬκϵͳ
+ * @param EntityManager 实体管理器引用，用于配置查询所需的片段和子系统
  * 
- * ΪʵѯӱҪƬη
- * - FCollisionFragmentдȨ
- * - FTransformFragmentֻȨ  
- * - UCollisionSubsystemдȨ
+ * 为实体查询添加必要的片段访问需求：
+ * - FCollisionFragment：读写访问权限
+ * - FTransformFragment：只读访问权限  
+ * - FAgentRadiusFragment：可选的只读访问权限，用于按真实半径插入网格
+ * - UCollisionSubsystem：读写访问权限
  */
 void UCollisionInitializerProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
 	EntityQuery.AddRequirement<FCollisionFragment>(EMassFragmentAccess::ReadWrite);
 	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
 	EntityQuery.AddSubsystemRequirement<UCollisionSubsystem>(EMassFragmentAccess::ReadWrite);
 }
 
 /**
- * @brief ִײʼ߼
+ * @brief 执行碰撞初始化处理逻辑
  * 
- * @param EntityManager ʵ
- * @param Context ִģǰʵϢ
+ * @param EntityManager 实体管理器引用
+ * @param Context 执行上下文，包含当前处理的实体块信息
  * 
- * зʵ飬Ϊÿʵ壺
- * 1. ȡ任ײƬ
- * 2. ʵλüײ߽
- * 3. ʵӵײϵͳĹϣвƬελϢ
+ * 遍历所有符合条件的实体块，为每个实体：
+ * 1. 获取变换和碰撞片段数据
+ * 2. 分配紧凑存储的槽位并写入位置与半径
+ * 邻居查询使用的空间索引条目由 UMassSpatialIndexInitializerProcessor 负责插入
  */
 void UCollisionInitializerProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
 {
 	EntityQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
 		{
-			// ȡײϵͳ
+			// 获取碰撞子系统引用
 			auto& HashGridSubsystem = Context.GetMutableSubsystemChecked<UCollisionSubsystem>();
 
-			// ȡǰеı任ƬκײƬͼ
+			// 获取当前块中的变换片段和碰撞片段视图
 			const auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
+			const auto RadiusFragments = Context.GetFragmentView<FAgentRadiusFragment>();
 			const auto HashGridFragments = Context.GetMutableFragmentView<FCollisionFragment>();
+			const bool bHasRadius = RadiusFragments.Num() > 0;
 
-			// еʵ
+			// 遍历块中的所有实体
 			const int32 NumEntities = Context.GetNumEntities();
 			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
 			{
@@ -75,21 +137,25 @@ void UCollisionInitializerProcessor::Execute(FMassEntityManager& EntityManager,
 				auto& TransformFragment = TransformFragments[EntityIdx];
 				auto Location = TransformFragment.GetTransform().GetLocation();
 
-				// ʵײ߽
-				FBox Bounds = { Location - HalfRange, Location + HalfRange };
-				
-				// ʵӵϣ񲢸ƬеλϢ
-				HashGridFragment.CellLocation = HashGridSubsystem.HashGridData.Add(Context.GetEntity(EntityIdx), Bounds);
+				// 按实体的真实半径记录碰撞范围
+				const float Radius = bHasRadius ? RadiusFragments[EntityIdx].Radius : HalfRange;
+
+				// 分配紧凑存储的槽位
+				FCollisionSlotStore& SlotStore = HashGridSubsystem.SlotStore;
+				HashGridFragment.SlotIndex = SlotStore.Allocate(Context.GetEntity(EntityIdx));
+				SlotStore.SetLocation(HashGridFragment.SlotIndex, Location);
+				SlotStore.Radius[HashGridFragment.SlotIndex] = Radius;
+				SlotStore.MaxRadius = FMath::Max(SlotStore.MaxRadius, Radius);
 			}
 		});
 }
 
 
 /**
- * @brief 캯ʼײٴ
+ * @brief 构造函数，初始化碰撞销毁处理器
  * 
- * ù۲ʵΪFCollisionFragmentṹ壬ָΪƳ
- * ͬʱʼEntityQueryԱ
+ * 设置观察的实体类型为FCollisionFragment结构体，并指定操作为移除操作。
+ * 同时初始化EntityQuery成员变量。
  */
 UCollisionDestroyProcessor::UCollisionDestroyProcessor() :
 	EntityQuery(*this)
@@ -99,46 +165,57 @@ UCollisionDestroyProcessor::UCollisionDestroyProcessor() :
 }
 
 /**
- * @brief òѯ
+ * @brief 配置查询条件
  * 
- * @param EntityManager ʵĹãڹʵƬ
+ * @param EntityManager 实体管理器的共享引用，用于管理实体和片段
  * 
- * ΪEntityQueryFCollisionFragmentֻUCollisionSubsystemд
- * ȷִʱܹʵƬκϵͳ
+ * 为EntityQuery添加FCollisionFragment只读需求和UCollisionSubsystem读写需求，
+ * 确保在执行时能够访问到所需的片段和子系统。
  */
 void UCollisionDestroyProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
 	EntityQuery.AddRequirement<FCollisionFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FMassSpatialIndexFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
 	EntityQuery.AddSubsystemRequirement<UCollisionSubsystem>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddSubsystemRequirement<UMassSpatialIndexSubsystem>(EMassFragmentAccess::ReadWrite); // 清除睡眠留下的静止标记
 }
 
 /**
- * @brief ִײٴ߼
+ * @brief 执行碰撞销毁处理逻辑
  * 
- * @param EntityManager ʵãڹʵƬ
- * @param Context ִãṩִлݷʽӿ
+ * @param EntityManager 实体管理器引用，用于管理实体和片段
+ * @param Context 执行上下文引用，提供执行环境和数据访问接口
  * 
- * зʵ飬ӹϣƳʵײϢ
- * Ҫʵײϵͳеݡ
+ * 遍历所有符合条件的实体块，从邻居缓存中移除实体并归还碰撞槽位。
+ * 主要功能是清理被销毁实体在碰撞子系统中的相关数据。
  */
 void UCollisionDestroyProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
 {
 	EntityQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
 		{
-			// ȡײϵͳ
+			// 获取碰撞子系统引用
 			auto& HashGridSubsystem = Context.GetMutableSubsystemChecked<UCollisionSubsystem>();
 
-			// ȡǰײƬεͼ
+			// 获取当前块中所有碰撞片段的视图
 			const auto HashGridFragments = Context.GetFragmentView<FCollisionFragment>();
+			auto& SpatialIndex = Context.GetMutableSubsystemChecked<UMassSpatialIndexSubsystem>();
+			const auto IndexFragments = Context.GetFragmentView<FMassSpatialIndexFragment>();
 
-			// ǰеʵ
+			// 遍历当前块中的所有实体
 			const int32 NumEntities = Context.GetNumEntities();
 			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
 			{
 				auto& HashGridFragment = HashGridFragments[EntityIdx];
 
-				// ӹϣƳʵ弰λϢ
-				HashGridSubsystem.HashGridData.Remove(Context.GetEntity(EntityIdx), HashGridFragment.CellLocation);
+				// 从邻居缓存中移除实体，并归还槽位
+				HashGridSubsystem.ContactCache.Remove(HashGridFragment.SlotIndex);
+				HashGridSubsystem.SlotStore.Free(HashGridFragment.SlotIndex);
+
+				// 实体只离开碰撞、仍留在索引中时，索引要恢复每帧更新位置
+				if (IndexFragments.Num() > 0 && IndexFragments[EntityIdx].Slot != INDEX_NONE)
+				{
+					SpatialIndex.SetSlotResting(IndexFragments[EntityIdx].Slot, false);
+				}
 			}
 		});
 }
@@ -146,9 +223,9 @@ void UCollisionDestroyProcessor::Execute(FMassEntityManager& EntityManager, FMas
 
 
 /**
- * @brief 캯ʼײ
+ * @brief 构造函数，初始化碰撞处理器。
  *
- * ִ˳ Movement ֮ǰִУ Avoidance 顣
+ * 设置执行顺序：在 Movement 组之前执行，并属于 Avoidance 处理组，因此排在统一空间索引的更新之后。
  */
 UCollisionProcessor::UCollisionProcessor() :
 	EntityQuery(*this),
@@ -159,45 +236,86 @@ UCollisionProcessor::UCollisionProcessor() :
 }
 
 /**
- * @brief òѯԹʹá
+ * @brief 配置查询条件以供后续处理使用。
  *
- * @param EntityManager ʵãڷʵݡ
+ * @param EntityManager 实体管理器引用，用于访问实体数据。
  */
 void UCollisionProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
-	//  EntityQuery ѯƬκϵͳҪ
-	EntityQuery.AddRequirement<FCollisionFragment>(EMassFragmentAccess::ReadWrite);
+	// 配置 EntityQuery 查询所需的片段和子系统要求
+	EntityQuery.AddRequirement<FCollisionFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FMassSpatialIndexFragment>(EMassFragmentAccess::ReadOnly);
 	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery.AddRequirement<FMassVelocityFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
 	EntityQuery.AddSubsystemRequirement<UCollisionSubsystem>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddSubsystemRequirement<UMassSpatialIndexSubsystem>(EMassFragmentAccess::ReadWrite); // 快速移动的实体停下后移动索引中的条目
 
-	//  CollisionQuery ѯƬΡǩϵͳҪ
+	// 配置 CollisionQuery 查询所需的片段、标签及子系统要求
 	CollisionQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
 	CollisionQuery.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly);
-	CollisionQuery.AddSubsystemRequirement<UCollisionSubsystem>(EMassFragmentAccess::ReadOnly);
+	CollisionQuery.AddSubsystemRequirement<UCollisionSubsystem>(EMassFragmentAccess::ReadWrite); // 应用阶段写入各自的槽位
 	CollisionQuery.AddRequirement<FMassVelocityFragment>(EMassFragmentAccess::ReadWrite);
-	CollisionQuery.AddRequirement<FCollisionFragment>(EMassFragmentAccess::None); // ʵ
+	CollisionQuery.AddRequirement<FCollisionFragment>(EMassFragmentAccess::ReadOnly);
 	CollisionQuery.AddTagRequirement<FMassOffLODTag>(EMassFragmentPresence::None);
+
+	// 按模拟 LOD 的可变频率整块跳过：近处每帧求解，中远处按 LOD 设置的间隔求解
+	CollisionQuery.AddChunkRequirement<FMassSimulationVariableTickChunkFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	CollisionQuery.SetChunkFilter(&FMassSimulationVariableTickChunkFragment::ShouldTickChunkThisFrame);
 }
 
 /**
- * @brief ִײӦ߼
+ * @brief 执行碰撞检测与响应逻辑。
  *
- * ¹ϣеλϢԼʵ֮ײ⡣
+ * 邻居查询使用本帧已由 UMassSpatialIndexProcessor 更新的统一空间索引，碰撞不再维护自己的网格。
+ * 先并行把位置写入紧凑的槽位存储，并记录索引槽位到碰撞槽位的映射；一帧移动超过半径的实体分步扫过移动路径，
+ * 停在第一次明显嵌入其他实体之前，并把索引中的条目移到停下的位置；然后刷新跨帧的邻居缓存；
+ * 之后每轮迭代分两个阶段：
+ * 1. 并行地基于槽位存储计算每个实体的修正量，写入独立的修正缓冲区（只读位置，没有数据竞争）
+ * 2. 并行地把修正量应用到变换与槽位存储（每个实体只写自己的槽位）
+ * 最后一轮结束后把速度投影到碰撞法线平面上，并把第一轮收集到的接触发布到 UCollisionSubsystem::ContactEvents。
+ * 碰撞求解按模拟 LOD 的可变频率整块跳过，达到 BroadphaseOnlyLOD 的区块只做包围盒分离，但所有实体仍然留在索引中供近处的实体查询。
+ * 连续静止的实体进入睡眠：跳过槽位更新与查询，并在统一空间索引中标记为静止，索引每帧不再更新它们的位置；
+ * 阶段一中被运动实体压到的睡眠实体连同其接触分组一起唤醒，
+ * 并在应用前补算修正量。
  *
- * @param EntityManager ʵṩʵ弰ķʡ
- * @param Context ǰִģǰεݡ
+ * @param EntityManager 实体管理器，提供对所有实体及其组件的访问。
+ * @param Context 当前执行上下文，包含当前批次的数据。
  */
 void UCollisionProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
 {
-	// ÿʵڹϣеλ
-	EntityQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
+	UCollisionSubsystem& CollisionSubsystem = *EntityManager.GetWorld()->GetSubsystem<UCollisionSubsystem>();
+	UMassSpatialIndexSubsystem& SpatialIndex = *CollisionSubsystem.GetSpatialIndex();
+
+	// 并行写入槽位存储、索引槽位的映射并更新睡眠状态；每个实体只写自己的槽位
+	float MaxRadius = 0.f;
+	FastMoves.Reset();
+	IndexResyncs.Reset();
+	CollisionSubsystem.IndexToCollisionSlot.Init(INDEX_NONE, SpatialIndex.GetNumSlots());
+	EntityQuery.ParallelForEachEntityChunk(Context, [this, &MaxRadius](FMassExecutionContext& Context)
 		{
-			TRACE_CPUPROFILER_EVENT_SCOPE(UpdateCollisionHashGrid)
+			TRACE_CPUPROFILER_EVENT_SCOPE(UpdateCollisionCells)
 
 			auto& HashGridSubsystem = Context.GetMutableSubsystemChecked<UCollisionSubsystem>();
+			FCollisionSlotStore& SlotStore = HashGridSubsystem.SlotStore;
+			auto& IndexSubsystem = Context.GetMutableSubsystemChecked<UMassSpatialIndexSubsystem>();
 
 			const auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
-			const auto HashGridFragments = Context.GetMutableFragmentView<FCollisionFragment>();
+			const auto RadiusFragments = Context.GetFragmentView<FAgentRadiusFragment>();
+			const auto VelocityFragments = Context.GetFragmentView<FMassVelocityFragment>();
+			const auto HashGridFragments = Context.GetFragmentView<FCollisionFragment>();
+			const auto IndexFragments = Context.GetFragmentView<FMassSpatialIndexFragment>();
+			const bool bHasRadius = RadiusFragments.Num() > 0;
+			const bool bHasVelocity = VelocityFragments.Num() > 0;
+
+			// 本帧允许的最大静止位移
+			const float StillDistanceSq = FMath::Square(SleepSpeedThreshold * Context.GetDeltaTimeSeconds());
+			const float StillSpeedSq = FMath::Square(SleepSpeedThreshold);
+			const int32 FramesToSleep = FMath::Clamp(SleepFrames, 1, static_cast<int32>(MAX_uint16));
+
+			float ChunkMaxRadius = 0.f;
+			TArray<FCollisionFastMove> ChunkFastMoves;
+			TArray<TPair<int32, FVector>> ChunkIndexResyncs;
 
 			const int32 NumEntities = Context.GetNumEntities();
 			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
@@ -205,98 +323,423 @@ void UCollisionProcessor::Execute(FMassEntityManager& EntityManager, FMassExecut
 				auto& HashGridFragment = HashGridFragments[EntityIdx];
 				auto& TransformFragment = TransformFragments[EntityIdx];
 				const auto& Location = TransformFragment.GetTransform().GetLocation();
-
-				// Χвƶµĸ
-				FBox Bounds = { Location - HalfRange, Location + HalfRange };
-				auto NewCellLocation = HashGridSubsystem.HashGridData.Move(
-					Context.GetEntity(EntityIdx),
-					HashGridFragment.CellLocation,
-					Bounds
-				);
-				HashGridFragment.CellLocation = NewCellLocation;
+				const int32 Slot = HashGridFragment.SlotIndex;
+				const int32 IndexSlot = IndexFragments[EntityIdx].Slot;
+				const float Radius = bHasRadius ? RadiusFragments[EntityIdx].Radius : HalfRange;
+				ChunkMaxRadius = FMath::Max(ChunkMaxRadius, Radius);
+
+				// 索引槽位各不相同，每个实体只写自己的映射
+				if (IndexSlot != INDEX_NONE)
+				{
+					HashGridSubsystem.IndexToCollisionSlot[IndexSlot] = Slot;
+				}
+
+				// 与上一帧求解后的位置比较，位移与速度都很小时累计静止帧数
+				const FVector3f Displacement = FVector3f(Location) - FVector3f(SlotStore.X[Slot], SlotStore.Y[Slot], SlotStore.Z[Slot]);
+				const bool bStill = Displacement.SizeSquared() <= StillDistanceSq
+					&& (!bHasVelocity || VelocityFragments[EntityIdx].Value.SizeSquared() <= StillSpeedSq);
+				if (bEnableSleep && bStill)
+				{
+					SlotStore.StillFrames[Slot] = static_cast<uint16>(FMath::Min(SlotStore.StillFrames[Slot] + 1, FramesToSleep));
+					SlotStore.Sleeping[Slot] = SlotStore.StillFrames[Slot] >= FramesToSleep;
+				}
+				else
+				{
+					SlotStore.Wake(Slot);
+				}
+
+				// 睡眠的实体在索引中标记为静止，索引每帧跳过它的位置更新；本帧醒来的实体要补上索引跳过的这次移动
+				if (IndexSlot != INDEX_NONE)
+				{
+					if (IndexSubsystem.IsSlotResting(IndexSlot) && !SlotStore.IsSleeping(Slot))
+					{
+						ChunkIndexResyncs.Emplace(IndexSlot, Location);
+					}
+					IndexSubsystem.SetSlotResting(IndexSlot, SlotStore.IsSleeping(Slot));
+				}
+
+				// 睡眠中的实体几乎没有移动，保留原来的槽位位置
+				if (SlotStore.IsSleeping(Slot))
+				{
+					continue;
+				}
+
+				// 位移超过半径的实体可能穿过人群，记录起止位置之后分步扫过
+				if (bEnableSubsteps && Displacement.SizeSquared() > FMath::Square(Radius * SubstepThreshold))
+				{
+					ChunkFastMoves.Add({ Slot, IndexSlot, FVector3f(SlotStore.X[Slot], SlotStore.Y[Slot], SlotStore.Z[Slot]), FVector3f(Location) });
+				}
+
+				SlotStore.SetLocation(Slot, Location);
+				SlotStore.Radius[Slot] = Radius;
 			}
+
+			FScopeLock Lock(&FastMovesLock);
+			MaxRadius = FMath::Max(MaxRadius, ChunkMaxRadius);
+			FastMoves.Append(ChunkFastMoves);
+			IndexResyncs.Append(ChunkIndexResyncs);
 		});
 
-	// Ⲣʵײ
-	CollisionQuery.ParallelForEachEntityChunk(Context, [this, &EntityManager](FMassExecutionContext& Context)
+	FCollisionSlotStore& SlotStore = CollisionSubsystem.SlotStore;
+	SlotStore.MaxRadius = MaxRadius;
+
+	// 按索引槽位排序后移动，格子内的元素顺序与线程调度无关
+	if (IndexResyncs.Num() > 0)
+	{
+		IndexResyncs.Sort([](const TPair<int32, FVector>& A, const TPair<int32, FVector>& B) { return A.Key < B.Key; });
+		for (const TPair<int32, FVector>& Resync : IndexResyncs)
 		{
-			const auto& HashGridSubsystem = Context.GetSubsystemChecked<UCollisionSubsystem>();
+			SpatialIndex.MoveSlot(Resync.Key, Resync.Value);
+		}
+	}
 
-			const auto TransformFragments = Context.GetMutableFragmentView<FTransformFragment>();
-			const auto RadiusFragments = Context.GetFragmentView<FAgentRadiusFragment>();
-			const auto VelocityFragments = Context.GetMutableFragmentView<FMassVelocityFragment>();
+	// 快速移动的实体：并行扫过移动路径，再在单线程中把停下的位置写回变换、槽位与空间索引
+	if (FastMoves.Num() > 0)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(SubstepFastCollisions)
 
-			const int32 NumEntities = Context.GetNumEntities();
-			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+		// 按槽位排序，之后移动索引条目的顺序与线程调度无关
+		FastMoves.Sort([](const FCollisionFastMove& A, const FCollisionFastMove& B) { return A.Slot < B.Slot; });
+
+		TArray<FVector3f> StopLocations;
+		StopLocations.SetNumUninitialized(FastMoves.Num());
+		ParallelFor(FastMoves.Num(), [this, &CollisionSubsystem, &StopLocations](const int32 Index)
 			{
-				auto& TransformFragment = TransformFragments[EntityIdx];
-				const auto& RadiusFragment = RadiusFragments[EntityIdx];
-				auto& Velocity = VelocityFragments[EntityIdx];
+				const FCollisionFastMove& Move = FastMoves[Index];
+				StopLocations[Index] = CollisionSubsystem.SweepToFirstContact(Move.Slot, Move.Start, Move.End, SubstepMaxSteps);
+			});
+
+		for (int32 Index = 0; Index < FastMoves.Num(); Index++)
+		{
+			const FCollisionFastMove& Move = FastMoves[Index];
+			const FVector3f& StopLocation = StopLocations[Index];
+			if (StopLocation == Move.End)
+			{
+				continue;
+			}
+
+			const FMassEntityHandle Entity = SlotStore.Entities[Move.Slot];
+			FTransform& Transform = EntityManager.GetFragmentDataChecked<FTransformFragment>(Entity).GetMutableTransform();
+
+			Transform.SetLocation(FVector(StopLocation));
+			SlotStore.SetLocation(Move.Slot, FVector(StopLocation));
+			if (Move.IndexSlot != INDEX_NONE)
+			{
+				SpatialIndex.MoveSlot(Move.IndexSlot, FVector(StopLocation));
+			}
+		}
+	}
+
+	const bool bContactCacheActive = bUseContactCache;
+	if (bContactCacheActive)
+	{
+		CollisionSubsystem.ContactCache.Refresh(CollisionSubsystem, FMath::Max(ContactCacheMargin, 0.f));
+	}
+	Corrections.SetNumUninitialized(SlotStore.Num());
+	HitNormals.Reset();
+	HitNormals.SetNumZeroed(SlotStore.Num());
+	SlotSolveModes.Reset();
+	SlotSolveModes.SetNumZeroed(SlotStore.Num());
+
+	PendingContacts.Reset();
+
+	const int32 NumIterations = FMath::Max(SolverIterations, 1);
+	for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+	{
+		// 第一轮迭代时顺带收集接触事件，反映本帧移动后、推开前的重叠
+		const bool bGatherContacts = bPublishContactEvents && Iteration == 0;
+
+		// 阶段一：基于槽位存储计算修正量
+		CollisionQuery.ParallelForEachEntityChunk(Context, [this, bContactCacheActive, bGatherContacts](FMassExecutionContext& Context)
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE(ComputeCollisionCorrections)
 
-				const auto Radius = RadiusFragment.Radius;
-				auto& Transform = TransformFragment.GetMutableTransform();
+				const auto& HashGridSubsystem = Context.GetSubsystemChecked<UCollisionSubsystem>();
+				const FCollisionSlotStore& SlotStore = HashGridSubsystem.SlotStore;
+				const auto HashGridFragments = Context.GetFragmentView<FCollisionFragment>();
 
-				// ѯཻʵ
-				FBox Bounds = {
-					Transform.GetLocation() - HalfRange / 2,
-					Transform.GetLocation() + HalfRange / 2
-				};
+				TArray<int32> Scratch;
+				TArray<int32> ChunkWakeSeeds;
+				TArray<FCollisionContact> ChunkContacts;
 
-				TArray<FMassEntityHandle> Entities;
-				HashGridSubsystem.HashGridData.QuerySmall(Bounds, Entities);
+				// 远处的区块只做包围盒分离；没有模拟 LOD 区块片段的实体不参与 LOD，按近处处理
+				const FMassSimulationVariableTickChunkFragment* LODChunkFragment = Context.GetChunkFragmentPtr<FMassSimulationVariableTickChunkFragment>();
+				const bool bBroadphaseOnly = LODChunkFragment && LODChunkFragment->GetLOD() >= BroadphaseOnlyLOD;
 
-				// ˵
-				Entities = Entities.FilterByPredicate([&Context, EntityIdx](const FMassEntityHandle& OtherEntity)
+				const int32 NumEntities = Context.GetNumEntities();
+				for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+				{
+					const int32 Slot = HashGridFragments[EntityIdx].SlotIndex;
+					SlotSolveModes[Slot] = bBroadphaseOnly ? ESolveMode::Broadphase : ESolveMode::Narrowphase;
+
+					// 睡眠中的实体不作为查询源，由接触它的运动实体负责唤醒
+					if (SlotStore.IsSleeping(Slot))
+					{
+						Corrections[Slot] = FVector3f::ZeroVector;
+						continue;
+					}
+
+					const TConstArrayView<int32> Neighbors = HashGridSubsystem.QueryNeighbors(Slot, bContactCacheActive, Scratch);
+					int32 NumOverlaps = 0;
+					Corrections[Slot] = bBroadphaseOnly
+						? SlotStore.ResolveOverlapsBroadphase(Slot, Neighbors, HitNormals[Slot], &NumOverlaps)
+						: SlotStore.ResolveOverlaps(Slot, Neighbors, HitNormals[Slot], &NumOverlaps);
+
+					// 以是否有重叠的邻居为准：对称挤压或完全重合时修正量互相抵消为零，但接触仍然存在
+					if (bGatherContacts && !bBroadphaseOnly && NumOverlaps > 0)
+					{
+						SlotStore.GatherContacts(Slot, Neighbors, true, ChunkContacts);
+					}
+
+					// 缓存的候选邻居是完整查询结果的超集，两者的修正量只应有求和顺序带来的误差；法线取最深的接触，与邻居顺序无关，应当相同。
+					// 完整查询没有重叠时法线保持不变，因此以缓存的结果为初值
+					if (bContactCacheActive && bValidateContactCache && !bBroadphaseOnly)
 					{
-						return OtherEntity != Context.GetEntity(EntityIdx);
-					});
+						TArray<int32> FullScratch;
+						FVector3f FullHitNormal = HitNormals[Slot];
+						const FVector3f FullCorrection = SlotStore.ResolveOverlaps(Slot, HashGridSubsystem.QueryNeighbors(Slot, false, FullScratch), FullHitNormal);
+						ensureMsgf(FullCorrection.Equals(Corrections[Slot], 1.e-3f) && FullHitNormal.Equals(HitNormals[Slot], 1.e-4f),
+							TEXT("Contact cache mismatch on slot %d: cached %s / %s, full query %s / %s"),
+							Slot, *Corrections[Slot].ToString(), *HitNormals[Slot].ToString(), *FullCorrection.ToString(), *FullHitNormal.ToString());
+					}
+
+					// 记录被自己压到的睡眠邻居
+					if (NumOverlaps > 0)
+					{
+						for (const int32 Other : Neighbors)
+						{
+							if (SlotStore.IsSleeping(Other) && SlotStore.AreTouching(Slot, Other))
+							{
+								ChunkWakeSeeds.Add(Other);
+							}
+						}
+					}
+				}
+
+				if (ChunkWakeSeeds.Num() > 0)
+				{
+					FScopeLock Lock(&WakeSeedsLock);
+					WakeSeeds.Append(ChunkWakeSeeds);
+				}
+
+				if (ChunkContacts.Num() > 0)
+				{
+					FScopeLock Lock(&PendingContactsLock);
+					PendingContacts.Append(ChunkContacts);
+				}
+			});
+
+		// 唤醒被接触的睡眠分组，并为它们补算本轮的修正量
+		if (WakeSeeds.Num() > 0)
+		{
+			WokenSlots.Reset();
+			CollisionSubsystem.WakeIslands(WakeSeeds, SleepContactMargin, WokenSlots);
+			WakeSeeds.Reset();
 
-				// ײٶͶӰƽ
-				FVector HitNormal = ResolveCollisions(Entities, EntityManager, Radius, Transform);
-				Velocity.Value = FVector::VectorPlaneProject(Velocity.Value, HitNormal);
+			// 被唤醒的实体随后会被推开，下一帧起恢复索引的位置更新；此时它们仍在睡眠时的位置，索引不需要移动
+			for (const int32 Slot : WokenSlots)
+			{
+				if (const FMassSpatialIndexFragment* IndexFragment = EntityManager.GetFragmentDataPtr<FMassSpatialIndexFragment>(SlotStore.Entities[Slot]))
+				{
+					if (IndexFragment->Slot != INDEX_NONE)
+					{
+						SpatialIndex.SetSlotResting(IndexFragment->Slot, false);
+					}
+				}
 			}
-		});
+
+			ParallelFor(WokenSlots.Num(), [this, &CollisionSubsystem, bContactCacheActive, bGatherContacts](const int32 Index)
+				{
+					// 所在区块本帧被 LOD 跳过的槽位不会在阶段二应用修正量，等区块下次求解时再计算
+					const int32 Slot = WokenSlots[Index];
+					const ESolveMode SolveMode = SlotSolveModes[Slot];
+					if (SolveMode == ESolveMode::Skipped)
+					{
+						return;
+					}
+
+					TArray<int32> Scratch;
+					const TConstArrayView<int32> Neighbors = CollisionSubsystem.QueryNeighbors(Slot, bContactCacheActive, Scratch);
+					int32 NumOverlaps = 0;
+					const FCollisionSlotStore& SlotStore = CollisionSubsystem.SlotStore;
+					Corrections[Slot] = SolveMode == ESolveMode::Broadphase
+						? SlotStore.ResolveOverlapsBroadphase(Slot, Neighbors, HitNormals[Slot], &NumOverlaps)
+						: SlotStore.ResolveOverlaps(Slot, Neighbors, HitNormals[Slot], &NumOverlaps);
+
+					// 被唤醒的槽位与运动实体的接触可能已经收集过，发布时去重
+					if (bGatherContacts && SolveMode == ESolveMode::Narrowphase && NumOverlaps > 0)
+					{
+						TArray<FCollisionContact> WokenContacts;
+						SlotStore.GatherContacts(Slot, Neighbors, false, WokenContacts);
+
+						FScopeLock Lock(&PendingContactsLock);
+						PendingContacts.Append(WokenContacts);
+					}
+				});
+		}
+
+		// 阶段二：应用修正量，最后一轮把速度投影到法线平面上
+		const bool bLastIteration = Iteration == NumIterations - 1;
+		CollisionQuery.ParallelForEachEntityChunk(Context, [this, bLastIteration](FMassExecutionContext& Context)
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE(ApplyCollisionCorrections)
+
+				FCollisionSlotStore& SlotStore = Context.GetMutableSubsystemChecked<UCollisionSubsystem>().SlotStore;
+				const auto HashGridFragments = Context.GetFragmentView<FCollisionFragment>();
+				const auto TransformFragments = Context.GetMutableFragmentView<FTransformFragment>();
+				const auto VelocityFragments = Context.GetMutableFragmentView<FMassVelocityFragment>();
+
+				const int32 NumEntities = Context.GetNumEntities();
+				for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+				{
+					const int32 Slot = HashGridFragments[EntityIdx].SlotIndex;
+					if (SlotStore.IsSleeping(Slot))
+					{
+						continue;
+					}
+
+					const FVector3f& Correction = Corrections[Slot];
+
+					SlotStore.X[Slot] += Correction.X;
+					SlotStore.Y[Slot] += Correction.Y;
+					SlotStore.Z[Slot] += Correction.Z;
+
+					FTransform& Transform = TransformFragments[EntityIdx].GetMutableTransform();
+					Transform.SetLocation(Transform.GetLocation() + FVector(Correction));
+
+					if (bLastIteration)
+					{
+						auto& Velocity = VelocityFragments[EntityIdx];
+						Velocity.Value = FVector::VectorPlaneProject(Velocity.Value, FVector(HitNormals[Slot]));
+					}
+				}
+			});
+	}
+
+	// 发布本帧的接触事件，关闭时发布空列表，避免消费者读到过期数据
+	CollisionSubsystem.ContactEvents.Publish(MoveTemp(PendingContacts));
 }
 
+
 /**
- * @brief ݸһʵײӦص֡
+ * @brief 构造函数，初始化静态场景碰撞处理器。
  *
- * @param Entities ܷײʵб
- * @param EntityManager ʵڻȡʵλõϢ
- * @param Radius ǰʵ뾶
- * @param EntityTransform ǰʵ任Ϣ޸ģ
- * @return ײĵλ
+ * 在智能体之间的碰撞之后、Movement 组之前执行，属于 Avoidance 处理组。
  */
-FVector UCollisionProcessor::ResolveCollisions(
-	const TArray<FMassEntityHandle>& Entities,
-	FMassEntityManager& EntityManager,
-	float Radius,
-	FTransform& EntityTransform)
+UCollisionSDFProcessor::UCollisionSDFProcessor() :
+	EntityQuery(*this)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(CalculateCollision)
+	ExecutionOrder.ExecuteBefore.Add(UE::Mass::ProcessorGroupNames::Movement);
+	ExecutionOrder.ExecuteAfter.Add(UCollisionProcessor::StaticClass()->GetFName());
+	ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::Avoidance;
+}
 
-	FVector HitNormal(FVector::ZeroVector);
+/**
+ * @brief 配置查询条件。
+ *
+ * @param EntityManager 实体管理器引用。
+ */
+void UCollisionSDFProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery.AddRequirement<FMassVelocityFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FCollisionFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddTagRequirement<FMassOffLODTag>(EMassFragmentPresence::None);
+	EntityQuery.AddSubsystemRequirement<UCollisionSDFSubsystem>(EMassFragmentAccess::ReadWrite); // 采样结束后请求缺失的瓦片
+	EntityQuery.AddSubsystemRequirement<UCollisionSubsystem>(EMassFragmentAccess::ReadWrite); // 推出后同步槽位存储
+}
 
-	for (auto& Entity : Entities)
+/**
+ * @brief 把嵌入静态几何体的智能体沿距离场梯度推出。
+ *
+ * 采样距离小于半径时沿梯度方向推出穿透的部分，并去掉速度中指向障碍物的分量；推出后的位置同时写入碰撞槽位存储，
+ * 使接触事件与下一帧的邻居缓存看到的是推出后的位置，被推动的睡眠实体会被唤醒。
+ * 采样时所在瓦片尚未读入的实体本帧不处理，瓦片连同周围一圈由 UCollisionSDFSubsystem 在工作线程上读入。
+ *
+ * @param EntityManager 实体管理器。
+ * @param Context 当前执行上下文。
+ */
+void UCollisionSDFProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	UCollisionSDFSubsystem* SDFSubsystem = EntityManager.GetWorld()->GetSubsystem<UCollisionSDFSubsystem>();
+	if (!UCollisionSDFSubsystem::IsEnabled() || !SDFSubsystem || !SDFSubsystem->HasField())
 	{
-		auto OtherEntityTransform = EntityManager.GetFragmentDataPtr<FTransformFragment>(Entity);
-		auto OtherLocation = OtherEntityTransform->GetTransform().GetLocation();
-		auto DistSq = FVector::DistSquared(EntityTransform.GetLocation(), OtherLocation);
+		return;
+	}
 
-		// С뾶Ϊص
-		if (DistSq < FMath::Square(Radius * 2))
+	MissingTiles.Reset();
+	EntityQuery.ParallelForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
 		{
-			auto Direction = (EntityTransform.GetLocation() - OtherLocation).GetSafeNormal();
-			Direction.Z = 0.f;
+			TRACE_CPUPROFILER_EVENT_SCOPE(ResolveStaticCollisions)
 
-			auto Radii = Radius * 2;
-			auto Depth = Radii - FMath::Sqrt(DistSq) + 0.01f;
+			const UCollisionSDFSubsystem& SDFSubsystem = Context.GetSubsystemChecked<UCollisionSDFSubsystem>();
+			FCollisionSlotStore& SlotStore = Context.GetMutableSubsystemChecked<UCollisionSubsystem>().SlotStore;
+			const auto CollisionFragments = Context.GetFragmentView<FCollisionFragment>();
+			const auto RadiusFragments = Context.GetFragmentView<FAgentRadiusFragment>();
+			const auto TransformFragments = Context.GetMutableFragmentView<FTransformFragment>();
+			const auto VelocityFragments = Context.GetMutableFragmentView<FMassVelocityFragment>();
+			const bool bHasRadius = RadiusFragments.Num() > 0;
 
-			// ǰλط뷽ƫһ
-			EntityTransform.SetLocation(EntityTransform.GetLocation() + Depth / 2 * Direction);
-			HitNormal = Direction;
-		}
-	}
+			TArray<int32> ChunkMissingTiles;
+
+			const int32 NumEntities = Context.GetNumEntities();
+			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+			{
+				FTransform& Transform = TransformFragments[EntityIdx].GetMutableTransform();
+				const FVector Location = Transform.GetLocation();
+
+				UCollisionSDFSubsystem::FSample Sample;
+				int32 MissingTile = INDEX_NONE;
+				const bool bHasSample = SDFSubsystem.Sample(Location, Sample, MissingTile);
+				if (MissingTile != INDEX_NONE)
+				{
+					ChunkMissingTiles.AddUnique(MissingTile);
+				}
+
+				const float Radius = bHasRadius ? RadiusFragments[EntityIdx].Radius : HalfRange;
+				const float Penetration = Radius - Sample.Distance;
+				if (!bHasSample || Penetration <= 0.f)
+				{
+					continue;
+				}
+
+				const FVector2f Normal = Sample.Gradient.GetSafeNormal();
+				if (Normal.IsZero())
+				{
+					continue;
+				}
+
+				// 沿梯度推出穿透部分，每个实体只写自己的槽位
+				const FVector Normal3D(Normal.X, Normal.Y, 0.f);
+				const FVector PushedLocation = Location + Normal3D * Penetration;
+				Transform.SetLocation(PushedLocation);
+
+				const int32 Slot = CollisionFragments[EntityIdx].SlotIndex;
+				if (SlotStore.Entities.IsValidIndex(Slot))
+				{
+					SlotStore.SetLocation(Slot, PushedLocation);
+					SlotStore.Wake(Slot);
+				}
+
+				// 去掉速度中指向障碍物的分量
+				FVector& Velocity = VelocityFragments[EntityIdx].Value;
+				const double IntoWall = FVector::DotProduct(Velocity, Normal3D);
+				if (IntoWall < 0.)
+				{
+					Velocity -= IntoWall * Normal3D;
+				}
+			}
 
-	return HitNormal;
-}
\ No newline at end of file
+			if (ChunkMissingTiles.Num() > 0)
+			{
+				FScopeLock Lock(&MissingTilesLock);
+				MissingTiles.Append(ChunkMissingTiles);
+			}
+		});
+
+	if (MissingTiles.Num() > 0)
+	{
+		SDFSubsystem->StreamIn(MissingTiles);
+	}
+}
@@ -0,0 +1,655 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "CollisionSDFSubsystem.h"
+
+#include "CollisionShape.h"
+#include "Engine/EngineTypes.h"
+#include "Engine/LevelBounds.h"
+#include "Engine/World.h"
+#include "HAL/FileManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/Paths.h"
+
+//是否启用静态场景距离场
+static bool bSDFEnable = true;
+static FAutoConsoleVariableRef CVarSDFEnable(TEXT("MassEntityCollision.SDF.Enable"), bSDFEnable, TEXT("是否让智能体与静态场景的距离场碰撞"));
+
+//加载地图时找不到烘焙文件是否立即烘焙
+static bool bSDFBakeOnLoad = false;
+static FAutoConsoleVariableRef CVarSDFBakeOnLoad(TEXT("MassEntityCollision.SDF.BakeOnLoad"), bSDFBakeOnLoad, TEXT("加载地图时找不到烘焙文件是否立即烘焙"));
+
+//分帧烘焙时每帧最多的重叠测试次数
+static int32 SDFBakeProbeBudget = 4096;
+static FAutoConsoleVariableRef CVarSDFBakeProbeBudget(TEXT("MassEntityCollision.SDF.BakeProbeBudget"), SDFBakeProbeBudget, TEXT("加载地图时分帧烘焙，每帧最多的重叠测试次数"));
+
+//默认的格子边长
+static float SDFCellSize = 25.f;
+static FAutoConsoleVariableRef CVarSDFCellSize(TEXT("MassEntityCollision.SDF.CellSize"), SDFCellSize, TEXT("距离场的格子边长"));
+
+//瓦片边长（格子数）
+static int32 SDFTileCells = 32;
+static FAutoConsoleVariableRef CVarSDFTileCells(TEXT("MassEntityCollision.SDF.TileCells"), SDFTileCells, TEXT("距离场瓦片的边长（格子数）"));
+
+//烘焙时重叠测试的中心高度与半高，只有这一高度范围内的几何体算作障碍物，避免把地面烘焙进去
+static float SDFBakeZ = 100.f;
+static FAutoConsoleVariableRef CVarSDFBakeZ(TEXT("MassEntityCollision.SDF.BakeZ"), SDFBakeZ, TEXT("烘焙时重叠测试的中心高度"));
+
+static float SDFBakeHalfHeight = 50.f;
+static FAutoConsoleVariableRef CVarSDFBakeHalfHeight(TEXT("MassEntityCollision.SDF.BakeHalfHeight"), SDFBakeHalfHeight, TEXT("烘焙时重叠测试的半高"));
+
+//烘焙使用的碰撞通道
+static int32 SDFBakeChannel = ECC_WorldStatic;
+static FAutoConsoleVariableRef CVarSDFBakeChannel(TEXT("MassEntityCollision.SDF.BakeChannel"), SDFBakeChannel, TEXT("烘焙时重叠测试使用的碰撞通道"));
+
+namespace UE::MassEntityCollision::SDF
+{
+	//文件标识 'MSDF' 与版本
+	static constexpr uint32 FileMagic = 0x4653444D;
+	static constexpr int32 FileVersion = 1;
+
+	/**
+	 * 两遍扫描的距离变换（8SSEDT），每个格子记录到最近种子格子的偏移
+	 * @param Occupied 每个格子是否被障碍物占据
+	 * @param SeedValue 作为种子的 Occupied 值：1 求到障碍物的距离，0 求到空地的距离
+	 * @param NumX 横向格子数
+	 * @param NumY 纵向格子数
+	 * @param CellSize 格子边长
+	 * @param OutDistance 输出格子中心到最近种子格子中心的距离
+	 */
+	static void ComputeDistanceTransform(TConstArrayView<uint8> Occupied, const uint8 SeedValue, const int32 NumX, const int32 NumY,
+		const float CellSize, TArray<float>& OutDistance)
+	{
+		constexpr int32 Far = 1 << 14;
+
+		TArray<FIntPoint> Offsets;
+		Offsets.Init(FIntPoint(Far, Far), NumX * NumY);
+		for (int32 Index = 0; Index < Offsets.Num(); Index++)
+		{
+			if (Occupied[Index] == SeedValue)
+			{
+				Offsets[Index] = FIntPoint::ZeroValue;
+			}
+		}
+
+		auto Compare = [&Offsets, NumX, NumY](const int32 X, const int32 Y, const int32 DX, const int32 DY)
+		{
+			const int32 OtherX = X + DX;
+			const int32 OtherY = Y + DY;
+			if (OtherX < 0 || OtherY < 0 || OtherX >= NumX || OtherY >= NumY)
+			{
+				return;
+			}
+
+			const FIntPoint Candidate = Offsets[OtherY * NumX + OtherX] + FIntPoint(DX, DY);
+			FIntPoint& Current = Offsets[Y * NumX + X];
+			if (Candidate.SizeSquared() < Current.SizeSquared())
+			{
+				Current = Candidate;
+			}
+		};
+
+		// 从上到下
+		for (int32 Y = 0; Y < NumY; Y++)
+		{
+			for (int32 X = 0; X < NumX; X++)
+			{
+				Compare(X, Y, -1, 0);
+				Compare(X, Y, 0, -1);
+				Compare(X, Y, -1, -1);
+				Compare(X, Y, 1, -1);
+			}
+			for (int32 X = NumX - 1; X >= 0; X--)
+			{
+				Compare(X, Y, 1, 0);
+			}
+		}
+
+		// 从下到上
+		for (int32 Y = NumY - 1; Y >= 0; Y--)
+		{
+			for (int32 X = NumX - 1; X >= 0; X--)
+			{
+				Compare(X, Y, 1, 0);
+				Compare(X, Y, 0, 1);
+				Compare(X, Y, -1, 1);
+				Compare(X, Y, 1, 1);
+			}
+			for (int32 X = 0; X < NumX; X++)
+			{
+				Compare(X, Y, -1, 0);
+			}
+		}
+
+		OutDistance.SetNumUninitialized(Offsets.Num());
+		for (int32 Index = 0; Index < Offsets.Num(); Index++)
+		{
+			OutDistance[Index] = FMath::Sqrt(static_cast<float>(Offsets[Index].SizeSquared())) * CellSize;
+		}
+	}
+}
+
+/**
+ * 在当前帧内完成整个烘焙
+ * @param Bounds 烘焙范围
+ * @param InCellSize 格子边长
+ * @return 没有可用的物理场景或写文件失败时返回false
+ */
+bool UCollisionSDFSubsystem::Bake(const FBox& Bounds, const float InCellSize)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(BakeCollisionSDF)
+
+	if (!BeginBake(Bounds, InCellSize))
+	{
+		return false;
+	}
+
+	const TUniquePtr<FBakeJob> Job = MoveTemp(BakeJob);
+	ProbeCells(*Job, MAX_int32);
+	return FinishBake(*Job);
+}
+
+/**
+ * 准备烘焙范围与格子，替换正在进行的烘焙
+ * @param Bounds 烘焙范围
+ * @param InCellSize 格子边长
+ * @return 没有可用的物理场景时返回false
+ */
+bool UCollisionSDFSubsystem::BeginBake(const FBox& Bounds, const float InCellSize)
+{
+	UWorld* World = GetWorld();
+	if (!World || !World->GetPhysicsScene() || !Bounds.IsValid)
+	{
+		return false;
+	}
+
+	BakeJob = MakeUnique<FBakeJob>();
+	FBakeJob& Job = *BakeJob;
+	Job.CellSize = FMath::Max(InCellSize, 1.f);
+	Job.TileCells = FMath::Clamp(SDFTileCells, 4, 256);
+	const float TileSize = Job.CellSize * Job.TileCells;
+	Job.Origin = FVector2f(Bounds.Min.X, Bounds.Min.Y);
+	Job.NumTilesX = FMath::Max(1, FMath::CeilToInt32((Bounds.Max.X - Bounds.Min.X) / TileSize));
+	Job.NumTilesY = FMath::Max(1, FMath::CeilToInt32((Bounds.Max.Y - Bounds.Min.Y) / TileSize));
+	Job.NumCellsX = Job.NumTilesX * Job.TileCells;
+	Job.NumCellsY = Job.NumTilesY * Job.TileCells;
+	Job.Occupied.SetNumZeroed(Job.NumCellsX * Job.NumCellsY);
+	return true;
+}
+
+/**
+ * 逐格测试是否与静态几何体重叠，从上次停下的格子继续
+ * @param Job 烘焙状态
+ * @param MaxProbes 本次最多的测试次数
+ * @return 所有格子都测试完时返回true
+ */
+bool UCollisionSDFSubsystem::ProbeCells(FBakeJob& Job, const int32 MaxProbes) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(ProbeCollisionSDF)
+
+	const UWorld* World = GetWorld();
+	const FCollisionShape Shape = FCollisionShape::MakeBox(FVector(Job.CellSize * 0.5f, Job.CellSize * 0.5f, SDFBakeHalfHeight));
+	const ECollisionChannel Channel = static_cast<ECollisionChannel>(SDFBakeChannel);
+
+	const int32 NumCells = Job.Occupied.Num();
+	const int32 EndCell = static_cast<int32>(FMath::Min<int64>(static_cast<int64>(Job.NextCell) + FMath::Max(MaxProbes, 1), NumCells));
+	for (int32 Cell = Job.NextCell; Cell < EndCell; Cell++)
+	{
+		const int32 X = Cell % Job.NumCellsX;
+		const int32 Y = Cell / Job.NumCellsX;
+		const FVector Center(Job.Origin.X + (X + 0.5f) * Job.CellSize, Job.Origin.Y + (Y + 0.5f) * Job.CellSize, SDFBakeZ);
+		Job.Occupied[Cell] = World->OverlapBlockingTestByChannel(Center, FQuat::Identity, Channel, Shape) ? 1 : 0;
+	}
+	Job.NextCell = EndCell;
+
+	return Job.NextCell >= NumCells;
+}
+
+/**
+ * 由占据情况用两次距离变换得到有符号距离，切分为瓦片并写入文件
+ * @param Job 已测试完所有格子的烘焙状态
+ * @return 写文件失败时返回false
+ */
+bool UCollisionSDFSubsystem::FinishBake(const FBakeJob& Job)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FinishCollisionSDF)
+
+	CancelStreaming();
+	TileReader.Reset();
+
+	Origin = Job.Origin;
+	CellSize = Job.CellSize;
+	TileCells = Job.TileCells;
+	NumTilesX = Job.NumTilesX;
+	NumTilesY = Job.NumTilesY;
+	MaxDistance = FMath::Min(CellSize * TileCells, static_cast<float>(MAX_int16));
+
+	const int32 NumCellsX = Job.NumCellsX;
+	const int32 NumCellsY = Job.NumCellsY;
+	const TArray<uint8>& Occupied = Job.Occupied;
+
+	// 外部为到障碍物的距离，内部为到空地距离的相反数，两者都从格子中心换算到表面
+	TArray<float> Outside;
+	TArray<float> Inside;
+	UE::MassEntityCollision::SDF::ComputeDistanceTransform(Occupied, 1, NumCellsX, NumCellsY, CellSize, Outside);
+	UE::MassEntityCollision::SDF::ComputeDistanceTransform(Occupied, 0, NumCellsX, NumCellsY, CellSize, Inside);
+
+	// 切分为瓦片，整块都远离障碍物的瓦片不存储
+	Tiles.Reset();
+	Tiles.SetNum(NumTilesX * NumTilesY);
+	int32 NumResident = 0;
+	for (int32 TileY = 0; TileY < NumTilesY; TileY++)
+	{
+		for (int32 TileX = 0; TileX < NumTilesX; TileX++)
+		{
+			FTile& Tile = Tiles[TileY * NumTilesX + TileX];
+			Tile.Distances.SetNumUninitialized(TileCells * TileCells);
+
+			bool bAnyNear = false;
+			for (int32 LocalY = 0; LocalY < TileCells; LocalY++)
+			{
+				for (int32 LocalX = 0; LocalX < TileCells; LocalX++)
+				{
+					const int32 Cell = (TileY * TileCells + LocalY) * NumCellsX + TileX * TileCells + LocalX;
+					const float Distance = Occupied[Cell] ? -(Inside[Cell] - CellSize * 0.5f) : Outside[Cell] - CellSize * 0.5f;
+					const float Clamped = FMath::Clamp(Distance, -MaxDistance, MaxDistance);
+					Tile.Distances[LocalY * TileCells + LocalX] = static_cast<int16>(FMath::RoundToInt32(Clamped));
+					bAnyNear |= Clamped < MaxDistance;
+				}
+			}
+
+			if (bAnyNear)
+			{
+				Tile.State = ETileState::Resident;
+				NumResident++;
+			}
+			else
+			{
+				Tile.Distances.Empty();
+				Tile.State = ETileState::Empty;
+			}
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("MassEntityCollision SDF baked: %d x %d cells, %d / %d tiles stored"),
+		NumCellsX, NumCellsY, NumResident, Tiles.Num());
+
+	return Save();
+}
+
+/**
+ * 双线性采样
+ * @param Location 世界坐标
+ * @param OutSample 输出采样结果
+ * @param OutMissingTile 输出需要读入的瓦片
+ * @return 位置附近有障碍物数据时返回true
+ */
+bool UCollisionSDFSubsystem::Sample(const FVector& Location, FSample& OutSample, int32& OutMissingTile) const
+{
+	OutMissingTile = INDEX_NONE;
+	if (!HasField())
+	{
+		return false;
+	}
+
+	const float LocalX = static_cast<float>(Location.X) - Origin.X;
+	const float LocalY = static_cast<float>(Location.Y) - Origin.Y;
+	const int32 TileX = FMath::FloorToInt32(LocalX / (CellSize * TileCells));
+	const int32 TileY = FMath::FloorToInt32(LocalY / (CellSize * TileCells));
+	if (TileX < 0 || TileY < 0 || TileX >= NumTilesX || TileY >= NumTilesY)
+	{
+		return false;
+	}
+
+	// 所在瓦片或其周围还没有读入时请求读取
+	const int32 TileIndex = TileY * NumTilesX + TileX;
+	const FTile& Tile = Tiles[TileIndex];
+	if (Tile.State == ETileState::Unloaded || !Tile.bNeighborsRequested)
+	{
+		OutMissingTile = TileIndex;
+	}
+
+	// 以格子中心为采样点
+	const float GridX = LocalX / CellSize - 0.5f;
+	const float GridY = LocalY / CellSize - 0.5f;
+	const int32 CellX = FMath::FloorToInt32(GridX);
+	const int32 CellY = FMath::FloorToInt32(GridY);
+	const float FracX = GridX - CellX;
+	const float FracY = GridY - CellY;
+
+	const float D00 = GetCellDistance(CellX, CellY);
+	const float D10 = GetCellDistance(CellX + 1, CellY);
+	const float D01 = GetCellDistance(CellX, CellY + 1);
+	const float D11 = GetCellDistance(CellX + 1, CellY + 1);
+	if (FMath::Min(FMath::Min(D00, D10), FMath::Min(D01, D11)) >= MaxDistance)
+	{
+		return false;
+	}
+
+	OutSample.Distance = FMath::Lerp(FMath::Lerp(D00, D10, FracX), FMath::Lerp(D01, D11, FracX), FracY);
+	OutSample.Gradient = FVector2f(
+		FMath::Lerp(D10 - D00, D11 - D01, FracY),
+		FMath::Lerp(D01 - D00, D11 - D10, FracX)) / CellSize;
+	return true;
+}
+
+/**
+ * 请求读入瓦片及其周围一圈，由 Tick 启动的任务读取
+ * @param TileIndices 缺失的瓦片
+ */
+void UCollisionSDFSubsystem::StreamIn(TConstArrayView<int32> TileIndices)
+{
+	for (const int32 TileIndex : TileIndices)
+	{
+		if (!Tiles.IsValidIndex(TileIndex) || Tiles[TileIndex].bNeighborsRequested)
+		{
+			continue;
+		}
+
+		const int32 TileX = TileIndex % NumTilesX;
+		const int32 TileY = TileIndex / NumTilesX;
+		for (int32 OffsetY = -1; OffsetY <= 1; OffsetY++)
+		{
+			for (int32 OffsetX = -1; OffsetX <= 1; OffsetX++)
+			{
+				const int32 NeighborX = TileX + OffsetX;
+				const int32 NeighborY = TileY + OffsetY;
+				if (NeighborX < 0 || NeighborY < 0 || NeighborX >= NumTilesX || NeighborY >= NumTilesY)
+				{
+					continue;
+				}
+
+				FTile& Neighbor = Tiles[NeighborY * NumTilesX + NeighborX];
+				if (Neighbor.State == ETileState::Unloaded)
+				{
+					Neighbor.State = ETileState::Loading;
+					RequestedTiles.Add(NeighborY * NumTilesX + NeighborX);
+				}
+			}
+		}
+		Tiles[TileIndex].bNeighborsRequested = true;
+	}
+}
+
+int32 UCollisionSDFSubsystem::GetNumResidentTiles() const
+{
+	int32 NumResident = 0;
+	for (const FTile& Tile : Tiles)
+	{
+		NumResident += Tile.State == ETileState::Resident ? 1 : 0;
+	}
+	return NumResident;
+}
+
+bool UCollisionSDFSubsystem::IsEnabled()
+{
+	return bSDFEnable;
+}
+
+/**
+ * 开始游戏时读入烘焙文件的索引表，找不到文件且允许时开始分帧烘焙整个关卡。
+ * 索引表很小，关闭时也会读入，运行时打开 MassEntityCollision.SDF.Enable 即可生效
+ */
+void UCollisionSDFSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (LoadIndex())
+	{
+		UE_LOG(LogTemp, Log, TEXT("MassEntityCollision SDF loaded index from %s: %d x %d tiles"), *GetBakePath(), NumTilesX, NumTilesY);
+		return;
+	}
+
+	if (bSDFEnable && bSDFBakeOnLoad && InWorld.PersistentLevel)
+	{
+		BeginBake(ALevelBounds::CalculateLevelBounds(InWorld.PersistentLevel), SDFCellSize);
+	}
+}
+
+/**
+ * 在 Mass 处理阶段之外换入读完的瓦片、启动新的读取，并推进分帧烘焙
+ * @param DeltaTime 距离上一帧的时间间隔（秒）
+ */
+void UCollisionSDFSubsystem::Tick(float DeltaTime)
+{
+	UpdateStreaming();
+
+	if (BakeJob.IsValid() && ProbeCells(*BakeJob, SDFBakeProbeBudget))
+	{
+		const TUniquePtr<FBakeJob> Job = MoveTemp(BakeJob);
+		FinishBake(*Job);
+	}
+}
+
+TStatId UCollisionSDFSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCollisionSDFSubsystem, STATGROUP_Tickables);
+}
+
+/**
+ * 换入读完的瓦片，没有任务在运行时为等待的请求启动新的读取任务；任务只使用文件句柄与自己的结果
+ */
+void UCollisionSDFSubsystem::UpdateStreaming()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(StreamCollisionSDF)
+
+	if (TileLoadTask.IsValid())
+	{
+		if (!TileLoadTask.IsCompleted())
+		{
+			return;
+		}
+
+		for (TPair<int32, TArray<int16>>& Loaded : TileLoadTask.GetResult())
+		{
+			FTile& Tile = Tiles[Loaded.Key];
+			Tile.Distances = MoveTemp(Loaded.Value);
+			Tile.State = Tile.Distances.Num() == TileCells * TileCells ? ETileState::Resident : ETileState::Empty;
+		}
+		TileLoadTask = UE::Tasks::TTask<FLoadedTiles>();
+	}
+
+	if (RequestedTiles.IsEmpty() || !TileReader)
+	{
+		return;
+	}
+
+	TArray<TPair<int32, int64>> Requests;
+	Requests.Reserve(RequestedTiles.Num());
+	for (const int32 TileIndex : RequestedTiles)
+	{
+		Requests.Emplace(TileIndex, Tiles[TileIndex].FileOffset);
+	}
+	RequestedTiles.Reset();
+
+	FArchive* Reader = TileReader.Get();
+	TileLoadTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [Reader, Requests = MoveTemp(Requests)]()
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(LoadCollisionSDFTiles)
+
+			FLoadedTiles Loaded;
+			Loaded.Reserve(Requests.Num());
+			for (const TPair<int32, int64>& Request : Requests)
+			{
+				TArray<int16>& Distances = Loaded.Emplace_GetRef(Request.Key, TArray<int16>()).Value;
+				Reader->Seek(Request.Value);
+				*Reader << Distances;
+				if (Reader->IsError())
+				{
+					Distances.Reset();
+				}
+			}
+			return Loaded;
+		});
+}
+
+/**
+ * 等待正在进行的读取结束并丢弃结果，未读完的瓦片恢复为未读入
+ */
+void UCollisionSDFSubsystem::CancelStreaming()
+{
+	if (TileLoadTask.IsValid())
+	{
+		TileLoadTask.Wait();
+		TileLoadTask = UE::Tasks::TTask<FLoadedTiles>();
+	}
+
+	RequestedTiles.Reset();
+	for (FTile& Tile : Tiles)
+	{
+		if (Tile.State == ETileState::Loading)
+		{
+			Tile.State = ETileState::Unloaded;
+			Tile.bNeighborsRequested = false;
+		}
+	}
+}
+
+void UCollisionSDFSubsystem::Deinitialize()
+{
+	CancelStreaming();
+	BakeJob.Reset();
+	TileReader.Reset();
+	Tiles.Empty();
+	NumTilesX = NumTilesY = 0;
+	Super::Deinitialize();
+}
+
+FString UCollisionSDFSubsystem::GetBakePath() const
+{
+	const FString MapName = GetWorld() ? UWorld::RemovePIEPrefix(GetWorld()->GetMapName()) : FString(TEXT("Default"));
+	return FPaths::ProjectSavedDir() / TEXT("MassEntityCollision") / MapName + TEXT(".sdf");
+}
+
+/**
+ * 写出烘焙文件：先写占位的索引表，写完瓦片后回到文件头补上偏移
+ * @return 写文件失败时返回false
+ */
+bool UCollisionSDFSubsystem::Save()
+{
+	const FString Path = GetBakePath();
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+	if (!Writer)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("MassEntityCollision SDF: cannot write %s"), *Path);
+		return false;
+	}
+
+	SerializeHeader(*Writer);
+	for (FTile& Tile : Tiles)
+	{
+		if (Tile.State == ETileState::Resident)
+		{
+			Tile.FileOffset = Writer->Tell();
+			*Writer << Tile.Distances;
+		}
+		else
+		{
+			Tile.FileOffset = INDEX_NONE;
+		}
+	}
+
+	Writer->Seek(0);
+	SerializeHeader(*Writer);
+	return Writer->Close();
+}
+
+/**
+ * 读入文件头与索引表，保留文件句柄用于之后按需读取瓦片
+ * @return 文件不存在或格式不符时返回false
+ */
+bool UCollisionSDFSubsystem::LoadIndex()
+{
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetBakePath()));
+	if (!Reader)
+	{
+		return false;
+	}
+
+	SerializeHeader(*Reader);
+	if (Reader->IsError())
+	{
+		Tiles.Empty();
+		NumTilesX = NumTilesY = 0;
+		return false;
+	}
+
+	TileReader = MoveTemp(Reader);
+	return true;
+}
+
+/**
+ * 文件头与索引表
+ * @param Ar 读或写的归档
+ */
+void UCollisionSDFSubsystem::SerializeHeader(FArchive& Ar)
+{
+	uint32 Magic = UE::MassEntityCollision::SDF::FileMagic;
+	int32 Version = UE::MassEntityCollision::SDF::FileVersion;
+	Ar << Magic << Version;
+	if (Ar.IsLoading() && (Magic != UE::MassEntityCollision::SDF::FileMagic || Version != UE::MassEntityCollision::SDF::FileVersion))
+	{
+		Ar.SetError();
+		return;
+	}
+
+	Ar << Origin << CellSize << TileCells << NumTilesX << NumTilesY << MaxDistance;
+
+	if (Ar.IsLoading())
+	{
+		if (NumTilesX <= 0 || NumTilesY <= 0 || TileCells <= 0)
+		{
+			Ar.SetError();
+			return;
+		}
+		Tiles.Reset();
+		Tiles.SetNum(NumTilesX * NumTilesY);
+	}
+
+	for (FTile& Tile : Tiles)
+	{
+		Ar << Tile.FileOffset;
+		if (Ar.IsLoading())
+		{
+			Tile.State = Tile.FileOffset >= 0 ? ETileState::Unloaded : ETileState::Empty;
+		}
+	}
+}
+
+/**
+ * 读取格子的距离
+ * @param CellX 横向格子下标
+ * @param CellY 纵向格子下标
+ * @return 瓦片不在内存中或超出范围时返回 MaxDistance
+ */
+float UCollisionSDFSubsystem::GetCellDistance(const int32 CellX, const int32 CellY) const
+{
+	if (CellX < 0 || CellY < 0 || CellX >= NumTilesX * TileCells || CellY >= NumTilesY * TileCells)
+	{
+		return MaxDistance;
+	}
+
+	const FTile& Tile = Tiles[(CellY / TileCells) * NumTilesX + CellX / TileCells];
+	if (Tile.State != ETileState::Resident)
+	{
+		return MaxDistance;
+	}
+
+	return Tile.Distances[(CellY % TileCells) * TileCells + CellX % TileCells];
+}
+
+static FAutoConsoleCommandWithWorldAndArgs BakeSDFCommand(
+	TEXT("MassEntityCollision.SDF.Bake"),
+	TEXT("烘焙当前关卡的静态场景距离场并写入 Saved/MassEntityCollision。参数：CellSize="),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			UCollisionSDFSubsystem* SDFSubsystem = World ? World->GetSubsystem<UCollisionSDFSubsystem>() : nullptr;
+			if (!SDFSubsystem || !World->PersistentLevel)
+			{
+				return;
+			}
+
+			float CellSize = SDFCellSize;
+			FParse::Value(*FString::Join(Args, TEXT(" ")), TEXT("CellSize="), CellSize);
+			SDFSubsystem->Bake(ALevelBounds::CalculateLevelBounds(World->PersistentLevel), CellSize);
+		}));
@@ -3,10 +3,758 @@
 
 #include "CollisionSubsystem.h"
 
+#include "CollisionFragments.h"
 #include "MassCommonFragments.h"
 #include "MassEntitySubsystem.h"
 #include "MassSpawnerSubsystem.h"
 #include "MassEntityConfigAsset.h"
+#include "MassEntityManager.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Unique.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+//窄相阶段是否使用向量版本的重叠计算，不支持向量指令的平台回退为标量版本
+#ifndef MASSENTITYCOLLISION_SIMD_NARROWPHASE
+#define MASSENTITYCOLLISION_SIMD_NARROWPHASE PLATFORM_ENABLE_VECTORINTRINSICS
+#endif
+
+const FName UCollisionSubsystem::LayerName = FName(TEXT("Collision"));
+
+namespace UE::MassEntityCollision
+{
+	/**
+	 * 选出法线对应的接触：穿透最深者优先，深度相同时取槽位较小者，结果与邻居的顺序无关
+	 * @return 新的接触是否应替换当前选中的接触
+	 */
+	static bool IsDeeperContact(const float Depth, const int32 Other, const float BestDepth, const int32 BestOther)
+	{
+		return Depth > BestDepth || (Depth == BestDepth && Other < BestOther);
+	}
+}
+
+/**
+ * 分配槽位
+ * @param Entity 占用槽位的实体
+ * @return 槽位下标
+ */
+int32 FCollisionSlotStore::Allocate(const FMassEntityHandle Entity)
+{
+	if (FreeSlots.Num() > 0)
+	{
+		const int32 Slot = FreeSlots.Pop(EAllowShrinking::No);
+		Entities[Slot] = Entity;
+		Wake(Slot);
+		return Slot;
+	}
+
+	X.Add(0.f);
+	Y.Add(0.f);
+	Z.Add(0.f);
+	Radius.Add(0.f);
+	StillFrames.Add(0);
+	Sleeping.Add(0);
+	return Entities.Add(Entity);
+}
+
+/**
+ * 归还槽位
+ * @param Slot 槽位下标
+ */
+void FCollisionSlotStore::Free(const int32 Slot)
+{
+	Entities[Slot].Reset();
+	FreeSlots.Add(Slot);
+}
+
+/**
+ * 计算槽位与一组邻居的重叠，只读取连续的 float 数组
+ *
+ * 邻居不少于4个且平台支持向量指令时使用向量版本，否则使用标量版本。
+ *
+ * @param Slot 当前槽位
+ * @param Neighbors 可能重叠的邻居槽位
+ * @param OutHitNormal 输出碰撞方向的单位法向量，无碰撞时保持不变
+ * @param OutNumOverlaps 不为空时输出重叠的邻居数量
+ * @return 返回本轮的位置修正量
+ */
+FVector3f FCollisionSlotStore::ResolveOverlaps(const int32 Slot, TConstArrayView<int32> Neighbors, FVector3f& OutHitNormal, int32* OutNumOverlaps) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(CalculateCollision)
+
+#if MASSENTITYCOLLISION_SIMD_NARROWPHASE
+	if (Neighbors.Num() >= 4)
+	{
+		return ResolveOverlapsSimd(Slot, Neighbors, OutHitNormal, OutNumOverlaps);
+	}
+#endif
+
+	return ResolveOverlapsScalar(Slot, Neighbors, OutHitNormal, OutNumOverlaps);
+}
+
+/**
+ * 逐个邻居计算重叠
+ * @param Slot 当前槽位
+ * @param Neighbors 可能重叠的邻居槽位
+ * @param OutHitNormal 输出碰撞方向的单位法向量，无碰撞时保持不变
+ * @param OutNumOverlaps 不为空时输出重叠的邻居数量
+ * @return 返回本轮的位置修正量
+ */
+FVector3f FCollisionSlotStore::ResolveOverlapsScalar(const int32 Slot, TConstArrayView<int32> Neighbors, FVector3f& OutHitNormal, int32* OutNumOverlaps) const
+{
+	const float* RESTRICT PX = X.GetData();
+	const float* RESTRICT PY = Y.GetData();
+	const float* RESTRICT PZ = Z.GetData();
+	const float* RESTRICT PRadius = Radius.GetData();
+
+	FVector3f Correction(FVector3f::ZeroVector);
+	float BestDepth = -MAX_flt;
+	int32 BestOther = MAX_int32;
+	int32 NumOverlaps = 0;
+
+	for (const int32 Other : Neighbors)
+	{
+		const float DX = PX[Slot] - PX[Other];
+		const float DY = PY[Slot] - PY[Other];
+		const float DZ = PZ[Slot] - PZ[Other];
+		const float DistSq = DX * DX + DY * DY + DZ * DZ;
+		const float Radii = PRadius[Slot] + PRadius[Other];
+
+		// 若距离小于两者半径之和，则认为发生了重叠
+		if (DistSq < FMath::Square(Radii))
+		{
+			FVector3f Direction = FVector3f(DX, DY, DZ).GetSafeNormal();
+			Direction.Z = 0.f;
+
+			const float Depth = Radii - FMath::Sqrt(DistSq) + 0.01f;
+
+			// 沿分离方向偏移一半深度，另一半由对方承担
+			Correction += Depth / 2 * Direction;
+			NumOverlaps++;
+
+			if (UE::MassEntityCollision::IsDeeperContact(Depth, Other, BestDepth, BestOther))
+			{
+				BestDepth = Depth;
+				BestOther = Other;
+				OutHitNormal = Direction;
+			}
+		}
+	}
+
+	if (OutNumOverlaps)
+	{
+		*OutNumOverlaps = NumOverlaps;
+	}
+	return Correction;
+}
+
+/**
+ * 每次处理4个邻居：把邻居数据收集到向量寄存器，同时计算距离、穿透深度与法线，
+ * 用重叠掩码累加推出量。不足4个的尾部以远处的占位数据填充，掩码自然为假。
+ * 法线与标量版本一致：三维方向归一化后把 Z 置0，取穿透最深（深度相同时槽位最小）的邻居。
+ *
+ * @param Slot 当前槽位
+ * @param Neighbors 可能重叠的邻居槽位
+ * @param OutHitNormal 输出穿透最深的邻居的分离方向，无碰撞时保持不变
+ * @param OutNumOverlaps 不为空时输出重叠的邻居数量
+ * @return 返回本轮的位置修正量
+ */
+FVector3f FCollisionSlotStore::ResolveOverlapsSimd(const int32 Slot, TConstArrayView<int32> Neighbors, FVector3f& OutHitNormal, int32* OutNumOverlaps) const
+{
+	constexpr float FarAway = 1.e18f;
+
+	const VectorRegister4Float SelfX = VectorSetFloat1(X[Slot]);
+	const VectorRegister4Float SelfY = VectorSetFloat1(Y[Slot]);
+	const VectorRegister4Float SelfZ = VectorSetFloat1(Z[Slot]);
+	const VectorRegister4Float SelfRadius = VectorSetFloat1(Radius[Slot]);
+	const VectorRegister4Float DepthBias = VectorSetFloat1(0.01f);
+	const VectorRegister4Float Half = VectorSetFloat1(0.5f);
+	const VectorRegister4Float SmallNumber = VectorSetFloat1(UE_SMALL_NUMBER);
+	const VectorRegister4Float Zero = VectorZeroFloat();
+	const VectorRegister4Float One = VectorOneFloat();
+
+	VectorRegister4Float SumX = Zero;
+	VectorRegister4Float SumY = Zero;
+	float BestDepth = -MAX_flt;
+	int32 BestOther = MAX_int32;
+	int32 NumOverlaps = 0;
+
+	const int32 NumNeighbors = Neighbors.Num();
+	for (int32 Base = 0; Base < NumNeighbors; Base += 4)
+	{
+		alignas(16) float OtherX[4];
+		alignas(16) float OtherY[4];
+		alignas(16) float OtherZ[4];
+		alignas(16) float OtherRadius[4];
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			if (Base + Lane < NumNeighbors)
+			{
+				const int32 Other = Neighbors[Base + Lane];
+				OtherX[Lane] = X[Other];
+				OtherY[Lane] = Y[Other];
+				OtherZ[Lane] = Z[Other];
+				OtherRadius[Lane] = Radius[Other];
+			}
+			else
+			{
+				OtherX[Lane] = FarAway;
+				OtherY[Lane] = FarAway;
+				OtherZ[Lane] = FarAway;
+				OtherRadius[Lane] = 0.f;
+			}
+		}
+
+		const VectorRegister4Float DX = VectorSubtract(SelfX, VectorLoadAligned(OtherX));
+		const VectorRegister4Float DY = VectorSubtract(SelfY, VectorLoadAligned(OtherY));
+		const VectorRegister4Float DZ = VectorSubtract(SelfZ, VectorLoadAligned(OtherZ));
+		const VectorRegister4Float DistSq = VectorMultiplyAdd(DX, DX, VectorMultiplyAdd(DY, DY, VectorMultiply(DZ, DZ)));
+		const VectorRegister4Float Radii = VectorAdd(SelfRadius, VectorLoadAligned(OtherRadius));
+
+		// 若距离小于两者半径之和，则认为发生了重叠
+		const VectorRegister4Float Overlap = VectorCompareLT(DistSq, VectorMultiply(Radii, Radii));
+		const int32 OverlapMask = VectorMaskBits(Overlap);
+		if (OverlapMask == 0)
+		{
+			continue;
+		}
+		NumOverlaps += FMath::CountBits(static_cast<uint64>(OverlapMask));
+
+		// 与 GetSafeNormal 一致：长度过小时方向为零
+		const VectorRegister4Float Dist = VectorSqrt(DistSq);
+		const VectorRegister4Float InvDist = VectorSelect(VectorCompareGT(DistSq, SmallNumber), VectorDivide(One, Dist), Zero);
+		const VectorRegister4Float NormalX = VectorMultiply(DX, InvDist);
+		const VectorRegister4Float NormalY = VectorMultiply(DY, InvDist);
+
+		// 沿分离方向偏移一半深度，另一半由对方承担
+		const VectorRegister4Float HalfDepth = VectorMultiply(VectorAdd(VectorSubtract(Radii, Dist), DepthBias), Half);
+		SumX = VectorAdd(SumX, VectorSelect(Overlap, VectorMultiply(NormalX, HalfDepth), Zero));
+		SumY = VectorAdd(SumY, VectorSelect(Overlap, VectorMultiply(NormalY, HalfDepth), Zero));
+
+		// 穿透最深的邻居的法线，只检查重叠的通道
+		alignas(16) float StoredNormalX[4];
+		alignas(16) float StoredNormalY[4];
+		alignas(16) float StoredHalfDepth[4];
+		VectorStoreAligned(NormalX, StoredNormalX);
+		VectorStoreAligned(NormalY, StoredNormalY);
+		VectorStoreAligned(HalfDepth, StoredHalfDepth);
+		for (int32 Lane = 0; Lane < 4; Lane++)
+		{
+			if ((OverlapMask & (1 << Lane)) == 0)
+			{
+				continue;
+			}
+
+			const float Depth = StoredHalfDepth[Lane] * 2.f;
+			const int32 Other = Neighbors[Base + Lane];
+			if (UE::MassEntityCollision::IsDeeperContact(Depth, Other, BestDepth, BestOther))
+			{
+				BestDepth = Depth;
+				BestOther = Other;
+				OutHitNormal = FVector3f(StoredNormalX[Lane], StoredNormalY[Lane], 0.f);
+			}
+		}
+	}
+
+	alignas(16) float StoredSumX[4];
+	alignas(16) float StoredSumY[4];
+	VectorStoreAligned(SumX, StoredSumX);
+	VectorStoreAligned(SumY, StoredSumY);
+	if (OutNumOverlaps)
+	{
+		*OutNumOverlaps = NumOverlaps;
+	}
+	return FVector3f(
+		StoredSumX[0] + StoredSumX[1] + StoredSumX[2] + StoredSumX[3],
+		StoredSumY[0] + StoredSumY[1] + StoredSumY[2] + StoredSumY[3],
+		0.f);
+}
+
+/**
+ * 按包围盒分离
+ * @param Slot 当前槽位
+ * @param Neighbors 可能重叠的邻居槽位
+ * @param OutHitNormal 输出穿透最深（深度相同时槽位最小）的邻居的分离轴
+ * @param OutNumOverlaps 不为空时输出重叠的邻居数量
+ * @return 返回本轮的位置修正量
+ */
+FVector3f FCollisionSlotStore::ResolveOverlapsBroadphase(const int32 Slot, TConstArrayView<int32> Neighbors, FVector3f& OutHitNormal, int32* OutNumOverlaps) const
+{
+	FVector3f Correction(FVector3f::ZeroVector);
+	float BestDepth = -MAX_flt;
+	int32 BestOther = MAX_int32;
+	int32 NumOverlaps = 0;
+
+	for (const int32 Other : Neighbors)
+	{
+		const float DX = X[Slot] - X[Other];
+		const float DY = Y[Slot] - Y[Other];
+		const float Radii = Radius[Slot] + Radius[Other];
+		const float PenetrationX = Radii - FMath::Abs(DX);
+		const float PenetrationY = Radii - FMath::Abs(DY);
+		if (PenetrationX <= 0.f || PenetrationY <= 0.f)
+		{
+			continue;
+		}
+		NumOverlaps++;
+
+		// 完全重合时按槽位下标决定方向，保证双方朝相反方向分开
+		const float TieBreak = Slot < Other ? 1.f : -1.f;
+		FVector3f Normal;
+		float Depth;
+		if (PenetrationX < PenetrationY)
+		{
+			const float Sign = DX != 0.f ? FMath::Sign(DX) : TieBreak;
+			Correction.X += Sign * PenetrationX * 0.5f;
+			Normal = FVector3f(Sign, 0.f, 0.f);
+			Depth = PenetrationX;
+		}
+		else
+		{
+			const float Sign = DY != 0.f ? FMath::Sign(DY) : TieBreak;
+			Correction.Y += Sign * PenetrationY * 0.5f;
+			Normal = FVector3f(0.f, Sign, 0.f);
+			Depth = PenetrationY;
+		}
+
+		if (UE::MassEntityCollision::IsDeeperContact(Depth, Other, BestDepth, BestOther))
+		{
+			BestDepth = Depth;
+			BestOther = Other;
+			OutHitNormal = Normal;
+		}
+	}
+
+	if (OutNumOverlaps)
+	{
+		*OutNumOverlaps = NumOverlaps;
+	}
+	return Correction;
+}
+
+/**
+ * 收集槽位与邻居的接触
+ * @param Slot 当前槽位
+ * @param Neighbors 可能重叠的邻居槽位
+ * @param bOnlyLowerSlot 是否只输出由较小槽位负责的接触
+ * @param OutContacts 追加输出的接触
+ */
+void FCollisionSlotStore::GatherContacts(const int32 Slot, TConstArrayView<int32> Neighbors, const bool bOnlyLowerSlot, TArray<FCollisionContact>& OutContacts) const
+{
+	for (const int32 Other : Neighbors)
+	{
+		if (bOnlyLowerSlot && Other < Slot && !IsSleeping(Other))
+		{
+			continue;
+		}
+
+		const float DX = X[Slot] - X[Other];
+		const float DY = Y[Slot] - Y[Other];
+		const float DZ = Z[Slot] - Z[Other];
+		const float DistSq = DX * DX + DY * DY + DZ * DZ;
+		const float Radii = Radius[Slot] + Radius[Other];
+		if (DistSq >= FMath::Square(Radii))
+		{
+			continue;
+		}
+
+		FVector3f Direction = FVector3f(DX, DY, DZ).GetSafeNormal();
+		Direction.Z = 0.f;
+
+		// 槽位对按下标排列，法线始终由 B 指向 A
+		FCollisionContact& Contact = OutContacts.AddDefaulted_GetRef();
+		const bool bSlotFirst = Slot < Other;
+		Contact.SlotA = bSlotFirst ? Slot : Other;
+		Contact.SlotB = bSlotFirst ? Other : Slot;
+		Contact.EntityA = Entities[Contact.SlotA];
+		Contact.EntityB = Entities[Contact.SlotB];
+		Contact.Normal = bSlotFirst ? Direction : -Direction;
+		Contact.Depth = Radii - FMath::Sqrt(DistSq);
+	}
+}
+
+/**
+ * 发布本帧的接触
+ * @param InContacts 各工作线程收集到的接触，可能有重复
+ */
+void FCollisionContactEvents::Publish(TArray<FCollisionContact>&& InContacts)
+{
+	Contacts = MoveTemp(InContacts);
+	Contacts.Sort([](const FCollisionContact& A, const FCollisionContact& B)
+		{
+			return A.SlotA != B.SlotA ? A.SlotA < B.SlotA : A.SlotB < B.SlotB;
+		});
+
+	const int32 NumUnique = Algo::Unique(Contacts, [](const FCollisionContact& A, const FCollisionContact& B)
+		{
+			return A.SlotA == B.SlotA && A.SlotB == B.SlotB;
+		});
+	Contacts.SetNum(NumUnique, EAllowShrinking::No);
+}
+
+/**
+ * 按标签筛选接触
+ * @param EntityManager 实体管理器
+ * @param TagA A 方需要的标签
+ * @param TagB B 方需要的标签
+ * @param OutContacts 追加输出的接触
+ */
+void FCollisionContactEvents::Filter(const FMassEntityManager& EntityManager, const UScriptStruct* TagA, const UScriptStruct* TagB, TArray<FCollisionContact>& OutContacts) const
+{
+	// 同一原型的实体标签相同，按原型缓存结果
+	TMap<FMassArchetypeHandle, TPair<bool, bool>> ArchetypeTags;
+	auto GetTags = [&](const FMassEntityHandle Entity) -> TPair<bool, bool>
+	{
+		const FMassArchetypeHandle Archetype = EntityManager.GetArchetypeForEntity(Entity);
+		if (const TPair<bool, bool>* Cached = ArchetypeTags.Find(Archetype))
+		{
+			return *Cached;
+		}
+
+		const FMassTagBitSet& Tags = EntityManager.GetArchetypeComposition(Archetype).Tags;
+		return ArchetypeTags.Add(Archetype, TPair<bool, bool>(!TagA || Tags.Contains(*TagA), !TagB || Tags.Contains(*TagB)));
+	};
+
+	for (const FCollisionContact& Contact : Contacts)
+	{
+		if (!EntityManager.IsEntityValid(Contact.EntityA) || !EntityManager.IsEntityValid(Contact.EntityB))
+		{
+			continue;
+		}
+
+		const TPair<bool, bool> TagsA = GetTags(Contact.EntityA);
+		const TPair<bool, bool> TagsB = GetTags(Contact.EntityB);
+		if (TagsA.Key && TagsB.Value)
+		{
+			OutContacts.Add(Contact);
+		}
+		else if (TagsB.Key && TagsA.Value)
+		{
+			FCollisionContact& Swapped = OutContacts.Add_GetRef(Contact);
+			Swap(Swapped.EntityA, Swapped.EntityB);
+			Swap(Swapped.SlotA, Swapped.SlotB);
+			Swapped.Normal = -Swapped.Normal;
+		}
+	}
+}
+
+/**
+ * 刷新邻居缓存
+ * @param CollisionSubsystem 本帧已写入位置的槽位存储与空间索引
+ * @param Margin 迟滞距离
+ */
+void FCollisionContactCache::Refresh(const UCollisionSubsystem& CollisionSubsystem, const float Margin)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(RefreshCollisionContacts)
+
+	const FCollisionSlotStore& SlotStore = CollisionSubsystem.SlotStore;
+
+	const int32 NumSlots = SlotStore.Num();
+	Contacts.SetNum(NumSlots);
+	Anchors.SetNumZeroed(NumSlots);
+	AnchorRadius.SetNumZeroed(NumSlots);
+	Valid.SetNumZeroed(NumSlots);
+
+	// 迟滞距离变化后旧列表的范围不再可靠
+	if (Margin != CachedMargin)
+	{
+		FMemory::Memzero(Valid.GetData(), Valid.Num());
+		CachedMargin = Margin;
+	}
+
+	// 找出需要重新查询的槽位
+	const float RefreshDistanceSq = FMath::Square(Margin * 0.5f);
+	RefreshSlots.Reset();
+	NumLiveSlots = 0;
+	for (int32 Slot = 0; Slot < NumSlots; Slot++)
+	{
+		if (!SlotStore.Entities[Slot].IsValid())
+		{
+			continue;
+		}
+
+		NumLiveSlots++;
+		const FVector3f Location(SlotStore.X[Slot], SlotStore.Y[Slot], SlotStore.Z[Slot]);
+		if (!Valid[Slot] || AnchorRadius[Slot] != SlotStore.Radius[Slot] || FVector3f::DistSquared(Location, Anchors[Slot]) > RefreshDistanceSq)
+		{
+			RefreshSlots.Add(Slot);
+		}
+	}
+
+	// 先把刷新的槽位从旧邻居的列表中移除，列表保持有序
+	for (const int32 Slot : RefreshSlots)
+	{
+		for (const int32 Other : Contacts[Slot])
+		{
+			RemoveSorted(Contacts[Other], Slot);
+		}
+	}
+
+	// 并行重新查询，每个槽位只写自己的列表
+	ParallelFor(RefreshSlots.Num(), [this, &CollisionSubsystem, &SlotStore, Margin](const int32 Index)
+		{
+			const int32 Slot = RefreshSlots[Index];
+			const FVector3f Location(SlotStore.X[Slot], SlotStore.Y[Slot], SlotStore.Z[Slot]);
+			const float Range = SlotStore.Radius[Slot] + SlotStore.MaxRadius + 2.f * Margin;
+
+			TArray<int32>& SlotContacts = Contacts[Slot];
+			SlotContacts.Reset();
+			CollisionSubsystem.QueryGrid(FBox::BuildAABB(FVector(Location), FVector(Range)), SlotContacts);
+			SlotContacts.RemoveSwap(Slot, EAllowShrinking::No);
+			SlotContacts.Sort();
+
+			Anchors[Slot] = Location;
+			AnchorRadius[Slot] = SlotStore.Radius[Slot];
+			Valid[Slot] = 1;
+		});
+
+	// 把刷新的槽位加入新邻居的列表，保持对称：按邻居分组后与其有序列表归并，每个列表只归并一次
+	AddBackPairs.Reset();
+	for (const int32 Slot : RefreshSlots)
+	{
+		for (const int32 Other : Contacts[Slot])
+		{
+			AddBackPairs.Emplace(Other, Slot);
+		}
+	}
+	AddBackPairs.Sort([](const FIntPoint& A, const FIntPoint& B) { return A.X != B.X ? A.X < B.X : A.Y < B.Y; });
+
+	for (int32 First = 0; First < AddBackPairs.Num();)
+	{
+		const int32 Other = AddBackPairs[First].X;
+		int32 Last = First;
+		AddBackSlots.Reset();
+		while (Last < AddBackPairs.Num() && AddBackPairs[Last].X == Other)
+		{
+			AddBackSlots.Add(AddBackPairs[Last++].Y);
+		}
+
+		MergeSorted(Contacts[Other], AddBackSlots);
+		First = Last;
+	}
+
+	int32 NumEntries = 0;
+	for (const TArray<int32>& SlotContacts : Contacts)
+	{
+		NumEntries += SlotContacts.Num();
+	}
+	NumPairs = NumEntries / 2;
+}
+
+/**
+ * 从所有邻居的列表中移除槽位，并让槽位的列表失效
+ * @param Slot 被归还的槽位
+ */
+void FCollisionContactCache::Remove(const int32 Slot)
+{
+	if (!Contacts.IsValidIndex(Slot))
+	{
+		return;
+	}
+
+	for (const int32 Other : Contacts[Slot])
+	{
+		RemoveSorted(Contacts[Other], Slot);
+	}
+	Contacts[Slot].Reset();
+	Valid[Slot] = 0;
+}
+
+/**
+ * 从有序列表中移除槽位，保持顺序
+ * @param SlotContacts 有序的邻居列表
+ * @param Slot 要移除的槽位
+ */
+void FCollisionContactCache::RemoveSorted(TArray<int32>& SlotContacts, const int32 Slot)
+{
+	const int32 Index = Algo::BinarySearch(SlotContacts, Slot);
+	if (Index != INDEX_NONE)
+	{
+		SlotContacts.RemoveAt(Index, EAllowShrinking::No);
+	}
+}
+
+/**
+ * 把有序的槽位归并到有序列表中，已存在的槽位不重复加入
+ * @param SlotContacts 有序的邻居列表
+ * @param Slots 有序的新槽位
+ */
+void FCollisionContactCache::MergeSorted(TArray<int32>& SlotContacts, TConstArrayView<int32> Slots)
+{
+	MergeScratch.Reset(SlotContacts.Num() + Slots.Num());
+
+	int32 Index = 0;
+	for (const int32 Slot : Slots)
+	{
+		while (Index < SlotContacts.Num() && SlotContacts[Index] < Slot)
+		{
+			MergeScratch.Add(SlotContacts[Index++]);
+		}
+		if (Index < SlotContacts.Num() && SlotContacts[Index] == Slot)
+		{
+			continue;
+		}
+		MergeScratch.Add(Slot);
+	}
+	MergeScratch.Append(SlotContacts.GetData() + Index, SlotContacts.Num() - Index);
+
+	Swap(SlotContacts, MergeScratch);
+}
+
+/**
+ * 查询统一空间索引中的碰撞图层，并把索引槽位换成碰撞槽位
+ * @param Bounds 查询范围
+ * @param OutSlots 追加输出的 SlotStore 槽位
+ */
+void UCollisionSubsystem::QueryGrid(const FBox& Bounds, TArray<int32>& OutSlots) const
+{
+	const int32 FirstResult = OutSlots.Num();
+	SpatialIndex->Query(Bounds, LayerMask, OutSlots);
+
+	// 在 UCollisionProcessor 写入映射之后才加入索引的槽位本帧不参与碰撞
+	int32 NumKept = FirstResult;
+	for (int32 Index = FirstResult; Index < OutSlots.Num(); Index++)
+	{
+		const int32 IndexSlot = OutSlots[Index];
+		if (IndexToCollisionSlot.IsValidIndex(IndexSlot) && IndexToCollisionSlot[IndexSlot] != INDEX_NONE)
+		{
+			OutSlots[NumKept++] = IndexToCollisionSlot[IndexSlot];
+		}
+	}
+	OutSlots.SetNum(NumKept, EAllowShrinking::No);
+}
+
+/**
+ * 获取可能与槽位重叠的邻居
+ * @param Slot 当前槽位
+ * @param bUseContactCache 是否使用邻居缓存
+ * @param Scratch 查询索引时使用的临时数组
+ * @return 不含自身的邻居槽位
+ */
+TConstArrayView<int32> UCollisionSubsystem::QueryNeighbors(const int32 Slot, const bool bUseContactCache, TArray<int32>& Scratch) const
+{
+	if (bUseContactCache)
+	{
+		return ContactCache.GetContacts(Slot);
+	}
+
+	// 查询范围为自身半径加上最大邻居半径，覆盖所有可能重叠的实体
+	const FVector Location(SlotStore.X[Slot], SlotStore.Y[Slot], SlotStore.Z[Slot]);
+	Scratch.Reset();
+	QueryGrid(FBox::BuildAABB(Location, FVector(SlotStore.Radius[Slot] + SlotStore.MaxRadius)), Scratch);
+
+	// 过滤掉自身
+	Scratch.RemoveSwap(Slot, EAllowShrinking::No);
+	return Scratch;
+}
+
+/**
+ * 分步扫过移动路径，每步的步长不超过半径的一半；某一步与邻居的穿透超过半径的一半并且比上一步更深时，
+ * 退回上一步的位置，剩余的浅层重叠交给常规求解。起点就已经深度重叠的实体可以沿着远离对方的方向离开。
+ * 位移超过 MaxSteps 个步长时截断在最后一步，避免步长变长后穿过其他实体
+ * @param Slot 移动的槽位
+ * @param Start 起点
+ * @param End 终点
+ * @param MaxSteps 最多的分步数
+ * @return 停下的位置
+ */
+FVector3f UCollisionSubsystem::SweepToFirstContact(const int32 Slot, const FVector3f& Start, const FVector3f& End, const int32 MaxSteps) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(SweepCollisionSlot)
+
+	const float Radius = SlotStore.Radius[Slot];
+	const float StepLength = FMath::Max(Radius * 0.5f, 1.f);
+	const float Distance = FVector3f::Dist(Start, End);
+	const int32 NumSteps = FMath::Max(FMath::CeilToInt32(Distance / StepLength), 1);
+
+	// 步数不足时截断位移而不是拉长步长，剩余的距离留到下一帧
+	const int32 ClampedSteps = FMath::Min(NumSteps, FMath::Max(MaxSteps, 1));
+	const FVector3f SweepEnd = ClampedSteps < NumSteps ? Start + (End - Start) * (ClampedSteps * StepLength / Distance) : End;
+
+	TArray<int32> Neighbors;
+	FVector3f Previous = Start;
+	for (int32 Step = 1; Step <= ClampedSteps; Step++)
+	{
+		const FVector3f Location = FMath::Lerp(Start, SweepEnd, static_cast<float>(Step) / ClampedSteps);
+
+		Neighbors.Reset();
+		QueryGrid(FBox::BuildAABB(FVector(Location), FVector(Radius + SlotStore.MaxRadius)), Neighbors);
+
+		for (const int32 Other : Neighbors)
+		{
+			if (Other == Slot)
+			{
+				continue;
+			}
+
+			// 只有越陷越深才算撞上，与上一步（第一步时为起点）对同一个邻居的穿透比较
+			const FVector3f OtherLocation(SlotStore.X[Other], SlotStore.Y[Other], SlotStore.Z[Other]);
+			const float Penetration = Radius + SlotStore.Radius[Other] - FVector3f::Dist(Location, OtherLocation);
+			const float PreviousPenetration = Radius + SlotStore.Radius[Other] - FVector3f::Dist(Previous, OtherLocation);
+			if (Penetration > Radius * 0.5f && Penetration > PreviousPenetration)
+			{
+				return Previous;
+			}
+		}
+
+		Previous = Location;
+	}
+
+	return SweepEnd;
+}
+
+/**
+ * 以种子为起点沿接触关系扩散，唤醒所有互相接触的睡眠槽位
+ * @param Seeds 被运动智能体接触到的睡眠槽位
+ * @param ContactMargin 判定接触的额外距离
+ * @param OutWoken 输出本次被唤醒的槽位
+ */
+void UCollisionSubsystem::WakeIslands(TConstArrayView<int32> Seeds, const float ContactMargin, TArray<int32>& OutWoken)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(WakeCollisionIslands)
+
+	TArray<int32> Pending(Seeds);
+	TArray<int32> Neighbors;
+	while (Pending.Num() > 0)
+	{
+		const int32 Slot = Pending.Pop(EAllowShrinking::No);
+		if (!SlotStore.IsSleeping(Slot))
+		{
+			continue;
+		}
+
+		SlotStore.Wake(Slot);
+		OutWoken.Add(Slot);
+
+		const FVector Location(SlotStore.X[Slot], SlotStore.Y[Slot], SlotStore.Z[Slot]);
+		Neighbors.Reset();
+		QueryGrid(FBox::BuildAABB(Location, FVector(SlotStore.Radius[Slot] + SlotStore.MaxRadius + ContactMargin)), Neighbors);
+
+		for (const int32 Other : Neighbors)
+		{
+			if (SlotStore.IsSleeping(Other) && SlotStore.AreTouching(Slot, Other, ContactMargin))
+			{
+				Pending.Add(Other);
+			}
+		}
+	}
+}
+
+/**
+ * 初始化子系统，在统一空间索引中注册碰撞图层
+ * @param Collection 子系统集合
+ */
+void UCollisionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SpatialIndex = Collection.InitializeDependency<UMassSpatialIndexSubsystem>();
+	if (SpatialIndex)
+	{
+		LayerMask = SpatialIndex->RegisterLayer(LayerName, FCollisionFragment::StaticStruct());
+	}
+}
 
 void UCollisionSubsystem::SpawnEntities(const FVector& Location, int Count, UMassEntityConfigAsset* EntityConfig)
 {
@@ -22,3 +770,20 @@ void UCollisionSubsystem::SpawnEntities(const FVector& Location, int Count, UMas
 		TransformFragment.GetMutableTransform().SetLocation(Location);
 	}
 }
+
+static FAutoConsoleCommandWithWorld ContactStatsCommand(
+	TEXT("MassEntityCollision.ContactStats"),
+	TEXT("输出邻居缓存的邻居对数量与本帧的刷新比例"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+		{
+			const UCollisionSubsystem* CollisionSubsystem = World ? World->GetSubsystem<UCollisionSubsystem>() : nullptr;
+			if (!CollisionSubsystem)
+			{
+				return;
+			}
+
+			const FCollisionContactCache& ContactCache = CollisionSubsystem->ContactCache;
+			UE_LOG(LogTemp, Log, TEXT("MassEntityCollision contacts: %d pairs, refreshed %d / %d slots (%.1f%%)"),
+				ContactCache.GetNumPairs(), ContactCache.GetNumRefreshed(), ContactCache.GetNumLiveSlots(),
+				100.0 * ContactCache.GetNumRefreshed() / FMath::Max(ContactCache.GetNumLiveSlots(), 1));
+		}));
@@ -17,17 +17,18 @@ namespace HashGridExample::Signals
 	const FName EntityQueried = FName(TEXT("EntityQueried"));
 }
 
-//Ƭμ¼ʵڹϣĵԪλ
+//带有该片段的实体参与碰撞求解，在统一空间索引中属于碰撞图层
 USTRUCT()
 struct MASSENTITYCOLLISION_API FCollisionFragment : public FMassFragment
 {
 	GENERATED_BODY()
 public:
-	FHashGridExample::FCellLocation CellLocation;
+	//在 UCollisionSubsystem::SlotStore 中的槽位
+	int32 SlotIndex = INDEX_NONE;
 };
 
 
-//Լ¼ʵڹϣĵԪλ
+//该特性让实体参与碰撞求解，并在模板中没有 FMassSpatialIndexFragment 时自动加入统一空间索引
 UCLASS()
 class MASSENTITYCOLLISION_API UCollisionFragments : public UMassEntityTraitBase
 {
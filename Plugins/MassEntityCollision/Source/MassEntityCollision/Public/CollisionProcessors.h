@@ -3,13 +3,14 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "CollisionSubsystem.h"
 #include "MassObserverProcessor.h"
 #include "MassProcessor.h"
 #include "MassSignalProcessorBase.h"
 #include "CollisionProcessors.generated.h"
 
 /**
- * ײʼ
+ * 碰撞初始化处理器
  */
 UCLASS()
 class MASSENTITYCOLLISION_API UCollisionInitializerProcessor : public UMassObserverProcessor
@@ -23,7 +24,7 @@ class MASSENTITYCOLLISION_API UCollisionInitializerProcessor : public UMassObser
 };
 
 
-//ײٴʵײƬƳʱִʵӹϣƳֹͣײ١
+//碰撞销毁处理器，当实体的碰撞相关碎片被移除时，执行清理操作，将实体从碰撞槽位与邻居缓存中移除，停止对其的碰撞跟踪。
 UCLASS()
 class MASSENTITYCOLLISION_API UCollisionDestroyProcessor : public UMassObserverProcessor
 {
@@ -34,7 +35,20 @@ class MASSENTITYCOLLISION_API UCollisionDestroyProcessor : public UMassObserverP
 	FMassEntityQuery EntityQuery;
 };
 
-//ײԸ¹ϣʵλãʹʵײȷײѯ׼ȷԣʵƶ
+//本帧移动距离超过阈值的实体，需要分步扫过移动路径以免穿过人群
+struct FCollisionFastMove
+{
+	int32 Slot = INDEX_NONE;
+
+	//在统一空间索引中的槽位，停下后用于移动索引中的条目
+	int32 IndexSlot = INDEX_NONE;
+	FVector3f Start = FVector3f::ZeroVector;
+	FVector3f End = FVector3f::ZeroVector;
+};
+
+//碰撞处理器，每帧把实体位置写入紧凑的槽位存储，通过统一空间索引查询邻居，检测和处理实体间的碰撞
+//碰撞求解采用 Jacobi 迭代：每轮先基于位置快照并行计算修正量，再统一应用，结果与线程数无关
+//连续多帧静止的实体进入睡眠，不再作为查询源；被运动的智能体接触时整组唤醒
 UCLASS()
 class MASSENTITYCOLLISION_API UCollisionProcessor : public UMassProcessor
 {
@@ -45,7 +59,51 @@ class MASSENTITYCOLLISION_API UCollisionProcessor : public UMassProcessor
 	FMassEntityQuery EntityQuery;
 	FMassEntityQuery CollisionQuery;
 
-	FVector ResolveCollisions(const TArray<FMassEntityHandle>& Entities, FMassEntityManager& EntityManager, float Radius,
-		FTransform
-		& EntityTransform);
-};
\ No newline at end of file
+	//本帧的快速移动实体，各工作线程通过 FastMovesLock 合并
+	TArray<FCollisionFastMove> FastMoves;
+	FCriticalSection FastMovesLock;
+
+	//本帧醒来、但索引本帧因为静止标记没有更新的实体：统一空间索引中的槽位与当前位置，同样通过 FastMovesLock 合并
+	TArray<TPair<int32, FVector>> IndexResyncs;
+
+	//本轮迭代的位置修正量，按槽位索引
+	TArray<FVector3f> Corrections;
+
+	//本帧的碰撞法线，按槽位索引，用于最后把速度投影到法线平面上
+	TArray<FVector3f> HitNormals;
+
+	//槽位本帧的求解方式，由阶段一按区块写入；所在区块被 LOD 跳过（或不在 CollisionQuery 中）的槽位为 Skipped
+	enum class ESolveMode : uint8
+	{
+		Skipped,
+		Narrowphase,
+		Broadphase,
+	};
+	TArray<ESolveMode> SlotSolveModes;
+
+	//本轮被运动智能体接触到的睡眠槽位，各工作线程通过 WakeSeedsLock 合并
+	TArray<int32> WakeSeeds;
+	FCriticalSection WakeSeedsLock;
+
+	//本轮被唤醒、需要补算修正量的槽位
+	TArray<int32> WokenSlots;
+
+	//第一轮迭代前收集的接触，各工作线程通过 PendingContactsLock 合并，处理器结束时发布
+	TArray<FCollisionContact> PendingContacts;
+	FCriticalSection PendingContactsLock;
+};
+
+//静态场景碰撞处理器，在智能体之间的碰撞之后，用距离场把嵌入墙体与道具的智能体推出，每个实体每帧一次双线性采样
+UCLASS()
+class MASSENTITYCOLLISION_API UCollisionSDFProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+	UCollisionSDFProcessor();
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+	FMassEntityQuery EntityQuery;
+
+	//本帧采样时缺失的距离场瓦片，各工作线程通过 MissingTilesLock 合并
+	TArray<int32> MissingTiles;
+	FCriticalSection MissingTilesLock;
+};
@@ -0,0 +1,203 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassSubsystemBase.h"
+#include "Tasks/Task.h"
+#include "CollisionSDFSubsystem.generated.h"
+
+class FArchive;
+
+/**
+ * 静态场景的二维有符号距离场
+ *
+ * 距离场按 TileCells x TileCells 个格子切分为瓦片，每个格子存一个以厘米为单位的 int16 距离（障碍物内部为负）。
+ * 远离所有障碍物的瓦片不存储，采样时视为无穷远。烘焙结果写入 Saved/MassEntityCollision/<地图名>.sdf，
+ * 加载时只读入瓦片索引表，瓦片在智能体第一次靠近时才在工作线程上从文件中读取，读完后在子系统的 Tick 中换入，
+ * 处理器采样期间不会发生文件读写。
+ * 烘焙只依赖物理重叠测试与文件读写，可以在编辑器中、加载地图时或无头的 Linux 服务器上进行；
+ * 加载地图时的烘焙分摊到多帧，每帧的重叠测试次数有上限。
+ */
+UCLASS()
+class MASSENTITYCOLLISION_API UCollisionSDFSubsystem : public UMassTickableSubsystemBase
+{
+	GENERATED_BODY()
+
+public:
+	/** 采样结果 */
+	struct FSample
+	{
+		/** 到最近障碍物表面的距离，障碍物内部为负 */
+		float Distance = 0.f;
+
+		/** 距离增大的方向（未归一化） */
+		FVector2f Gradient = FVector2f::ZeroVector;
+	};
+
+	/**
+	 * 在 Bounds 范围内烘焙距离场并写入文件，已有数据会被替换；在当前帧内完成所有重叠测试
+	 * @param Bounds 烘焙范围，Z 方向被忽略，测试高度由控制台变量决定
+	 * @param InCellSize 格子边长
+	 * @return 没有可用的物理场景时返回false
+	 */
+	bool Bake(const FBox& Bounds, const float InCellSize);
+
+	/**
+	 * 开始分帧烘焙，每帧在 Tick 中最多做 MassEntityCollision.SDF.BakeProbeBudget 次重叠测试，完成后写入文件
+	 * @return 没有可用的物理场景时返回false
+	 * @see Bake
+	 */
+	bool BeginBake(const FBox& Bounds, const float InCellSize);
+
+	/** 是否正在分帧烘焙 */
+	bool IsBaking() const { return BakeJob.IsValid(); }
+
+	/** 控制台变量 MassEntityCollision.SDF.Enable，运行时可切换 */
+	static bool IsEnabled();
+
+	/** 是否有可用的距离场 */
+	bool HasField() const { return NumTilesX > 0 && NumTilesY > 0; }
+
+	/**
+	 * 双线性采样，一次读取相邻的4个格子同时得到距离与梯度；只读，可在多个工作线程上同时调用
+	 * @param Location 世界坐标
+	 * @param OutSample 输出采样结果
+	 * @param OutMissingTile 位置所在瓦片（或其周围）尚未读入时输出瓦片下标，否则为 INDEX_NONE
+	 * @return 位置附近有障碍物数据时返回true
+	 */
+	bool Sample(const FVector& Location, FSample& OutSample, int32& OutMissingTile) const;
+
+	/**
+	 * 请求读入瓦片及其周围一圈瓦片，使智能体跨过瓦片边界前数据已就绪；只记录请求，读取在工作线程上进行
+	 * @param TileIndices Sample 输出的缺失瓦片
+	 */
+	void StreamIn(TConstArrayView<int32> TileIndices);
+
+	/** 已读入内存的瓦片数量 */
+	int32 GetNumResidentTiles() const;
+
+protected:
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	/** 瓦片状态 */
+	enum class ETileState : uint8
+	{
+		/** 文件中有数据，尚未读入 */
+		Unloaded,
+		/** 已请求，正在工作线程上读取 */
+		Loading,
+		/** 远离所有障碍物，没有数据 */
+		Empty,
+		/** 已读入内存 */
+		Resident,
+	};
+
+	/** 烘焙的中间状态，分帧烘焙时跨帧保留 */
+	struct FBakeJob
+	{
+		FVector2f Origin = FVector2f::ZeroVector;
+		float CellSize = 25.f;
+		int32 TileCells = 32;
+		int32 NumTilesX = 0;
+		int32 NumTilesY = 0;
+		int32 NumCellsX = 0;
+		int32 NumCellsY = 0;
+
+		/** 每个格子是否被障碍物占据 */
+		TArray<uint8> Occupied;
+
+		/** 下一个要测试的格子 */
+		int32 NextCell = 0;
+	};
+
+	/** 工作线程读完的瓦片：瓦片下标与距离数据 */
+	typedef TArray<TPair<int32, TArray<int16>>> FLoadedTiles;
+
+	struct FTile
+	{
+		TArray<int16> Distances;
+
+		/** 文件中的偏移 */
+		int64 FileOffset = INDEX_NONE;
+
+		ETileState State = ETileState::Empty;
+
+		/** 周围一圈瓦片是否已经请求过 */
+		bool bNeighborsRequested = false;
+	};
+
+	/** 烘焙文件路径 */
+	FString GetBakePath() const;
+
+	/** 写出文件头、索引表与所有非空瓦片 */
+	bool Save();
+
+	/** 读入文件头与索引表，瓦片保持未读入状态 */
+	bool LoadIndex();
+
+	/** 换入已读完的瓦片，并为新的请求启动读取任务 */
+	void UpdateStreaming();
+
+	/**
+	 * 对烘焙范围内的格子做重叠测试
+	 * @param Job 烘焙状态
+	 * @param MaxProbes 本次最多的测试次数
+	 * @return 所有格子都测试完时返回true
+	 */
+	bool ProbeCells(FBakeJob& Job, const int32 MaxProbes) const;
+
+	/** 计算距离变换、切分瓦片并写入文件 */
+	bool FinishBake(const FBakeJob& Job);
+
+	/** 等待正在进行的瓦片读取结束并丢弃结果 */
+	void CancelStreaming();
+
+	/** 文件头与索引表的序列化，读写共用 */
+	void SerializeHeader(FArchive& Ar);
+
+	/** 读取格子的距离，所在瓦片不在内存中时返回 MaxDistance */
+	float GetCellDistance(const int32 CellX, const int32 CellY) const;
+
+	/** 距离场原点（第一个格子的最小角） */
+	FVector2f Origin = FVector2f::ZeroVector;
+
+	float CellSize = 25.f;
+
+	/** 瓦片边长（格子数） */
+	int32 TileCells = 32;
+
+	int32 NumTilesX = 0;
+	int32 NumTilesY = 0;
+
+	/** 距离的上限，超过该值的格子视为远离障碍物 */
+	float MaxDistance = 0.f;
+
+	TArray<FTile> Tiles;
+
+	/** 按需读取瓦片的文件句柄，读取任务运行期间只由该任务使用 */
+	TUniquePtr<FArchive> TileReader;
+
+	/** 等待读取的瓦片 */
+	TArray<int32> RequestedTiles;
+
+	/** 正在工作线程上读取瓦片的任务 */
+	UE::Tasks::TTask<FLoadedTiles> TileLoadTask;
+
+	/** 正在进行的分帧烘焙 */
+	TUniquePtr<FBakeJob> BakeJob;
+};
+
+
+template<>
+struct TMassExternalSubsystemTraits<UCollisionSDFSubsystem> final
+{
+	enum
+	{
+		GameThreadOnly = false
+	};
+};
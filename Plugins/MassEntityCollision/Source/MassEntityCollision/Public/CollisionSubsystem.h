@@ -6,25 +6,237 @@
 #include "HierarchicalHashGrid2D.h"
 #include "MassEntityHandle.h"
 #include "MassEntityTypes.h"
+#include "MassSpatialIndexSubsystem.h"
 #include "MassSubsystemBase.h"
 #include "Subsystems/WorldSubsystem.h"
 #include "CollisionSubsystem.generated.h"
 
 
 
+class UCollisionSubsystem;
 class UMassEntityConfigAsset;
+struct FMassEntityManager;
 
 /*
-* ģTHierarchicalHashGrid2Dͨtypedefһֲϣ
-* 2 ʾϣάȣ㼶
-4 ʾϣĲϲĵԪߴ² 4 ²㵥ԪСΪ 100 λʱϲΪ 400 λ
-FMassEntityHandle ʾϣд洢ʵ
-* 
+* 基于模板THierarchicalHashGrid2D，通过typedef定义了一个分层哈希网格
+* 2 表示哈希网格的维度（层级），
+4 表示哈希网格的层数，即上层网格的单元格尺寸是下层的 4 倍（如下层单元格大小为 100 单位时，上层为 400 单位）。
+int32 表示哈希网格中存储的是槽位下标。
+* 运行时的碰撞查询使用统一空间索引，这里的网格只用于基准测试中的本地网格。
 */
-typedef THierarchicalHashGrid2D<2, 4, FMassEntityHandle> FHashGridExample;
+typedef THierarchicalHashGrid2D<2, 4, int32> FHashGridExample;
+
+/** 碰撞阶段发现的一次接触 */
+struct FCollisionContact
+{
+	FMassEntityHandle EntityA;
+	FMassEntityHandle EntityB;
+
+	/** 两个实体在 UCollisionSubsystem::SlotStore 中的槽位，SlotA 总是较小的一个 */
+	int32 SlotA = INDEX_NONE;
+	int32 SlotB = INDEX_NONE;
+
+	/** 由 B 指向 A 的分离方向，Z 为0 */
+	FVector3f Normal = FVector3f::ZeroVector;
+
+	/** 穿透深度 */
+	float Depth = 0.f;
+};
+
+/**
+ * 碰撞实体的紧凑数据，按槽位以 SoA 形式存储位置与半径
+ *
+ * 实体加入碰撞系统时分配一个固定槽位，移除时归还；统一空间索引的查询结果会被映射为这里的槽位下标。
+ * 每帧开始时顺带写入位置，邻居检测只需读取连续的 float 数组，不再逐个通过实体句柄查找片段。
+ */
+struct MASSENTITYCOLLISION_API FCollisionSlotStore
+{
+	/** 分配槽位，优先复用已归还的槽位 */
+	int32 Allocate(const FMassEntityHandle Entity);
+
+	/** 归还槽位 */
+	void Free(const int32 Slot);
+
+	/** 槽位总数（含空闲槽位） */
+	int32 Num() const { return Entities.Num(); }
+
+	void SetLocation(const int32 Slot, const FVector& Location)
+	{
+		X[Slot] = static_cast<float>(Location.X);
+		Y[Slot] = static_cast<float>(Location.Y);
+		Z[Slot] = static_cast<float>(Location.Z);
+	}
+
+	/**
+	 * 计算槽位与一组邻居的重叠，返回把重叠部分向外推开所需的修正量；只读，可在多个工作线程上同时调用
+	 * @param Slot 当前槽位
+	 * @param Neighbors 可能重叠的邻居槽位
+	 * @param OutHitNormal 输出穿透最深（深度相同时槽位最小）的邻居的分离方向，与邻居的顺序无关；无重叠时保持不变
+	 * @param OutNumOverlaps 不为空时输出重叠的邻居数量；相反方向的重叠可能互相抵消，修正量为零不代表没有接触
+	 */
+	FVector3f ResolveOverlaps(const int32 Slot, TConstArrayView<int32> Neighbors, FVector3f& OutHitNormal, int32* OutNumOverlaps = nullptr) const;
+
+	/** 两个槽位的距离是否小于半径之和加上 Margin */
+	bool AreTouching(const int32 Slot, const int32 Other, const float Margin = 0.f) const
+	{
+		const float DX = X[Slot] - X[Other];
+		const float DY = Y[Slot] - Y[Other];
+		const float DZ = Z[Slot] - Z[Other];
+		return DX * DX + DY * DY + DZ * DZ < FMath::Square(Radius[Slot] + Radius[Other] + Margin);
+	}
+
+	bool IsSleeping(const int32 Slot) const { return Sleeping[Slot] != 0; }
+
+	/** 唤醒槽位并清零静止帧数 */
+	void Wake(const int32 Slot)
+	{
+		Sleeping[Slot] = 0;
+		StillFrames[Slot] = 0;
+	}
+
+	/**
+	 * 只用包围盒做分离：沿穿透较浅的轴各推开一半，不计算距离与法线，用于远处的智能体
+	 * @param Slot 当前槽位
+	 * @param Neighbors 可能重叠的邻居槽位
+	 * @param OutHitNormal 输出穿透最深（深度相同时槽位最小）的邻居的分离轴，无重叠时保持不变
+	 */
+	FVector3f ResolveOverlapsBroadphase(const int32 Slot, TConstArrayView<int32> Neighbors, FVector3f& OutHitNormal, int32* OutNumOverlaps = nullptr) const;
+
+	/**
+	 * 把槽位与邻居的重叠写成接触，槽位对按下标从小到大排列
+	 * @param Slot 当前槽位
+	 * @param Neighbors 可能重叠的邻居槽位
+	 * @param bOnlyLowerSlot 为true时只输出 Slot 较小的一侧，以及与睡眠邻居的接触，避免双方各输出一次
+	 * @param OutContacts 追加输出的接触
+	 */
+	void GatherContacts(const int32 Slot, TConstArrayView<int32> Neighbors, const bool bOnlyLowerSlot, TArray<FCollisionContact>& OutContacts) const;
+
+	/** 逐个邻居计算的标量版本，用于不支持向量指令的平台和邻居数量很少的情况 */
+	FVector3f ResolveOverlapsScalar(const int32 Slot, TConstArrayView<int32> Neighbors, FVector3f& OutHitNormal, int32* OutNumOverlaps = nullptr) const;
+
+	/** 每次处理4个邻居的向量版本，同时计算穿透深度与法线并累加推出量 */
+	FVector3f ResolveOverlapsSimd(const int32 Slot, TConstArrayView<int32> Neighbors, FVector3f& OutHitNormal, int32* OutNumOverlaps = nullptr) const;
+
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+	TArray<float> Radius;
+
+	/** 连续静止的帧数，达到阈值后进入睡眠 */
+	TArray<uint16> StillFrames;
+
+	/** 睡眠中的槽位不作为查询源参与碰撞求解，只在被运动的智能体接触时唤醒 */
+	TArray<uint8> Sleeping;
+
+	/** 所有槽位中的最大半径，决定邻居查询需要扩展的范围 */
+	float MaxRadius = 0.f;
+
+	/** 槽位所属的实体，空闲槽位为无效句柄 */
+	TArray<FMassEntityHandle> Entities;
+
+	TArray<int32> FreeSlots;
+};
 
 /**
- * ̳UMassSubsystemBase Mass µϵͳ磨Worldڹҿɱ Mass ʡ
+ * 持久的邻居缓存
+ *
+ * 每个槽位缓存一份候选邻居，查询范围比碰撞需要的范围多出 2 倍 Margin。槽位相对缓存时的位置偏移不超过 Margin/2 时，
+ * 两个都未刷新的槽位之间的相对位移不超过 1.5 倍 Margin，不在列表中的实体不可能进入重叠范围，
+ * 因此每帧只需重新查询移动较多（或半径变化、新加入）的槽位。列表始终保持对称，刷新的槽位会把自己加入新邻居的列表。
+ * 每个列表按槽位下标升序排列，与网格查询返回的顺序无关。
+ */
+struct MASSENTITYCOLLISION_API FCollisionContactCache
+{
+	/**
+	 * 重新查询移动超过 Margin/2 的槽位，其余槽位沿用上一帧的列表
+	 * @param CollisionSubsystem 本帧已写入位置的槽位存储，以及查询空间索引的入口
+	 * @param Margin 迟滞距离，越大刷新越少、候选邻居越多
+	 */
+	void Refresh(const UCollisionSubsystem& CollisionSubsystem, const float Margin);
+
+	/** 槽位被归还时从所有邻居的列表中移除 */
+	void Remove(const int32 Slot);
+
+	/** 缓存的候选邻居，不含自身，按槽位升序 */
+	TConstArrayView<int32> GetContacts(const int32 Slot) const { return Contacts[Slot]; }
+
+	/** 缓存中的邻居对数量 */
+	int32 GetNumPairs() const { return NumPairs; }
+
+	/** 最近一次刷新重新查询的槽位数量 */
+	int32 GetNumRefreshed() const { return RefreshSlots.Num(); }
+
+	/** 最近一次刷新时在用的槽位数量 */
+	int32 GetNumLiveSlots() const { return NumLiveSlots; }
+
+private:
+	/** 从有序列表中移除槽位 */
+	static void RemoveSorted(TArray<int32>& SlotContacts, const int32 Slot);
+
+	/** 把有序的槽位归并到有序列表中并去重 */
+	void MergeSorted(TArray<int32>& SlotContacts, TConstArrayView<int32> Slots);
+
+	TArray<TArray<int32>> Contacts;
+
+	/** 缓存列表时的位置与半径 */
+	TArray<FVector3f> Anchors;
+	TArray<float> AnchorRadius;
+
+	/** 列表是否有效，新分配或归还的槽位为0 */
+	TArray<uint8> Valid;
+
+	TArray<int32> RefreshSlots;
+
+	/** 刷新后需要加回的 (邻居, 刷新的槽位) */
+	TArray<FIntPoint> AddBackPairs;
+	TArray<int32> AddBackSlots;
+	TArray<int32> MergeScratch;
+
+	float CachedMargin = -1.f;
+	int32 NumPairs = 0;
+	int32 NumLiveSlots = 0;
+};
+
+/**
+ * 每帧的接触事件
+ *
+ * UCollisionProcessor 在第一轮迭代前（即本帧移动后、推开前）收集所有重叠的实体对，排序去重后在处理器结束时发布，
+ * 直到下一帧的 UCollisionProcessor 运行前保持不变。需要知道“谁碰到了谁”的处理器只需声明对 UCollisionSubsystem 的
+ * 只读依赖并排在 UCollisionProcessor 之后，就可以在多个线程上同时读取，不必再各自查询空间索引。
+ */
+struct MASSENTITYCOLLISION_API FCollisionContactEvents
+{
+	/** 替换为本帧的接触，按槽位对排序并去掉重复 */
+	void Publish(TArray<FCollisionContact>&& InContacts);
+
+	TConstArrayView<FCollisionContact> GetContacts() const { return Contacts; }
+
+	/**
+	 * 按标签筛选接触，输出中 EntityA 带有 TagA、EntityB 带有 TagB（法线随之翻转）
+	 * @param EntityManager 用于查询实体所在原型的标签
+	 * @param TagA A 方需要的标签，为空时不限
+	 * @param TagB B 方需要的标签，为空时不限
+	 * @param OutContacts 追加输出的接触
+	 */
+	void Filter(const FMassEntityManager& EntityManager, const UScriptStruct* TagA, const UScriptStruct* TagB, TArray<FCollisionContact>& OutContacts) const;
+
+	template<typename TTagA, typename TTagB = void>
+	void Filter(const FMassEntityManager& EntityManager, TArray<FCollisionContact>& OutContacts) const
+	{
+		const UScriptStruct* TagB = nullptr;
+		if constexpr (!std::is_void_v<TTagB>)
+		{
+			TagB = TTagB::StaticStruct();
+		}
+		Filter(EntityManager, TTagA::StaticStruct(), TagB, OutContacts);
+	}
+
+private:
+	TArray<FCollisionContact> Contacts;
+};
+
+/**
+ * 继承自UMassSubsystemBase，表明这是 Mass 框架下的子系统，会随世界（World）生命周期管理，且可被 Mass 处理器访问。
  */
 UCLASS()
 class MASSENTITYCOLLISION_API UCollisionSubsystem : public UMassSubsystemBase
@@ -32,11 +244,71 @@ class MASSENTITYCOLLISION_API UCollisionSubsystem : public UMassSubsystemBase
 	GENERATED_BODY()
 	
 public:
-	//ʵĹϣ󣬹100ʾײĵԪСΪ 100 λףʵĿռ洢
-	FHashGridExample HashGridData = FHashGridExample(100);
+	//碰撞实体在统一空间索引中的图层名
+	static const FName LayerName;
+
+	//各碰撞槽位的紧凑位置与半径
+	FCollisionSlotStore SlotStore;
+
+	//统一空间索引槽位到 SlotStore 槽位的映射，由 UCollisionProcessor 每帧写入，不属于碰撞图层的槽位内容无意义
+	TArray<int32> IndexToCollisionSlot;
+
+	//跨帧保留的候选邻居
+	FCollisionContactCache ContactCache;
+
+	//本帧的接触事件，供其他处理器只读消费
+	FCollisionContactEvents ContactEvents;
+
+	/**
+	 * 在统一空间索引中查询与范围重叠的碰撞实体；只读，可在多个工作线程上同时调用
+	 * @param Bounds 查询范围
+	 * @param OutSlots 追加输出的 SlotStore 槽位
+	 */
+	void QueryGrid(const FBox& Bounds, TArray<int32>& OutSlots) const;
+
+	/**
+	 * 获取可能与槽位重叠的邻居（不含自身），只读，可在多个工作线程上同时调用
+	 * @param Slot 当前槽位
+	 * @param bUseContactCache 为true时直接返回缓存的列表，否则查询空间索引
+	 * @param Scratch 查询网格时使用的临时数组
+	 */
+	TConstArrayView<int32> QueryNeighbors(const int32 Slot, const bool bUseContactCache, TArray<int32>& Scratch) const;
+
+	/**
+	 * 把槽位从 Start 分步移向 End，在第一次明显并且越来越深地嵌入其他实体之前停下，用于一帧移动超过自身半径的实体；只读
+	 * @param Slot 移动的槽位，索引中它自身的条目会被忽略
+	 * @param Start 上一帧求解后的位置
+	 * @param End 本帧移动后的位置
+	 * @param MaxSteps 最多的分步数，每步不超过半径的一半，更长的位移被截断
+	 * @return 停下的位置，途中没有碰到其他实体并且没有被截断时返回 End
+	 */
+	FVector3f SweepToFirstContact(const int32 Slot, const FVector3f& Start, const FVector3f& End, const int32 MaxSteps) const;
+
+	/**
+	 * 唤醒与种子槽位接触的整组睡眠实体
+	 *
+	 * 从种子出发，沿互相接触（距离小于半径之和加 ContactMargin）的睡眠邻居扩散，
+	 * 整个睡眠分组一起唤醒，避免推挤在静止人群中逐帧传递。
+	 *
+	 * @param Seeds 被运动智能体接触到的睡眠槽位
+	 * @param ContactMargin 判定两个睡眠实体属于同一分组的额外距离
+	 * @param OutWoken 输出本次被唤醒的槽位
+	 */
+	void WakeIslands(TConstArrayView<int32> Seeds, const float ContactMargin, TArray<int32>& OutWoken);
 
 	UFUNCTION(BlueprintCallable)
 	void SpawnEntities(const FVector& Location, int Count, UMassEntityConfigAsset* EntityConfig);
+
+	UMassSpatialIndexSubsystem* GetSpatialIndex() const { return SpatialIndex; }
+
+protected:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+private:
+	UPROPERTY(Transient)
+	TObjectPtr<UMassSpatialIndexSubsystem> SpatialIndex;
+
+	FMassSpatialIndexLayerMask LayerMask = 0;
 };
 
 
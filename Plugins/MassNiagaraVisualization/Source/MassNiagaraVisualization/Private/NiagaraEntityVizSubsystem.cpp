@@ -24,83 +24,83 @@ FSharedStruct UNiagaraEntityVizSubsystem::GetOrCreateSharedNiagaraFragmentForSys
     UStaticMesh* StaticMeshOverride, UMaterialInterface* MaterialOverride)
 {
 	/**
- * ܣ Niagara ϵͳ̬Ͳʵãһ Niagara ӻ Actor
- *           ضӦĹṹƬΡ
+ * 函数功能：根据 Niagara 系统、静态网格和材质的配置，创建或复用一个共享的 Niagara 可视化 Actor，
+ *           并返回对应的共享结构体片段。
  *
- * ˵
- * - NiagaraSystem: ָҪʹõ Niagara ϵͳʲָ룬Ϊա
- * - StaticMeshOverride: ѡľ̬Դڸ Niagara ϵͳеĬ
- * - MaterialOverride: ѡĲԴڸǾ̬Ĭϲʡ
+ * 参数说明：
+ * - NiagaraSystem: 指向要使用的 Niagara 系统资产的指针，不能为空。
+ * - StaticMeshOverride: 可选的静态网格资源，用于覆盖 Niagara 系统中的默认网格。
+ * - MaterialOverride: 可选的材质资源，用于覆盖静态网格的默认材质。
  *
- * ֵ˵
- * - һ FSharedNiagaraSystemFragment ṹ壬õ Niagara Actor á
+ * 返回值说明：
+ * - 返回一个 FSharedNiagaraSystemFragment 结构体，包含对所创建或复用的 Niagara Actor 的引用。
  *
- * ߼˵
- * 1.  Niagara ϵͳ·ɻϣ
- * 2.  StaticMeshOverride  MaterialOverride¹ϣֲֵͬã
- * 3. ѯǷͬõ Actor ڣֱӸã
- * 4. 򴴽µ Niagara ӻ Actor
- * 5. ´ Actor ãͨ MassManager ȡṹ巵ء
+ * 逻辑说明：
+ * 1. 根据 Niagara 系统路径名生成基础哈希；
+ * 2. 若存在 StaticMeshOverride 或 MaterialOverride，则更新哈希值以区分不同配置；
+ * 3. 查询是否已有相同配置的 Actor 存在，若存在则直接复用；
+ * 4. 否则创建新的 Niagara 可视化 Actor，并设置相关组件参数；
+ * 5. 将新创建的 Actor 缓存起来供后续复用，并通过 MassManager 获取共享结构体返回。
  */
 
     uint32 NiagaraAssetHash = GetTypeHash(NiagaraSystem->GetPathName());
     uint32 ParamsHash = NiagaraAssetHash;
 
-    // ָ˾̬񸲸ǣ FName ϣ Niagara ʲϣ
+    // 如果指定了静态网格覆盖，则将其 FName 哈希与 Niagara 资产哈希组合
     if (StaticMeshOverride)
     {
 	   ParamsHash = HashCombineFast(NiagaraAssetHash, GetTypeHash(StaticMeshOverride->GetFName()));
     }
 
-    // ָ˲ʸǣ FName ϣ Niagara ʲϣ
+    // 如果指定了材质覆盖，则将其 FName 哈希与 Niagara 资产哈希组合
     if (MaterialOverride)
     {
        ParamsHash = HashCombineFast(NiagaraAssetHash, GetTypeHash(MaterialOverride->GetFName()));
     }
 
     /**
- * ܣݲϣֵһ򴴽NiagaraϵͳƬ
+ * 函数功能：根据参数哈希值查找或创建共享的Niagara系统片段
  * 
- * ˵
- *   ParamsHash - ڱʶԤڹNiagaraԱĹϣֵ
+ * 参数说明：
+ *   ParamsHash - 用于标识预存在共享Niagara演员的哈希值参数
  * 
- * ֵ˵
- *   һFSharedNiagaraSystemFragment͵ĹƬζ
+ * 返回值说明：
+ *   返回一个FSharedNiagaraSystemFragment类型的共享片段对象
  * 
- * 
- *   ȴһĬϵĹNiagaraϵͳƬζȻĲϣֵ
- *   ǷԤڵĹNiagaraԱСڣͨMassManagerȡ
- *   򴴽ӦĹƬβء
+ * 功能描述：
+ *   首先创建一个默认的共享Niagara系统片段对象，然后检查给定的参数哈希值
+ *   是否在预存在的共享Niagara演员集合中。如果存在，则通过MassManager获取
+ *   或创建对应的共享片段并返回。
  */
 
-    // ĬϵĹNiagaraϵͳƬζ
+    // 创建默认的共享Niagara系统片段对象
     FSharedNiagaraSystemFragment SharedStructToReturn = FSharedNiagaraSystemFragment();
 
     
-    // ϣֵǷԤڵĹNiagaraԱ
+    // 检查参数哈希值是否存在于预存在的共享Niagara演员集合中
     if (PreexistingSharedNiagaraActors.Contains(ParamsHash))
     {
-	   // ڣͨMassManagerȡ򴴽Ƭβ
+	   // 如果存在，则通过MassManager获取或创建共享片段并返回
 	   return MassManager->GetOrCreateSharedFragment<FSharedNiagaraSystemFragment>(SharedStructToReturn);
     }
 
-    //  Actor ɲΪʱ
+    // 配置 Actor 的生成参数，标记为临时对象
        FActorSpawnParameters SpawnParams;
        SpawnParams.ObjectFlags = RF_Transient | RF_DuplicateTransient;
 
-    // µ Niagara ӻ Actor
+    // 生成新的 Niagara 可视化 Actor
        ANiagaraEntityVizActor* NewNiagaraActor = GetWorld()->SpawnActor<ANiagaraEntityVizActor>(SpawnParams);
 
-    //  Niagara ĸΪͰ󶨵ʲ
+    // 设置 Niagara 组件的更新行为和绑定的资产
        NewNiagaraActor->GetNiagaraComponent()->SetTickBehavior(ENiagaraTickBehavior::ForceTickLast);
        NewNiagaraActor->GetNiagaraComponent()->SetAsset(NiagaraSystem);
 
-    // ṩ˾̬񸲸ǣ Niagara жӦı
+    // 如果提供了静态网格覆盖，则设置 Niagara 中对应的变量
     if (StaticMeshOverride)
     {
 	   NewNiagaraActor->GetNiagaraComponent()->SetVariableStaticMesh("StaticMeshToRender", StaticMeshOverride);
 
-	   // òʱʹ MaterialOverrideʹ StaticMesh ĵһ
+	   // 设置材质变量：优先使用 MaterialOverride，否则使用 StaticMesh 的第一个材质
 	   if (MaterialOverride)
 	   {
 		NewNiagaraActor->GetNiagaraComponent()->SetVariableMaterial("StaticMeshMaterial", MaterialOverride);
@@ -111,12 +111,12 @@ FSharedStruct UNiagaraEntityVizSubsystem::GetOrCreateSharedNiagaraFragmentForSys
 	   }
     }
 
-    // ´ Niagara Actor ֵṹ
+    // 将新创建的 Niagara Actor 赋值给共享结构体
     SharedStructToReturn.NiagaraManagerActor = NewNiagaraActor;
 
-    //  Actor 浽ӳԱ
+    // 将该 Actor 缓存到映射表中以便后续复用
     PreexistingSharedNiagaraActors.FindOrAdd(ParamsHash, NewNiagaraActor);
 
-    // ͨ MassManager ȡ򴴽ṹ岢
+    // 通过 MassManager 获取或创建共享结构体并返回
     return MassManager->GetOrCreateSharedFragment<FSharedNiagaraSystemFragment>(SharedStructToReturn);
 }
@@ -9,17 +9,17 @@
 
 class ANiagaraEntityVizActor;
 /**
- * @brief FMSRepresentationFragmentsṹڹNiagaraϵͳĿӻʾƬ
+ * @brief FMSRepresentationFragments结构体用于管理Niagara粒子系统的可视化表示片段
  * 
- * ýṹ̳FMassSharedFragmentڴ洢͹ģʵλá
- * ͶݣNiagaraӻϵͳʹá
+ * 该结构体继承自FMassSharedFragment，用于存储和管理大规模实体的粒子位置、
+ * 方向和动画索引数据，供Niagara可视化系统使用。
  * 
- * Ҫܰ
- * - 洢λ
- * - 洢ӷ  
- * - 洢
- * - άNiagaraActor
- * - ¼ƫ
+ * 主要功能包括：
+ * - 存储粒子位置数组
+ * - 存储粒子方向数组  
+ * - 存储动画索引数组
+ * - 维护Niagara管理器Actor引用
+ * - 记录迭代偏移量
  */
 USTRUCT()
 struct MASSNIAGARAVISUALIZATION_API FSharedNiagaraSystemFragment : public FMassSharedFragment
@@ -27,61 +27,61 @@ struct MASSNIAGARAVISUALIZATION_API FSharedNiagaraSystemFragment : public FMassS
 	GENERATED_BODY()
 
 	/**
-	 * @brief NiagaraӻActorָ
+	 * @brief Niagara可视化管理器Actor的弱引用指针
 	 * 
-	 * ú͹NiagaraϵͳʵӻActor
+	 * 用于引用和管理Niagara粒子系统的实体可视化Actor
 	 */
 	UPROPERTY(EditAnywhere)
 	TWeakObjectPtr<ANiagaraEntityVizActor> NiagaraManagerActor;
 
 	/**
-	 * @brief ƫڼ㵱ǰʵʼλ
+	 * @brief 迭代偏移量，用于计算当前处理的实体批次起始位置
 	 * 
-	 * ڴģʵ崦Уڷʵݵƫ
+	 * 在大规模实体处理中，用于分批处理实体数据的偏移索引
 	 */
 	int32 IterationOffset = 0;
 
 	/**
-	 * @brief λòNiagaraϵͳеĲ
+	 * @brief 粒子位置参数在Niagara系统中的参数名称
 	 * 
-	 * ̬˴ݸNiagaraϵͳλݲ
+	 * 静态常量，定义了传递给Niagara系统的粒子位置数据参数名
 	 */
 	inline static FName ParticlePositionName = "MassParticlePosition";
 
 	/**
-	 * @brief λ
+	 * @brief 粒子位置数组
 	 * 
-	 * 洢ʵռеλ
+	 * 存储所有实体粒子在世界空间中的位置坐标
 	 */
 	UPROPERTY()
 	TArray<FVector> ParticlePositions;
 
 	/**
-	 * @brief ӷNiagaraϵͳеĲ
+	 * @brief 粒子方向参数在Niagara系统中的参数名称
 	 * 
-	 * ̬˴ݸNiagaraϵͳӷݲ
+	 * 静态常量，定义了传递给Niagara系统的粒子方向数据参数名
 	 */
 	inline static FName ParticleOrientationsParameterName = "MassParticleOrientations";
 
 	/**
-	 * @brief ӷ
+	 * @brief 粒子方向数组
 	 * 
-	 * 洢ʵӵԪϢ
+	 * 存储所有实体粒子的四元数方向信息
 	 */
     UPROPERTY()
 	TArray<FQuat4f> ParticleOrientations;
 
 	/**
-	 * @brief NiagaraϵͳеĲ
+	 * @brief 动画索引参数在Niagara系统中的参数名称
 	 * 
-	 * ̬˴ݸNiagaraϵͳĶݲ
+	 * 静态常量，定义了传递给Niagara系统的动画索引数据参数名
 	 */
 	inline static FName AnimationIndexesParameterName = "MassAnimationIndexes";
 
 	/**
-	 * @brief 
+	 * @brief 动画索引数组
 	 * 
-	 * 洢ÿʵӦĶֵڿNiagaraӵĶ״̬
+	 * 存储每个实体对应的动画索引值，用于控制Niagara粒子的动画状态
 	 */
 	UPROPERTY()
     TArray<uint8> AnimationIndexes;
@@ -6,24 +6,24 @@
 #include "MassEntityTemplateRegistry.h"
 
 /**
- * @brief ʵģ壬ӳ־ûصƬκͱǩ
+ * @brief 构建实体模板，添加持久化数据相关的片段和标签
  * 
- * úʵģ幹ӳ־ûĹƬΡ
- * ǩͱ任ƬΣȷʵ߱־û洢
+ * 该函数用于在实体模板构建过程中添加持久化数据所需的共享片段、
+ * 标签和变换片段，确保实体具备持久化存储能力
  * 
- * @param BuildContext ʵģ幹ģӸƬκͱǩ
- * @param World ǰڻȡʵ
+ * @param BuildContext 实体模板构建上下文，用于添加各种片段和标签
+ * @param World 当前世界对象，用于获取实体管理器
  */
 void UPersistentDataTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
 {
-	// ȡӦʵʵ
+	// 获取世界对应的实体管理器实例
 	FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
 
-	// ȡ־ûݹƬΣӵ
+	// 创建或获取持久化数据共享片段，并添加到构建上下文中
 	FConstSharedStruct ParamsFragment = EntityManager.GetOrCreateConstSharedFragment(PersistentDataFragment);
 	BuildContext.AddConstSharedFragment(ParamsFragment);
 
-	// ӳ־ûݱǩͱ任Ƭεʵģ
+	// 添加持久化数据标签和变换片段到实体模板中
 	BuildContext.AddTag<FPersistentDataTag>();
 	BuildContext.AddFragment<FPersistentTransformFragment>();
 
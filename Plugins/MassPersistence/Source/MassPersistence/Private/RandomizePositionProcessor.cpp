@@ -9,9 +9,9 @@
 #include "MassPersistentDataSubsystem.h"
 
 /**
- * @brief URandomizePositionProcessor๹캯
+ * @brief URandomizePositionProcessor类构造函数
  * 
- * ʼEntityQueryԱ󶨵ǰʵ
+ * 初始化EntityQuery成员变量，将其绑定到当前实例
  */
 URandomizePositionProcessor::URandomizePositionProcessor()
 	: EntityQuery(*this)
@@ -19,11 +19,11 @@ URandomizePositionProcessor::URandomizePositionProcessor()
 }
 
 /**
- * @brief ʵѯƬҪ
+ * @brief 配置实体查询所需的片段要求
  * 
- * @param EntityManager ʵĹãڹʵƬ
+ * @param EntityManager 实体管理器的共享引用，用于管理实体和片段
  * 
- * úEntityQueryҪFTransformFragmentƬΣָΪдȨ
+ * 该函数设置EntityQuery需要访问FTransformFragment片段，并指定为读写权限
  */
 void URandomizePositionProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
@@ -31,41 +31,41 @@ void URandomizePositionProcessor::ConfigureQueries(const TSharedRef<FMassEntityM
 }
 
 /**
- * @brief ʵźţʵλ
+ * @brief 处理实体信号，随机化实体位置
  * 
- * @param EntityManager ʵãڹʵ
- * @param Context ִãṩִлϢ
- * @param EntitySignals ʵźŲãڴźز
+ * @param EntityManager 实体管理器引用，用于管理实体
+ * @param Context 执行上下文引用，提供执行环境信息
+ * @param EntitySignals 实体信号查找引用，用于处理信号相关操作
  * 
- * úʵ飬Ϊÿʵλ
- * XY-20002000ΧɣZ̶Ϊ0
+ * 该函数遍历所有实体块，为每个实体设置随机位置坐标
+ * X和Y坐标在-2000到2000范围内随机生成，Z坐标固定为0
  */
 void URandomizePositionProcessor::SignalEntities(FMassEntityManager& EntityManager, FMassExecutionContext& Context,
 	FMassSignalNameLookup& EntitySignals)
 {
 	EntityQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
 		{
-			// ȡɱı任Ƭͼ
+			// 获取可变的变换片段视图
 			const auto TransformFragments = Context.GetMutableFragmentView<FTransformFragment>();
 
-			// ǰеʵ
+			// 遍历当前块中的所有实体
 			const int32 NumEntities = Context.GetNumEntities();
 			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
 			{
 				auto& TransformFragment = TransformFragments[EntityIdx];
-				// ΪʵλãXY-20002000֮䣬ZΪ0
+				// 为实体设置随机位置，X和Y坐标在-2000到2000之间，Z坐标为0
 				TransformFragment.GetMutableTransform().SetLocation(FVector(FMath::RandRange(-2000, 2000), FMath::RandRange(-2000, 2000), 0.f));
 			}
 		});
 }
 
 /**
- * @brief ʼڲ״̬
+ * @brief 初始化处理器内部状态
  * 
- * @param Owner ӵд˴UObject
- * @param EntityManager ʵĹ
+ * @param Owner 拥有此处理器的UObject对象引用
+ * @param EntityManager 实体管理器的共享引用
  * 
- * úλźţøʼ
+ * 该函数订阅随机化位置信号，并调用父类初始化函数
  */
 void URandomizePositionProcessor::InitializeInternal(UObject& Owner, const TSharedRef<FMassEntityManager>& EntityManager)
 {
@@ -7,7 +7,7 @@
 #include "MassEntityDataProcessor.generated.h"
 
 /**
- * ôӦSaveEntityźţлʵƬݣ FPersistentTransformFragment FEntitySaveData
+ * 该处理器用于响应SaveEntity信号，序列化实体碎片数据（如 FPersistentTransformFragment）到 FEntitySaveData。
  */
 UCLASS()
 class MASSPERSISTENCE_API UPersistEntityDataProcessor : public UMassSignalProcessorBase
@@ -26,7 +26,7 @@ private:
 	GENERATED_BODY()
 };
 
-//Ӧ EntityLoaded źţغָʵ任õ״̬
+//响应 EntityLoaded 信号，加载后恢复实体变换、配置等状态。
 UCLASS()
 class MASSPERSISTENCE_API UPersistentDataPostLoadProcessor : public UMassSignalProcessorBase
 {
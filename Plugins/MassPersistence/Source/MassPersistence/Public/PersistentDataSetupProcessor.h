@@ -9,7 +9,7 @@
 /**
  * 
  */
- // ʵ崴¼Ϊ FPersistentDataTag ʵӵϵͳĹб
+ // 监听实体创建事件，为带 FPersistentDataTag 的实体添加到子系统的管理列表。
 UCLASS()
 class UPersistentDataInitializerProcessor : public UMassObserverProcessor
 {
@@ -26,7 +26,7 @@ private:
 	GENERATED_BODY()
 };
 
-// ʵ¼ӹбƳʵ塣
+// 监听实体销毁事件，从管理列表移除实体。
 UCLASS()
 class UPersistentDataDestructorProcessor : public UMassObserverProcessor
 {
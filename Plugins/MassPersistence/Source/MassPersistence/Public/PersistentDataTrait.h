@@ -13,7 +13,7 @@
 
 
 
-//洢ʵϢ
+//存储实体配置信息
 USTRUCT()
 struct FPersistentDataFragment : public FMassConstSharedFragment
 {
@@ -23,7 +23,7 @@ struct FPersistentDataFragment : public FMassConstSharedFragment
 	TSoftObjectPtr<UMassEntityConfigAsset> EntityConfig;
 };
 
-//Ҫ־ûʵ
+//标记需要持久化的实体
 USTRUCT()
 struct FPersistentDataTag : public FMassTag
 {
@@ -31,7 +31,7 @@ struct FPersistentDataTag : public FMassTag
 
 };
 
-//¼ʵҪ־ûı任λã
+//记录实体需要持久化的变换（位置）数据
 USTRUCT()
 struct FPersistentTransformFragment : public FMassFragment
 {
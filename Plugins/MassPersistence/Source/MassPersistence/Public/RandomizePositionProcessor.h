@@ -9,7 +9,7 @@
 
 
 /**
- * ԣӦ RandomizePositions źţʵλ
+ * 测试，响应 RandomizePositions 信号，随机化实体位置
  */
 UCLASS()
 class MASSPERSISTENCE_API URandomizePositionProcessor : public UMassSignalProcessorBase
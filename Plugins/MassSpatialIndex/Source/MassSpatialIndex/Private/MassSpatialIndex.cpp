@@ -0,0 +1,20 @@
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MassSpatialIndex.h"
+
+#define LOCTEXT_NAMESPACE "FMassSpatialIndexModule"
+
+void FMassSpatialIndexModule::StartupModule()
+{
+	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+}
+
+void FMassSpatialIndexModule::ShutdownModule()
+{
+	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
+	// we call this function before unloading the module.
+}
+
+#undef LOCTEXT_NAMESPACE
+	
+IMPLEMENT_MODULE(FMassSpatialIndexModule, MassSpatialIndex)
\ No newline at end of file
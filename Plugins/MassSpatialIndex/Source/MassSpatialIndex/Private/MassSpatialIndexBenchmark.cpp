@@ -0,0 +1,217 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MassSpatialIndexSubsystem.h"
+#include "HAL/IConsoleManager.h"
+
+namespace UE::MassSpatialIndex::Benchmark
+{
+	/**
+	 * 在给定的图层重叠概率下比较各插件各自维护网格与统一空间索引的开销，参数见 Run
+	 */
+	static void RunLayers(const int32 NumAgents, const int32 NumLayers, const float Overlap, const int32 NumFrames, const int32 NumQueries, const float AgentRadius)
+	{
+		const float HalfExtent = FMath::Sqrt(static_cast<float>(NumAgents)) * AgentRadius;
+		const float StepSize = AgentRadius * 0.5f;
+		const float QueryRadius = AgentRadius * 4.f;
+		FRandomStream RandomStream(1337);
+
+		// 初始位置与图层成员
+		TArray<FVector> Locations;
+		TArray<FMassSpatialIndexLayerMask> LayerMasks;
+		Locations.SetNumUninitialized(NumAgents);
+		LayerMasks.SetNumUninitialized(NumAgents);
+		int32 NumMemberships = 0;
+		for (int32 Agent = 0; Agent < NumAgents; Agent++)
+		{
+			Locations[Agent] = FVector(RandomStream.FRandRange(-HalfExtent, HalfExtent), RandomStream.FRandRange(-HalfExtent, HalfExtent), 0.f);
+
+			FMassSpatialIndexLayerMask LayerMask = 0;
+			for (int32 Layer = 0; Layer < NumLayers; Layer++)
+			{
+				if (RandomStream.FRand() < Overlap)
+				{
+					LayerMask |= FMassSpatialIndexLayerMask(1) << Layer;
+				}
+			}
+			if (LayerMask == 0)
+			{
+				LayerMask = FMassSpatialIndexLayerMask(1) << RandomStream.RandHelper(NumLayers);
+			}
+			LayerMasks[Agent] = LayerMask;
+			NumMemberships += FMath::CountBits(LayerMask);
+		}
+
+		// 每帧的位移与查询中心，两种方式使用完全相同的序列
+		TArray<FVector> Steps;
+		Steps.SetNumUninitialized(NumAgents);
+		for (FVector& Step : Steps)
+		{
+			Step = FVector(RandomStream.FRandRange(-StepSize, StepSize), RandomStream.FRandRange(-StepSize, StepSize), 0.f);
+		}
+		TArray<FVector> QueryCenters;
+		QueryCenters.SetNumUninitialized(NumQueries);
+		for (FVector& Center : QueryCenters)
+		{
+			Center = FVector(RandomStream.FRandRange(-HalfExtent, HalfExtent), RandomStream.FRandRange(-HalfExtent, HalfExtent), 0.f);
+		}
+
+		// 分散：每个图层一份网格
+		int64 SeparateChecksum = 0;
+		double SeparateUpdateSec = 0.0;
+		double SeparateQuerySec = 0.0;
+		{
+			TArray<FMassSpatialIndexGrid> LayerGrids;
+			TArray<TArray<FMassSpatialIndexGrid::FCellLocation>> LayerCells;
+			LayerGrids.Reserve(NumLayers);
+			for (int32 Layer = 0; Layer < NumLayers; Layer++)
+			{
+				LayerGrids.Emplace(100);
+				LayerCells.AddDefaulted_GetRef().SetNum(NumAgents);
+			}
+
+			TArray<FVector> AgentLocations = Locations;
+			for (int32 Agent = 0; Agent < NumAgents; Agent++)
+			{
+				const FBox Bounds = FBox::BuildAABB(AgentLocations[Agent], FVector(AgentRadius));
+				for (int32 Layer = 0; Layer < NumLayers; Layer++)
+				{
+					if (LayerMasks[Agent] & (FMassSpatialIndexLayerMask(1) << Layer))
+					{
+						LayerCells[Layer][Agent] = LayerGrids[Layer].Add(Agent, Bounds);
+					}
+				}
+			}
+
+			TArray<int32> Results;
+			for (int32 Frame = 0; Frame < NumFrames; Frame++)
+			{
+				const double UpdateStart = FPlatformTime::Seconds();
+				for (int32 Agent = 0; Agent < NumAgents; Agent++)
+				{
+					AgentLocations[Agent] += Frame % 2 == 0 ? Steps[Agent] : -Steps[Agent];
+				}
+				for (int32 Layer = 0; Layer < NumLayers; Layer++)
+				{
+					const FMassSpatialIndexLayerMask LayerBit = FMassSpatialIndexLayerMask(1) << Layer;
+					for (int32 Agent = 0; Agent < NumAgents; Agent++)
+					{
+						if (LayerMasks[Agent] & LayerBit)
+						{
+							LayerCells[Layer][Agent] = LayerGrids[Layer].Move(Agent, LayerCells[Layer][Agent], FBox::BuildAABB(AgentLocations[Agent], FVector(AgentRadius)));
+						}
+					}
+				}
+				SeparateUpdateSec += FPlatformTime::Seconds() - UpdateStart;
+
+				const double QueryStart = FPlatformTime::Seconds();
+				for (int32 Layer = 0; Layer < NumLayers; Layer++)
+				{
+					for (const FVector& Center : QueryCenters)
+					{
+						Results.Reset();
+						LayerGrids[Layer].Query(FBox::BuildAABB(Center, FVector(QueryRadius)), Results);
+						SeparateChecksum += Results.Num();
+					}
+				}
+				SeparateQuerySec += FPlatformTime::Seconds() - QueryStart;
+			}
+		}
+
+		// 统一：一份网格，查询时按图层掩码过滤
+		int64 UnifiedChecksum = 0;
+		double UnifiedUpdateSec = 0.0;
+		double UnifiedQuerySec = 0.0;
+		{
+			FMassSpatialIndexGrid Grid(100);
+			TArray<FMassSpatialIndexGrid::FCellLocation> Cells;
+			Cells.SetNum(NumAgents);
+
+			TArray<FVector> AgentLocations = Locations;
+			for (int32 Agent = 0; Agent < NumAgents; Agent++)
+			{
+				Cells[Agent] = Grid.Add(Agent, FBox::BuildAABB(AgentLocations[Agent], FVector(AgentRadius)));
+			}
+
+			TArray<int32> Results;
+			for (int32 Frame = 0; Frame < NumFrames; Frame++)
+			{
+				const double UpdateStart = FPlatformTime::Seconds();
+				for (int32 Agent = 0; Agent < NumAgents; Agent++)
+				{
+					AgentLocations[Agent] += Frame % 2 == 0 ? Steps[Agent] : -Steps[Agent];
+					Cells[Agent] = Grid.Move(Agent, Cells[Agent], FBox::BuildAABB(AgentLocations[Agent], FVector(AgentRadius)));
+				}
+				UnifiedUpdateSec += FPlatformTime::Seconds() - UpdateStart;
+
+				const double QueryStart = FPlatformTime::Seconds();
+				for (int32 Layer = 0; Layer < NumLayers; Layer++)
+				{
+					const FMassSpatialIndexLayerMask LayerBit = FMassSpatialIndexLayerMask(1) << Layer;
+					for (const FVector& Center : QueryCenters)
+					{
+						Results.Reset();
+						Grid.Query(FBox::BuildAABB(Center, FVector(QueryRadius)), Results);
+						for (const int32 Agent : Results)
+						{
+							UnifiedChecksum += (LayerMasks[Agent] & LayerBit) != 0;
+						}
+					}
+				}
+				UnifiedQuerySec += FPlatformTime::Seconds() - QueryStart;
+			}
+		}
+
+		const double SeparateSec = SeparateUpdateSec + SeparateQuerySec;
+		const double UnifiedSec = UnifiedUpdateSec + UnifiedQuerySec;
+		UE_LOG(LogTemp, Log, TEXT("MassSpatialIndex benchmark: %d agents, %d layers, overlap %.2f (%.2f layers/agent), %d frames, %d queries/layer/frame"),
+			NumAgents, NumLayers, Overlap, static_cast<float>(NumMemberships) / NumAgents, NumFrames, NumQueries);
+		UE_LOG(LogTemp, Log, TEXT("  Separate grids: %d items, update %.3f ms/frame, query %.3f ms/frame"),
+			NumMemberships, SeparateUpdateSec * 1000.0 / NumFrames, SeparateQuerySec * 1000.0 / NumFrames);
+		UE_LOG(LogTemp, Log, TEXT("  Unified index:  %d items, update %.3f ms/frame, query %.3f ms/frame"),
+			NumAgents, UnifiedUpdateSec * 1000.0 / NumFrames, UnifiedQuerySec * 1000.0 / NumFrames);
+		UE_LOG(LogTemp, Log, TEXT("  Combined speedup %.2fx (checksums %lld / %lld)"),
+			SeparateSec / FMath::Max(UnifiedSec, UE_DOUBLE_SMALL_NUMBER), SeparateChecksum, UnifiedChecksum);
+	}
+
+	/**
+	 * 比较各插件各自维护网格与统一空间索引的开销。
+	 * 每个智能体以 Overlap 的概率属于每个图层（至少属于一个），每帧随机移动一次，然后每个图层做 Queries 次范围查询：
+	 * - 分散：每个图层一份网格，属于几个图层的智能体就要在几份网格中各更新一次
+	 * - 统一：一份网格，每个智能体更新一次，查询时按图层掩码过滤
+	 * 各插件的图层由各自的片段或标签决定，现有示例中的实体通常只属于其中一个图层，因此默认 Overlap=0；
+	 * 指定了重叠时同时输出 Overlap=0 的结果，便于区分共享网格本身的收益与重叠带来的收益。
+	 * 用法：MassSpatialIndex.Benchmark [Agents=50000] [Layers=4] [Overlap=0] [Frames=30] [Queries=2000] [Radius=40]
+	 */
+	static void Run(const TArray<FString>& Args)
+	{
+		const FString Params = FString::Join(Args, TEXT(" "));
+		int32 NumAgents = 50000;
+		int32 NumLayers = 4;
+		float Overlap = 0.f;
+		int32 NumFrames = 30;
+		int32 NumQueries = 2000;
+		float AgentRadius = 40.f;
+		FParse::Value(*Params, TEXT("Agents="), NumAgents);
+		FParse::Value(*Params, TEXT("Layers="), NumLayers);
+		FParse::Value(*Params, TEXT("Overlap="), Overlap);
+		FParse::Value(*Params, TEXT("Frames="), NumFrames);
+		FParse::Value(*Params, TEXT("Queries="), NumQueries);
+		FParse::Value(*Params, TEXT("Radius="), AgentRadius);
+		NumAgents = FMath::Max(NumAgents, 1);
+		NumLayers = FMath::Clamp(NumLayers, 1, 32);
+		Overlap = FMath::Clamp(Overlap, 0.f, 1.f);
+		NumFrames = FMath::Max(NumFrames, 1);
+		NumQueries = FMath::Max(NumQueries, 0);
+
+		if (Overlap > 0.f)
+		{
+			RunLayers(NumAgents, NumLayers, 0.f, NumFrames, NumQueries, AgentRadius);
+		}
+		RunLayers(NumAgents, NumLayers, Overlap, NumFrames, NumQueries, AgentRadius);
+	}
+}
+
+static FAutoConsoleCommand SpatialIndexBenchmarkCommand(
+	TEXT("MassSpatialIndex.Benchmark"),
+	TEXT("比较每个图层各自维护网格与统一空间索引的更新与查询耗时。参数：Agents= Layers= Overlap= Frames= Queries= Radius="),
+	FConsoleCommandWithArgsDelegate::CreateStatic(&UE::MassSpatialIndex::Benchmark::Run));
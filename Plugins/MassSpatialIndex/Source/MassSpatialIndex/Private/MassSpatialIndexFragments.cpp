@@ -0,0 +1,13 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MassSpatialIndexFragments.h"
+
+#include "MassCommonFragments.h"
+#include "MassEntityTemplateRegistry.h"
+
+void UMassSpatialIndexTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+	BuildContext.AddFragment(FConstStructView::Make(SpatialIndexFragment));
+	BuildContext.RequireFragment<FTransformFragment>();
+}
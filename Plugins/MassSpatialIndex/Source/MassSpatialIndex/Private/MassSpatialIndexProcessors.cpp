@@ -0,0 +1,228 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MassSpatialIndexProcessors.h"
+
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "MassSpatialIndexFragments.h"
+#include "MassSpatialIndexSnapshotSubsystem.h"
+#include "MassSpatialIndexSubsystem.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+
+//快照的格子边长，自动调整格子边长时不使用
+static float SnapshotCellSize = 100.f;
+static FAutoConsoleVariableRef CVarSnapshotCellSize(TEXT("MassSpatialIndex.Snapshot.CellSize"), SnapshotCellSize, TEXT("只读快照的格子边长，MassSpatialIndex.AutoCellSize.Enable 打开时改用实时索引自动调整后的边长"));
+
+
+/**
+ * @brief 构造函数，观察 FMassSpatialIndexFragment 的添加
+ */
+UMassSpatialIndexInitializerProcessor::UMassSpatialIndexInitializerProcessor() :
+	EntityQuery(*this)
+{
+	ObservedType = FMassSpatialIndexFragment::StaticStruct();
+	Operation = EMassObservedOperation::Add;
+}
+
+/**
+ * @brief 配置查询需求
+ *
+ * @param EntityManager 实体管理器引用
+ */
+void UMassSpatialIndexInitializerProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddRequirement<FMassSpatialIndexFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery.AddSubsystemRequirement<UMassSpatialIndexSubsystem>(EMassFragmentAccess::ReadWrite);
+}
+
+/**
+ * @brief 为新加入的实体分配槽位，按原型计算所属图层后插入网格
+ *
+ * @param EntityManager 实体管理器引用
+ * @param Context 执行上下文
+ */
+void UMassSpatialIndexInitializerProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	EntityQuery.ForEachEntityChunk(Context, [](FMassExecutionContext& Context)
+		{
+			auto& SpatialIndex = Context.GetMutableSubsystemChecked<UMassSpatialIndexSubsystem>();
+
+			const auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
+			const auto RadiusFragments = Context.GetFragmentView<FAgentRadiusFragment>();
+			const auto IndexFragments = Context.GetMutableFragmentView<FMassSpatialIndexFragment>();
+			const bool bHasRadius = RadiusFragments.Num() > 0;
+
+			// 同一区块的实体原型相同，图层只需计算一次
+			const FMassSpatialIndexLayerMask LayerMask = SpatialIndex.CalcLayerMask(Context);
+
+			const int32 NumEntities = Context.GetNumEntities();
+			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+			{
+				auto& IndexFragment = IndexFragments[EntityIdx];
+				const FVector& Location = TransformFragments[EntityIdx].GetTransform().GetLocation();
+				const float Radius = bHasRadius ? RadiusFragments[EntityIdx].Radius : IndexFragment.Radius;
+
+				IndexFragment.Slot = SpatialIndex.AddSlot(Context.GetEntity(EntityIdx), Location, Radius, LayerMask);
+			}
+		});
+}
+
+
+/**
+ * @brief 构造函数，观察 FMassSpatialIndexFragment 的移除
+ */
+UMassSpatialIndexDestroyProcessor::UMassSpatialIndexDestroyProcessor() :
+	EntityQuery(*this)
+{
+	ObservedType = FMassSpatialIndexFragment::StaticStruct();
+	Operation = EMassObservedOperation::Remove;
+}
+
+/**
+ * @brief 配置查询需求
+ *
+ * @param EntityManager 实体管理器引用
+ */
+void UMassSpatialIndexDestroyProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddRequirement<FMassSpatialIndexFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddSubsystemRequirement<UMassSpatialIndexSubsystem>(EMassFragmentAccess::ReadWrite);
+}
+
+/**
+ * @brief 从网格中移除实体并归还槽位
+ *
+ * @param EntityManager 实体管理器引用
+ * @param Context 执行上下文
+ */
+void UMassSpatialIndexDestroyProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	EntityQuery.ForEachEntityChunk(Context, [](FMassExecutionContext& Context)
+		{
+			auto& SpatialIndex = Context.GetMutableSubsystemChecked<UMassSpatialIndexSubsystem>();
+			const auto IndexFragments = Context.GetMutableFragmentView<FMassSpatialIndexFragment>();
+
+			const int32 NumEntities = Context.GetNumEntities();
+			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+			{
+				auto& IndexFragment = IndexFragments[EntityIdx];
+				if (IndexFragment.Slot != INDEX_NONE)
+				{
+					SpatialIndex.RemoveSlot(IndexFragment.Slot);
+					IndexFragment.Slot = INDEX_NONE;
+				}
+			}
+		});
+}
+
+
+/**
+ * @brief 构造函数，在 Avoidance 组之前执行，使碰撞等读取索引的处理器看到本帧的位置
+ */
+UMassSpatialIndexProcessor::UMassSpatialIndexProcessor() :
+	EntityQuery(*this)
+{
+	ExecutionOrder.ExecuteBefore.Add(UE::Mass::ProcessorGroupNames::Avoidance);
+}
+
+/**
+ * @brief 配置查询需求
+ *
+ * @param EntityManager 实体管理器引用
+ */
+void UMassSpatialIndexProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
+{
+	EntityQuery.AddRequirement<FMassSpatialIndexFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
+	EntityQuery.AddSubsystemRequirement<UMassSpatialIndexSubsystem>(EMassFragmentAccess::ReadWrite);
+}
+
+/**
+ * @brief 更新所有索引实体的位置
+ *
+ * 并行写入每个槽位的位置、半径与图层（每个实体只写自己的槽位），被标记为静止的槽位（例如睡眠中的碰撞智能体）只刷新图层，
+ * 不读取变换也不重新计算格子；真正换了格子的槽位记入增量列表，
+ * 随后按槽位排序在单线程中统一修改网格，保证格子内的元素顺序与线程调度无关。
+ * 各插件不再各自更新网格，同时属于多个系统的实体每帧也只更新一次。
+ * 最后把索引复制到快照的后台缓冲，下一帧开始时发布给只读的查询者。
+ *
+ * @param EntityManager 实体管理器引用
+ * @param Context 执行上下文
+ */
+void UMassSpatialIndexProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	CellDeltas.Reset();
+	EntityQuery.ParallelForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(UpdateSpatialIndexCells)
+
+			auto& SpatialIndex = Context.GetMutableSubsystemChecked<UMassSpatialIndexSubsystem>();
+
+			const auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
+			const auto RadiusFragments = Context.GetFragmentView<FAgentRadiusFragment>();
+			const auto IndexFragments = Context.GetFragmentView<FMassSpatialIndexFragment>();
+			const bool bHasRadius = RadiusFragments.Num() > 0;
+
+			// 实体增删标签后会换到新的区块，因此每帧按区块重新计算图层即可
+			const FMassSpatialIndexLayerMask LayerMask = SpatialIndex.CalcLayerMask(Context);
+
+			TArray<FMassSpatialIndexCellDelta> ChunkDeltas;
+
+			const int32 NumEntities = Context.GetNumEntities();
+			for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+			{
+				const FMassSpatialIndexFragment& IndexFragment = IndexFragments[EntityIdx];
+				if (IndexFragment.Slot == INDEX_NONE)
+				{
+					continue;
+				}
+
+				// 静止的实体位置几乎不变，图层仍可能因为标签变化而改变
+				if (SpatialIndex.IsSlotResting(IndexFragment.Slot))
+				{
+					SpatialIndex.SetSlotLayerMask(IndexFragment.Slot, LayerMask);
+					continue;
+				}
+
+				const FVector& Location = TransformFragments[EntityIdx].GetTransform().GetLocation();
+				const float Radius = bHasRadius ? RadiusFragments[EntityIdx].Radius : IndexFragment.Radius;
+
+				FMassSpatialIndexGrid::FCellLocation NewCellLocation;
+				if (SpatialIndex.UpdateSlot(IndexFragment.Slot, Location, Radius, LayerMask, NewCellLocation))
+				{
+					ChunkDeltas.Add({ IndexFragment.Slot, NewCellLocation });
+				}
+			}
+
+			if (ChunkDeltas.Num() > 0)
+			{
+				FScopeLock Lock(&CellDeltasLock);
+				CellDeltas.Append(ChunkDeltas);
+			}
+		});
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(ApplySpatialIndexCells)
+
+	UMassSpatialIndexSubsystem& SpatialIndex = *EntityManager.GetWorld()->GetSubsystem<UMassSpatialIndexSubsystem>();
+	CellDeltas.Sort([](const FMassSpatialIndexCellDelta& A, const FMassSpatialIndexCellDelta& B) { return A.Slot < B.Slot; });
+	for (const FMassSpatialIndexCellDelta& Delta : CellDeltas)
+	{
+		SpatialIndex.ApplyCellChange(Delta.Slot, Delta.NewCellLocation);
+	}
+
+	// 后台缓冲在下一帧发布之前没有读取者，因此这里不需要声明对快照子系统的依赖。
+	// 快照的读取者只依赖快照子系统，可能与本处理器并行执行，不能退回实时索引，因此快照每帧都要构建
+	UMassSpatialIndexSnapshotSubsystem* SnapshotSubsystem = EntityManager.GetWorld()->GetSubsystem<UMassSpatialIndexSnapshotSubsystem>();
+	if (SnapshotSubsystem)
+	{
+		const float CellSize = UMassSpatialIndexSubsystem::IsCellSizeAutoTuned() ? SpatialIndex.GetCellSize() : SnapshotCellSize;
+		SnapshotSubsystem->GetBackBuffer().Build(SpatialIndex, CellSize, GFrameCounter);
+		SnapshotSubsystem->MarkBackBufferReady();
+	}
+}
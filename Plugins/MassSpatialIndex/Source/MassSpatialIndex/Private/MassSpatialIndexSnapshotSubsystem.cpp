@@ -0,0 +1,568 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MassSpatialIndexSnapshotSubsystem.h"
+
+#include "MassSimulationSubsystem.h"
+#include "MassSpatialIndexStats.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/Parse.h"
+
+#include <atomic>
+
+namespace UE::MassSpatialIndex
+{
+	/** 把32位整数的各位分散到64位整数的偶数位上 */
+	static uint64 SpreadBits(const uint32 Value)
+	{
+		uint64 Bits = Value;
+		Bits = (Bits | (Bits << 16)) & 0x0000FFFF0000FFFFull;
+		Bits = (Bits | (Bits << 8)) & 0x00FF00FF00FF00FFull;
+		Bits = (Bits | (Bits << 4)) & 0x0F0F0F0F0F0F0F0Full;
+		Bits = (Bits | (Bits << 2)) & 0x3333333333333333ull;
+		Bits = (Bits | (Bits << 1)) & 0x5555555555555555ull;
+		return Bits;
+	}
+
+	uint64 CalcMortonCode(const FIntPoint& Cell)
+	{
+		// 翻转符号位，使 -1 排在 0 之前
+		const uint32 X = static_cast<uint32>(Cell.X) ^ 0x80000000u;
+		const uint32 Y = static_cast<uint32>(Cell.Y) ^ 0x80000000u;
+		return SpreadBits(X) | (SpreadBits(Y) << 1);
+	}
+}
+
+/**
+ * 从实时索引重建快照：收集在用的槽位，按格子排序后连续存放
+ * @param SpatialIndex 本帧已更新的实时索引
+ * @param InCellSize 格子边长
+ * @param InFrameNumber 快照对应的帧号
+ */
+void FMassSpatialIndexSnapshot::Build(const UMassSpatialIndexSubsystem& SpatialIndex, const float InCellSize, const uint64 InFrameNumber)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(BuildSpatialIndexSnapshot)
+
+	CellSize = FMath::Max(InCellSize, 1.f);
+	FrameNumber = InFrameNumber;
+	MaxRadius = 0.f;
+
+	// 排序键的高32位与低32位分别是格子的 X 与 Y，翻转符号位后无符号比较与有符号坐标的顺序一致（与 CalcMortonCode 相同），
+	// 因此格子按坐标排序；相同格子内再按槽位排序，保证相同的输入得到相同的顺序
+	SortKeys.Reset();
+	const int32 NumSlots = SpatialIndex.GetNumSlots();
+	for (int32 Slot = 0; Slot < NumSlots; Slot++)
+	{
+		if (!SpatialIndex.GetEntity(Slot).IsValid())
+		{
+			continue;
+		}
+
+		const FVector& Location = SpatialIndex.GetLocation(Slot);
+		const FIntPoint Cell = CalcCell(Location.X, Location.Y);
+		SortKeys.Emplace((static_cast<uint64>(static_cast<uint32>(Cell.X) ^ 0x80000000u) << 32) | (static_cast<uint32>(Cell.Y) ^ 0x80000000u), Slot);
+		MaxRadius = FMath::Max(MaxRadius, SpatialIndex.GetRadius(Slot));
+	}
+
+	Algo::Sort(SortKeys, [](const TPair<uint64, int32>& A, const TPair<uint64, int32>& B)
+		{
+			return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+		});
+
+	Items.SetNumUninitialized(SortKeys.Num());
+	Cells.Reset();
+	CellLookup.Reset();
+	for (int32 Index = 0; Index < SortKeys.Num(); Index++)
+	{
+		const int32 Slot = SortKeys[Index].Value;
+		FMassSpatialIndexSnapshotItem& Item = Items[Index];
+		Item.Location = FVector3f(SpatialIndex.GetLocation(Slot));
+		Item.Radius = SpatialIndex.GetRadius(Slot);
+		Item.LayerMask = SpatialIndex.GetSlotLayerMask(Slot);
+		Item.Slot = Slot;
+		Item.Entity = SpatialIndex.GetEntity(Slot);
+
+		// 排序后同一格子的实体相邻，遇到新的键时开始一个新格子
+		if (Index == 0 || SortKeys[Index].Key != SortKeys[Index - 1].Key)
+		{
+			const uint64 Key = SortKeys[Index].Key;
+			const FIntPoint Coord(static_cast<int32>(static_cast<uint32>(Key >> 32) ^ 0x80000000u), static_cast<int32>(static_cast<uint32>(Key) ^ 0x80000000u));
+			CellLookup.Add(Coord, Cells.Num());
+			Cells.Add({ Coord, Index, 0 });
+
+			MinCellCoord = Cells.Num() == 1 ? Coord : FIntPoint(FMath::Min(MinCellCoord.X, Coord.X), FMath::Min(MinCellCoord.Y, Coord.Y));
+			MaxCellCoord = Cells.Num() == 1 ? Coord : FIntPoint(FMath::Max(MaxCellCoord.X, Coord.X), FMath::Max(MaxCellCoord.Y, Coord.Y));
+		}
+		Cells.Last().Num++;
+	}
+}
+
+/**
+ * 遍历坐标范围内的非空格子
+ *
+ * 范围覆盖的格子数超过非空格子数时（例如很大的框选），直接遍历非空格子，避免逐个查找大量空格子。
+ */
+template<typename TFunc>
+int32 FMassSpatialIndexSnapshot::ForEachCell(const FIntPoint& MinCell, const FIntPoint& MaxCell, TFunc&& Func) const
+{
+	int32 NumVisited = 0;
+	const int64 NumQueryCells = static_cast<int64>(MaxCell.X - MinCell.X + 1) * (MaxCell.Y - MinCell.Y + 1);
+	if (NumQueryCells > Cells.Num())
+	{
+		for (const FCell& Cell : Cells)
+		{
+			if (Cell.Coord.X >= MinCell.X && Cell.Coord.X <= MaxCell.X && Cell.Coord.Y >= MinCell.Y && Cell.Coord.Y <= MaxCell.Y)
+			{
+				Func(Cell);
+				NumVisited += Cell.Num;
+			}
+		}
+		return NumVisited;
+	}
+
+	for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			if (const int32* CellIndex = CellLookup.Find(FIntPoint(X, Y)))
+			{
+				Func(Cells[*CellIndex]);
+				NumVisited += Cells[*CellIndex].Num;
+			}
+		}
+	}
+	return NumVisited;
+}
+
+/**
+ * 遍历与范围重叠、且属于任一指定图层的实体；实体包围盒可能跨出所在格子，因此格子范围按最大半径扩展
+ */
+template<typename TFunc>
+int32 FMassSpatialIndexSnapshot::ForEachOverlapping(const FBox& Bounds, const FMassSpatialIndexLayerMask LayerMask, TFunc&& Func) const
+{
+	if (Items.IsEmpty())
+	{
+		return 0;
+	}
+
+	const float MinX = static_cast<float>(Bounds.Min.X);
+	const float MinY = static_cast<float>(Bounds.Min.Y);
+	const float MaxX = static_cast<float>(Bounds.Max.X);
+	const float MaxY = static_cast<float>(Bounds.Max.Y);
+
+	const FIntPoint MinCell = CalcCell(Bounds.Min.X - MaxRadius, Bounds.Min.Y - MaxRadius);
+	const FIntPoint MaxCell = CalcCell(Bounds.Max.X + MaxRadius, Bounds.Max.Y + MaxRadius);
+	return ForEachCell(MinCell, MaxCell, [this, LayerMask, MinX, MinY, MaxX, MaxY, &Func](const FCell& Cell)
+		{
+			for (int32 Index = Cell.First; Index < Cell.First + Cell.Num; Index++)
+			{
+				const FMassSpatialIndexSnapshotItem& Item = Items[Index];
+				if ((Item.LayerMask & LayerMask) == 0
+					|| Item.Location.X + Item.Radius < MinX || Item.Location.X - Item.Radius > MaxX
+					|| Item.Location.Y + Item.Radius < MinY || Item.Location.Y - Item.Radius > MaxY)
+				{
+					continue;
+				}
+				Func(Item);
+			}
+		});
+}
+
+/**
+ * 查询与范围重叠、且属于任一指定图层的槽位
+ * @param Bounds 查询范围
+ * @param LayerMask 图层掩码
+ * @param OutSlots 追加输出的槽位
+ */
+void FMassSpatialIndexSnapshot::Query(const FBox& Bounds, const FMassSpatialIndexLayerMask LayerMask, TArray<int32>& OutSlots) const
+{
+	const int32 FirstResult = OutSlots.Num();
+	const int32 NumCandidates = ForEachOverlapping(Bounds, LayerMask, [&OutSlots](const FMassSpatialIndexSnapshotItem& Item) { OutSlots.Add(Item.Slot); });
+	MASSSPATIALINDEX_RECORD_QUERIES(SnapshotQueries, 1, NumCandidates, OutSlots.Num() - FirstResult);
+}
+
+/**
+ * 与 Query 相同，输出实体句柄
+ * @param Bounds 查询范围
+ * @param LayerMask 图层掩码
+ * @param OutEntities 追加输出的实体
+ */
+void FMassSpatialIndexSnapshot::QueryEntities(const FBox& Bounds, const FMassSpatialIndexLayerMask LayerMask, TArray<FMassEntityHandle>& OutEntities) const
+{
+	const int32 FirstResult = OutEntities.Num();
+	const int32 NumCandidates = ForEachOverlapping(Bounds, LayerMask, [&OutEntities](const FMassSpatialIndexSnapshotItem& Item) { OutEntities.Add(Item.Entity); });
+	MASSSPATIALINDEX_RECORD_QUERIES(SnapshotQueries, 1, NumCandidates, OutEntities.Num() - FirstResult);
+}
+
+
+/**
+ * 精确的半径查询，只访问与查询圆的外接正方形重叠的格子
+ * @param Center 查询点
+ * @param Radius 查询半径
+ * @param LayerMask 图层掩码
+ * @param OutResults 追加输出的结果
+ */
+void FMassSpatialIndexSnapshot::QueryRadius(const FVector& Center, const float Radius, const FMassSpatialIndexLayerMask LayerMask,
+	TArray<FMassSpatialIndexQueryResult>& OutResults) const
+{
+	if (Items.IsEmpty() || Radius < 0.f)
+	{
+		return;
+	}
+
+	const FVector3f QueryCenter(Center);
+	const float RadiusSq = FMath::Square(Radius);
+	const FIntPoint MinCell = CalcCell(Center.X - Radius, Center.Y - Radius);
+	const FIntPoint MaxCell = CalcCell(Center.X + Radius, Center.Y + Radius);
+	const int32 FirstResult = OutResults.Num();
+	const int32 NumCandidates = ForEachCell(MinCell, MaxCell, [this, LayerMask, &QueryCenter, RadiusSq, &OutResults](const FCell& Cell)
+		{
+			for (int32 Index = Cell.First; Index < Cell.First + Cell.Num; Index++)
+			{
+				const FMassSpatialIndexSnapshotItem& Item = Items[Index];
+				if ((Item.LayerMask & LayerMask) == 0)
+				{
+					continue;
+				}
+
+				const float DistanceSq = FVector3f::DistSquared(Item.Location, QueryCenter);
+				if (DistanceSq <= RadiusSq)
+				{
+					OutResults.Add({ Item.Entity, Item.Slot, Item.Location, DistanceSq });
+				}
+			}
+		});
+	MASSSPATIALINDEX_RECORD_QUERIES(SnapshotQueries, 1, NumCandidates, OutResults.Num() - FirstResult);
+}
+
+/**
+ * 批量的半径查询
+ * @param Centers 查询点
+ * @param Radius 所有查询共用的半径
+ * @param LayerMask 图层掩码
+ * @param OutResults 输出
+ */
+void FMassSpatialIndexSnapshot::QueryRadiusBatch(TConstArrayView<FVector> Centers, const float Radius, const FMassSpatialIndexLayerMask LayerMask,
+	FMassSpatialIndexBatchResults& OutResults) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(QuerySpatialIndexSnapshotBatch)
+
+	const int32 NumQueries = Centers.Num();
+	OutResults.Results.Reset();
+	OutResults.Offsets.Reset();
+	OutResults.Offsets.SetNumZeroed(NumQueries + 1);
+	if (Items.IsEmpty() || NumQueries == 0 || Radius < 0.f)
+	{
+		return;
+	}
+
+	// 按中心格子的莫顿码排序，相同格子内保持查询的原始顺序
+	TArray<TPair<uint64, int32>>& SortedQueries = OutResults.SortedQueries;
+	SortedQueries.Reset(NumQueries);
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; QueryIndex++)
+	{
+		SortedQueries.Emplace(UE::MassSpatialIndex::CalcMortonCode(CalcCell(Centers[QueryIndex].X, Centers[QueryIndex].Y)), QueryIndex);
+	}
+	Algo::Sort(SortedQueries, [](const TPair<uint64, int32>& A, const TPair<uint64, int32>& B)
+		{
+			return A.Key != B.Key ? A.Key < B.Key : A.Value < B.Value;
+		});
+
+	const float RadiusSq = FMath::Square(Radius);
+	TArray<TPair<int32, FMassSpatialIndexQueryResult>>& Scattered = OutResults.Scattered;
+	Scattered.Reset();
+	int64 NumCandidates = 0;
+
+	for (int32 GroupStart = 0; GroupStart < NumQueries;)
+	{
+		// 中心落在同一格子的查询组成一组，按组内所有中心的范围确定要访问的格子
+		int32 GroupEnd = GroupStart + 1;
+		FVector2D GroupMin(Centers[SortedQueries[GroupStart].Value]);
+		FVector2D GroupMax = GroupMin;
+		while (GroupEnd < NumQueries && SortedQueries[GroupEnd].Key == SortedQueries[GroupStart].Key)
+		{
+			const FVector2D Center(Centers[SortedQueries[GroupEnd].Value]);
+			GroupMin = FVector2D::Min(GroupMin, Center);
+			GroupMax = FVector2D::Max(GroupMax, Center);
+			GroupEnd++;
+		}
+
+		const FIntPoint MinCell = CalcCell(GroupMin.X - Radius, GroupMin.Y - Radius);
+		const FIntPoint MaxCell = CalcCell(GroupMax.X + Radius, GroupMax.Y + Radius);
+		const int32 NumGroupCandidates = ForEachCell(MinCell, MaxCell, [this, LayerMask, RadiusSq, Centers, &SortedQueries, GroupStart, GroupEnd, &Scattered](const FCell& Cell)
+			{
+				for (int32 Index = Cell.First; Index < Cell.First + Cell.Num; Index++)
+				{
+					const FMassSpatialIndexSnapshotItem& Item = Items[Index];
+					if ((Item.LayerMask & LayerMask) == 0)
+					{
+						continue;
+					}
+
+					for (int32 Sorted = GroupStart; Sorted < GroupEnd; Sorted++)
+					{
+						const int32 QueryIndex = SortedQueries[Sorted].Value;
+						const float DistanceSq = FVector3f::DistSquared(Item.Location, FVector3f(Centers[QueryIndex]));
+						if (DistanceSq <= RadiusSq)
+						{
+							Scattered.Emplace(QueryIndex, FMassSpatialIndexQueryResult{ Item.Entity, Item.Slot, Item.Location, DistanceSq });
+						}
+					}
+				}
+			});
+
+		NumCandidates += static_cast<int64>(NumGroupCandidates) * (GroupEnd - GroupStart);
+		GroupStart = GroupEnd;
+	}
+	MASSSPATIALINDEX_RECORD_QUERIES(SnapshotQueries, NumQueries, NumCandidates, Scattered.Num());
+
+	// 计数后求前缀和得到每个查询的区间，再把结果分散到各自的区间
+	TArray<int32>& Offsets = OutResults.Offsets;
+	for (const TPair<int32, FMassSpatialIndexQueryResult>& Entry : Scattered)
+	{
+		Offsets[Entry.Key + 1]++;
+	}
+	for (int32 QueryIndex = 0; QueryIndex < NumQueries; QueryIndex++)
+	{
+		Offsets[QueryIndex + 1] += Offsets[QueryIndex];
+	}
+
+	OutResults.Results.SetNumUninitialized(Scattered.Num());
+	TArray<int32>& Cursors = OutResults.Cursors;
+	Cursors.Reset();
+	Cursors.Append(Offsets.GetData(), NumQueries);
+	for (const TPair<int32, FMassSpatialIndexQueryResult>& Entry : Scattered)
+	{
+		OutResults.Results[Cursors[Entry.Key]++] = Entry.Value;
+	}
+}
+
+//用逐个比较快照中所有实体的结果校验最近邻查询
+static bool bValidateNearest = false;
+static FAutoConsoleVariableRef CVarValidateNearest(TEXT("MassSpatialIndex.Snapshot.ValidateNearest"), bValidateNearest, TEXT("用逐个比较快照中所有实体的结果校验最近邻查询"));
+
+//校验发现的不一致次数，ensure 每处只报告一次，这里记录全部
+static std::atomic<int32> NumNearestMismatches = 0;
+
+//在当前快照上执行随机的最近邻查询并逐个校验，不依赖运行中的查询者
+static FAutoConsoleCommandWithWorldAndArgs CheckNearestCommand(
+	TEXT("MassSpatialIndex.Snapshot.CheckNearest"),
+	TEXT("在当前快照中实体附近随机执行最近邻查询，并与逐个比较所有实体的结果对照。参数：Queries= K= MaxDistance= Seed="),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+		{
+			const UMassSpatialIndexSnapshotSubsystem* SnapshotSubsystem = World ? World->GetSubsystem<UMassSpatialIndexSnapshotSubsystem>() : nullptr;
+			if (!SnapshotSubsystem || SnapshotSubsystem->GetSnapshot().Num() == 0)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("MassSpatialIndex.Snapshot.CheckNearest: no snapshot to check"));
+				return;
+			}
+
+			const FString Params = FString::Join(Args, TEXT(" "));
+			int32 NumQueries = 1000;
+			int32 K = 8;
+			float MaxDistance = 2000.f;
+			int32 Seed = 1337;
+			FParse::Value(*Params, TEXT("Queries="), NumQueries);
+			FParse::Value(*Params, TEXT("K="), K);
+			FParse::Value(*Params, TEXT("MaxDistance="), MaxDistance);
+			FParse::Value(*Params, TEXT("Seed="), Seed);
+
+			// 查询点取在随机实体附近两个格子以内，覆盖中心格子为空、结果跨越多圈的情况
+			const FMassSpatialIndexSnapshot& Snapshot = SnapshotSubsystem->GetSnapshot();
+			const TConstArrayView<FMassSpatialIndexSnapshotItem> Items = Snapshot.GetItems();
+			const float Offset = Snapshot.GetCellSize() * 2.f;
+			FRandomStream RandomStream(Seed);
+			TArray<FMassSpatialIndexQueryResult> Results;
+
+			TGuardValue<bool> ValidateGuard(bValidateNearest, true);
+			const int32 FirstMismatches = NumNearestMismatches.load();
+			for (int32 QueryIdx = 0; QueryIdx < NumQueries; QueryIdx++)
+			{
+				const FVector Center = FVector(Items[RandomStream.RandHelper(Items.Num())].Location)
+					+ FVector(RandomStream.FRandRange(-Offset, Offset), RandomStream.FRandRange(-Offset, Offset), 0.f);
+				Snapshot.QueryNearest(Center, K, TNumericLimits<FMassSpatialIndexLayerMask>::Max(), MaxDistance, Results);
+			}
+
+			const int32 NumMismatches = NumNearestMismatches.load() - FirstMismatches;
+			UE_LOG(LogTemp, Log, TEXT("MassSpatialIndex.Snapshot.CheckNearest: %d of %d queries mismatched (K=%d, MaxDistance=%.0f, %d entities)"),
+				NumMismatches, NumQueries, K, MaxDistance, Items.Num());
+		}));
+
+/**
+ * 最近邻查询
+ *
+ * 第 Ring 圈是与中心格子的切比雪夫距离等于 Ring 的格子。访问完第 Ring 圈后，剩余的实体都在 (2*Ring+1) 格宽的方块之外，
+ * 到查询点的距离不小于查询点到方块边界的最短距离；当前第 K 个结果比这个距离更近时，后面的圈不可能产生更近的结果。
+ * 三维距离不小于水平距离，因此这个下界对三维距离同样成立。
+ * 打开 MassSpatialIndex.Snapshot.ValidateNearest 时，每次查询都与逐个比较所有实体的结果对照。
+ *
+ * @param Center 查询点
+ * @param K 最多输出的实体数量
+ * @param LayerMask 图层掩码
+ * @param MaxDistance 只考虑距离不超过该值的实体
+ * @param OutResults 输出按距离从近到远排序的结果
+ */
+void FMassSpatialIndexSnapshot::QueryNearest(const FVector& Center, const int32 K, const FMassSpatialIndexLayerMask LayerMask, const float MaxDistance,
+	TArray<FMassSpatialIndexQueryResult>& OutResults) const
+{
+	OutResults.Reset();
+	if (Items.IsEmpty() || K <= 0 || MaxDistance < 0.f)
+	{
+		return;
+	}
+
+	const FVector3f QueryCenter(Center);
+	const float MaxDistanceSq = FMath::Square(MaxDistance);
+
+	// 保持结果按距离升序，新结果二分插入，超过 K 个时丢掉最远的
+	int32 NumCandidates = 0;
+	auto VisitCell = [this, LayerMask, &QueryCenter, MaxDistanceSq, K, &OutResults, &NumCandidates](const FCell& Cell)
+		{
+			NumCandidates += Cell.Num;
+			for (int32 Index = Cell.First; Index < Cell.First + Cell.Num; Index++)
+			{
+				const FMassSpatialIndexSnapshotItem& Item = Items[Index];
+				if ((Item.LayerMask & LayerMask) == 0)
+				{
+					continue;
+				}
+
+				const float DistanceSq = FVector3f::DistSquared(Item.Location, QueryCenter);
+				if (DistanceSq > MaxDistanceSq || (OutResults.Num() == K && DistanceSq >= OutResults.Last().DistanceSq))
+				{
+					continue;
+				}
+
+				if (OutResults.Num() == K)
+				{
+					OutResults.Pop(EAllowShrinking::No);
+				}
+				const int32 InsertIndex = Algo::UpperBoundBy(OutResults, DistanceSq, &FMassSpatialIndexQueryResult::DistanceSq);
+				OutResults.Insert({ Item.Entity, Item.Slot, Item.Location, DistanceSq }, InsertIndex);
+			}
+		};
+
+	auto VisitCoord = [this, &VisitCell](const int32 X, const int32 Y)
+		{
+			if (const int32* CellIndex = CellLookup.Find(FIntPoint(X, Y)))
+			{
+				VisitCell(Cells[*CellIndex]);
+			}
+		};
+
+	// 查询点在非空格子范围之外时，之前的圈都是空的；超过最后一圈后所有非空格子都已访问
+	const FIntPoint CenterCell = CalcCell(Center.X, Center.Y);
+	const int32 FirstRing = FMath::Max3(0,
+		FMath::Max(MinCellCoord.X - CenterCell.X, CenterCell.X - MaxCellCoord.X),
+		FMath::Max(MinCellCoord.Y - CenterCell.Y, CenterCell.Y - MaxCellCoord.Y));
+	const int32 LastRing = FMath::Max(
+		FMath::Max(FMath::Abs(MinCellCoord.X - CenterCell.X), FMath::Abs(MaxCellCoord.X - CenterCell.X)),
+		FMath::Max(FMath::Abs(MinCellCoord.Y - CenterCell.Y), FMath::Abs(MaxCellCoord.Y - CenterCell.Y)));
+
+	for (int32 Ring = FirstRing; Ring <= LastRing; Ring++)
+	{
+		if (Ring == 0)
+		{
+			VisitCoord(CenterCell.X, CenterCell.Y);
+		}
+		else
+		{
+			for (int32 X = CenterCell.X - Ring; X <= CenterCell.X + Ring; X++)
+			{
+				VisitCoord(X, CenterCell.Y - Ring);
+				VisitCoord(X, CenterCell.Y + Ring);
+			}
+			for (int32 Y = CenterCell.Y - Ring + 1; Y <= CenterCell.Y + Ring - 1; Y++)
+			{
+				VisitCoord(CenterCell.X - Ring, Y);
+				VisitCoord(CenterCell.X + Ring, Y);
+			}
+		}
+
+		// 查询点到已访问方块边界的最短距离，是剩余实体距离的下界
+		const float Gap = static_cast<float>(FMath::Min(
+			FMath::Min(Center.X - (CenterCell.X - Ring) * CellSize, (CenterCell.X + Ring + 1) * CellSize - Center.X),
+			FMath::Min(Center.Y - (CenterCell.Y - Ring) * CellSize, (CenterCell.Y + Ring + 1) * CellSize - Center.Y)));
+		if (Gap > MaxDistance || (OutResults.Num() == K && OutResults.Last().DistanceSq <= FMath::Square(Gap)))
+		{
+			break;
+		}
+	}
+
+	// 两种方法对相同的数据做相同的计算，距离应逐位相同；距离相同的实体可能以不同的顺序取舍，因此只比较距离
+	if (bValidateNearest)
+	{
+		TArray<float> BruteForceDistancesSq;
+		for (const FMassSpatialIndexSnapshotItem& Item : Items)
+		{
+			const float DistanceSq = FVector3f::DistSquared(Item.Location, QueryCenter);
+			if ((Item.LayerMask & LayerMask) != 0 && DistanceSq <= MaxDistanceSq)
+			{
+				BruteForceDistancesSq.Add(DistanceSq);
+			}
+		}
+		Algo::Sort(BruteForceDistancesSq);
+		BruteForceDistancesSq.SetNum(FMath::Min(BruteForceDistancesSq.Num(), K));
+
+		bool bMatches = BruteForceDistancesSq.Num() == OutResults.Num();
+		for (int32 Index = 0; bMatches && Index < OutResults.Num(); Index++)
+		{
+			bMatches = BruteForceDistancesSq[Index] == OutResults[Index].DistanceSq;
+		}
+		if (!bMatches)
+		{
+			NumNearestMismatches++;
+		}
+		ensureMsgf(bMatches, TEXT("Snapshot nearest query mismatch at %s (K=%d): %d results, brute force %d, farthest %f vs %f"),
+			*Center.ToString(), K, OutResults.Num(), BruteForceDistancesSq.Num(),
+			OutResults.IsEmpty() ? 0.f : FMath::Sqrt(OutResults.Last().DistanceSq),
+			BruteForceDistancesSq.IsEmpty() ? 0.f : FMath::Sqrt(BruteForceDistancesSq.Last()));
+	}
+
+	MASSSPATIALINDEX_RECORD_QUERIES(SnapshotQueries, 1, NumCandidates, OutResults.Num());
+}
+
+/**
+ * 初始化子系统，在 PrePhysics 阶段开始时发布快照
+ * @param Collection 子系统集合
+ */
+void UMassSpatialIndexSnapshotSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (UMassSimulationSubsystem* SimulationSubsystem = Collection.InitializeDependency<UMassSimulationSubsystem>())
+	{
+		PhaseStartedHandle = SimulationSubsystem->GetOnProcessingPhaseStarted(EMassProcessingPhase::PrePhysics)
+			.AddUObject(this, &UMassSpatialIndexSnapshotSubsystem::PublishSnapshot);
+	}
+}
+
+void UMassSpatialIndexSnapshotSubsystem::Deinitialize()
+{
+	if (UMassSimulationSubsystem* SimulationSubsystem = GetWorld()->GetSubsystem<UMassSimulationSubsystem>())
+	{
+		SimulationSubsystem->GetOnProcessingPhaseStarted(EMassProcessingPhase::PrePhysics).Remove(PhaseStartedHandle);
+	}
+	PhaseStartedHandle.Reset();
+
+	Super::Deinitialize();
+}
+
+/**
+ * 交换前后台缓冲；后台缓冲本帧没有重建时保留当前的快照
+ * @param DeltaSeconds 本帧时长
+ */
+void UMassSpatialIndexSnapshotSubsystem::PublishSnapshot(const float DeltaSeconds)
+{
+	if (!bBackBufferReady)
+	{
+		return;
+	}
+
+	PublishedIndex ^= 1;
+	bBackBufferReady = false;
+}
@@ -0,0 +1,347 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MassSpatialIndexStats.h"
+
+#if WITH_MASSSPATIALINDEX_STATS
+
+#include "MassSpatialIndexSnapshotSubsystem.h"
+#include "MassSpatialIndexSubsystem.h"
+#include "DrawDebugHelpers.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+CSV_DEFINE_CATEGORY(MassSpatialIndex, true);
+
+namespace UE::MassSpatialIndex::Stats
+{
+	bool bEnabled = false;
+	static FAutoConsoleVariableRef CVarEnabled(TEXT("MassSpatialIndex.Stats.Enable"), bEnabled, TEXT("是否累计空间索引查询的候选数量与命中数量"));
+
+	//热力图：0 关闭，1 实时索引的所有层，2 快照
+	static int32 HeatmapMode = 0;
+	static FAutoConsoleVariableRef CVarHeatmap(TEXT("MassSpatialIndex.Stats.Heatmap"), HeatmapMode, TEXT("绘制格子占用的热力图：0 关闭，1 实时索引的所有层，2 快照"));
+
+#if CSV_PROFILER
+	//CSV 采集时记录格子占用的间隔（秒），占用统计要遍历所有槽位与整个快照，不能每帧计算；小于等于0时不记录
+	static float OccupancyCsvInterval = 1.f;
+	static FAutoConsoleVariableRef CVarOccupancyCsvInterval(TEXT("MassSpatialIndex.Stats.OccupancyCsvInterval"), OccupancyCsvInterval, TEXT("CSV 采集时记录格子占用的间隔（秒），小于等于0时不记录"));
+	static float TimeSinceOccupancyCsv = 0.f;
+#endif
+
+	FQueryCounters LiveQueries;
+	FQueryCounters SnapshotQueries;
+
+	/** 上一次写入 CSV 时的累计值，CSV 中记录的是每帧的增量 */
+	struct FQuerySample
+	{
+		int64 NumQueries = 0;
+		int64 NumCandidates = 0;
+		int64 NumHits = 0;
+	};
+	static FQuerySample LastLiveSample;
+	static FQuerySample LastSnapshotSample;
+
+	/** 实体数量所在的直方图区间：1 个在第0个区间，2 个在第1个，3-4 个在第2个，以此类推 */
+	static int32 CalcHistogramBucket(const int32 NumItems)
+	{
+		return FMath::Min(static_cast<int32>(FMath::CeilLogTwo(static_cast<uint32>(NumItems))), NumHistogramBuckets - 1);
+	}
+
+	/** 格子收集完后计算平均高度、最大数量与直方图 */
+	static void FinishLevel(FLevelOccupancy& Level)
+	{
+		for (FCellOccupancy& Cell : Level.Cells)
+		{
+			Cell.AverageZ /= Cell.NumItems;
+			Level.MaxItems = FMath::Max(Level.MaxItems, Cell.NumItems);
+			Level.Histogram[CalcHistogramBucket(Cell.NumItems)]++;
+		}
+	}
+
+	/**
+	 * 统计实时索引各层的占用情况：按槽位记录的格子归类，不遍历网格内部的链表
+	 * @param SpatialIndex 实时索引
+	 * @param OutLevels 输出每层一项
+	 */
+	void CollectOccupancy(const UMassSpatialIndexSubsystem& SpatialIndex, TArray<FLevelOccupancy>& OutLevels)
+	{
+		OutLevels.Reset();
+
+		// (X, Y, 层级) 到该层 Cells 下标
+		TMap<FIntVector, int32> CellIndices;
+		const FMassSpatialIndexGrid& Grid = SpatialIndex.GetGrid();
+		for (int32 Slot = 0; Slot < SpatialIndex.GetNumSlots(); Slot++)
+		{
+			if (!SpatialIndex.GetEntity(Slot).IsValid())
+			{
+				continue;
+			}
+
+			const FMassSpatialIndexGrid::FCellLocation& Location = SpatialIndex.GetCellLocation(Slot);
+			while (OutLevels.Num() <= Location.Level)
+			{
+				FMassSpatialIndexGrid::FCellLocation LevelLocation = Location;
+				LevelLocation.Level = OutLevels.Num();
+				OutLevels.AddDefaulted_GetRef().CellSize = static_cast<float>(Grid.CalcCellBounds(LevelLocation).GetSize().X);
+			}
+
+			FLevelOccupancy& Level = OutLevels[Location.Level];
+			const int32& CellIndex = CellIndices.FindOrAdd(FIntVector(Location.X, Location.Y, Location.Level), Level.Cells.Num());
+			if (CellIndex == Level.Cells.Num())
+			{
+				Level.Cells.Add({ FIntPoint(Location.X, Location.Y) });
+			}
+
+			FCellOccupancy& Cell = Level.Cells[CellIndex];
+			Cell.NumItems++;
+			Cell.AverageZ += static_cast<float>(SpatialIndex.GetLocation(Slot).Z);
+			Level.NumItems++;
+		}
+
+		for (FLevelOccupancy& Level : OutLevels)
+		{
+			FinishLevel(Level);
+		}
+	}
+
+	/**
+	 * 统计快照的占用情况
+	 * @param Snapshot 快照
+	 * @param OutLevel 快照只有一层
+	 */
+	void CollectOccupancy(const FMassSpatialIndexSnapshot& Snapshot, FLevelOccupancy& OutLevel)
+	{
+		OutLevel = FLevelOccupancy();
+		OutLevel.CellSize = Snapshot.GetCellSize();
+		OutLevel.NumItems = Snapshot.Num();
+		OutLevel.Cells.Reserve(Snapshot.GetNumCells());
+
+		Snapshot.ForEachNonEmptyCell([&OutLevel](const FIntPoint& Coord, TConstArrayView<FMassSpatialIndexSnapshotItem> CellItems)
+			{
+				FCellOccupancy& Cell = OutLevel.Cells.Add_GetRef({ Coord, CellItems.Num() });
+				for (const FMassSpatialIndexSnapshotItem& Item : CellItems)
+				{
+					Cell.AverageZ += Item.Location.Z;
+				}
+			});
+
+		FinishLevel(OutLevel);
+	}
+
+	/**
+	 * 输出一层的占用：实体与格子数量、直方图与最拥挤的格子
+	 * @param Name 网格名
+	 * @param Level 占用统计，Cells 会被排序
+	 * @param NumTop 输出的最拥挤格子数量
+	 */
+	static void LogLevel(const FString& Name, FLevelOccupancy& Level, const int32 NumTop)
+	{
+		UE_LOG(LogTemp, Log, TEXT("  %s: cell size %.0f, %d items in %d cells, max %d, mean %.2f items/cell"),
+			*Name, Level.CellSize, Level.NumItems, Level.Cells.Num(), Level.MaxItems,
+			static_cast<float>(Level.NumItems) / FMath::Max(Level.Cells.Num(), 1));
+
+		FString Histogram;
+		for (int32 Bucket = 0; Bucket < NumHistogramBuckets; Bucket++)
+		{
+			const int32 Min = Bucket == 0 ? 1 : (1 << (Bucket - 1)) + 1;
+			const int32 Max = 1 << Bucket;
+			const FString Range = Bucket == NumHistogramBuckets - 1 ? FString::Printf(TEXT("%d+"), Min)
+				: Min == Max ? FString::FromInt(Min) : FString::Printf(TEXT("%d-%d"), Min, Max);
+			Histogram += FString::Printf(TEXT(" %s:%d"), *Range, Level.Histogram[Bucket]);
+		}
+		UE_LOG(LogTemp, Log, TEXT("    occupancy histogram (items: cells)%s"), *Histogram);
+
+		Level.Cells.Sort([](const FCellOccupancy& A, const FCellOccupancy& B) { return A.NumItems > B.NumItems; });
+		FString TopCells;
+		for (int32 CellIndex = 0; CellIndex < FMath::Min(NumTop, Level.Cells.Num()); CellIndex++)
+		{
+			const FCellOccupancy& Cell = Level.Cells[CellIndex];
+			TopCells += FString::Printf(TEXT(" (%d,%d):%d"), Cell.Coord.X, Cell.Coord.Y, Cell.NumItems);
+		}
+		UE_LOG(LogTemp, Log, TEXT("    hottest cells%s"), *TopCells);
+	}
+
+	/** 输出一类查询的平均候选数量与候选/命中比 */
+	static void LogQueries(const TCHAR* Name, const FQueryCounters& Counters)
+	{
+		const int64 NumQueries = Counters.NumQueries;
+		const int64 NumCandidates = Counters.NumCandidates;
+		const int64 NumHits = Counters.NumHits;
+		UE_LOG(LogTemp, Log, TEXT("  %s queries: %lld, %.2f candidates/query, %.2f hits/query, candidate-to-hit ratio %.2f"),
+			Name, NumQueries,
+			static_cast<double>(NumCandidates) / FMath::Max<int64>(NumQueries, 1),
+			static_cast<double>(NumHits) / FMath::Max<int64>(NumQueries, 1),
+			static_cast<double>(NumCandidates) / FMath::Max<int64>(NumHits, 1));
+	}
+
+	/**
+	 * 输出实时索引与快照的占用情况以及累计的查询开销
+	 * 用法：MassSpatialIndex.Stats.Dump [Top=10] [Reset]
+	 */
+	static void Dump(const TArray<FString>& Args, UWorld* World)
+	{
+		const UMassSpatialIndexSubsystem* SpatialIndex = World ? World->GetSubsystem<UMassSpatialIndexSubsystem>() : nullptr;
+		if (!SpatialIndex)
+		{
+			return;
+		}
+
+		const FString Params = FString::Join(Args, TEXT(" "));
+		int32 NumTop = 10;
+		FParse::Value(*Params, TEXT("Top="), NumTop);
+
+		UE_LOG(LogTemp, Log, TEXT("MassSpatialIndex stats:"));
+
+		TArray<FLevelOccupancy> Levels;
+		CollectOccupancy(*SpatialIndex, Levels);
+		for (int32 LevelIndex = 0; LevelIndex < Levels.Num(); LevelIndex++)
+		{
+			LogLevel(FString::Printf(TEXT("Live grid level %d"), LevelIndex), Levels[LevelIndex], NumTop);
+		}
+
+		if (const UMassSpatialIndexSnapshotSubsystem* SnapshotSubsystem = World->GetSubsystem<UMassSpatialIndexSnapshotSubsystem>())
+		{
+			const FMassSpatialIndexSnapshot& Snapshot = SnapshotSubsystem->GetSnapshot();
+			FLevelOccupancy SnapshotLevel;
+			CollectOccupancy(Snapshot, SnapshotLevel);
+			LogLevel(FString::Printf(TEXT("Snapshot (frame %llu)"), Snapshot.GetFrameNumber()), SnapshotLevel, NumTop);
+		}
+
+		if (bEnabled)
+		{
+			LogQueries(TEXT("Live"), LiveQueries);
+			LogQueries(TEXT("Snapshot"), SnapshotQueries);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Log, TEXT("  Query costs are not recorded, set MassSpatialIndex.Stats.Enable 1"));
+		}
+
+		if (Args.Contains(TEXT("Reset")))
+		{
+			LiveQueries.Reset();
+			SnapshotQueries.Reset();
+			LastLiveSample = FQuerySample();
+			LastSnapshotSample = FQuerySample();
+		}
+	}
+
+#if CSV_PROFILER
+	/** 把自上一帧以来的查询开销写入 CSV */
+	static void RecordQueriesCsv(const TCHAR* Name, const FQueryCounters& Counters, FQuerySample& LastSample)
+	{
+		const FQuerySample Sample = { Counters.NumQueries, Counters.NumCandidates, Counters.NumHits };
+		const int64 NumQueries = Sample.NumQueries - LastSample.NumQueries;
+		const int64 NumCandidates = Sample.NumCandidates - LastSample.NumCandidates;
+		const int64 NumHits = Sample.NumHits - LastSample.NumHits;
+		LastSample = Sample;
+
+		const uint32 CategoryIndex = CSV_CATEGORY_INDEX(MassSpatialIndex);
+		FCsvProfiler::RecordCustomStat(FString::Printf(TEXT("%sQueries"), Name), CategoryIndex, static_cast<float>(NumQueries), ECsvCustomStatOp::Set);
+		FCsvProfiler::RecordCustomStat(FString::Printf(TEXT("%sCandidatesPerQuery"), Name), CategoryIndex,
+			static_cast<float>(static_cast<double>(NumCandidates) / FMath::Max<int64>(NumQueries, 1)), ECsvCustomStatOp::Set);
+		FCsvProfiler::RecordCustomStat(FString::Printf(TEXT("%sCandidatesPerHit"), Name), CategoryIndex,
+			static_cast<float>(static_cast<double>(NumCandidates) / FMath::Max<int64>(NumHits, 1)), ECsvCustomStatOp::Set);
+	}
+
+	/** 把一层的占用写入 CSV */
+	static void RecordLevelCsv(const FString& Name, const FLevelOccupancy& Level)
+	{
+		const uint32 CategoryIndex = CSV_CATEGORY_INDEX(MassSpatialIndex);
+		FCsvProfiler::RecordCustomStat(Name + TEXT("Items"), CategoryIndex, static_cast<float>(Level.NumItems), ECsvCustomStatOp::Set);
+		FCsvProfiler::RecordCustomStat(Name + TEXT("Cells"), CategoryIndex, static_cast<float>(Level.Cells.Num()), ECsvCustomStatOp::Set);
+		FCsvProfiler::RecordCustomStat(Name + TEXT("MaxCellItems"), CategoryIndex, static_cast<float>(Level.MaxItems), ECsvCustomStatOp::Set);
+	}
+#endif
+
+	/**
+	 * 按格子的实体数量绘制热力图，颜色从绿（空闲）到红（该层最拥挤的格子）
+	 * @param World 绘制的世界
+	 * @param Level 占用统计
+	 * @param Thickness 线宽，区分实时索引的不同层
+	 */
+	static void DrawHeatmap(const UWorld& World, const FLevelOccupancy& Level, const float Thickness)
+	{
+		const FVector Extent(Level.CellSize * 0.5f, Level.CellSize * 0.5f, 1.f);
+		for (const FCellOccupancy& Cell : Level.Cells)
+		{
+			const float Heat = static_cast<float>(Cell.NumItems) / FMath::Max(Level.MaxItems, 1);
+			const FColor Color = FLinearColor::LerpUsingHSV(FLinearColor::Green, FLinearColor::Red, Heat).ToFColor(true);
+			const FVector Center((Cell.Coord.X + 0.5f) * Level.CellSize, (Cell.Coord.Y + 0.5f) * Level.CellSize, Cell.AverageZ);
+			DrawDebugBox(&World, Center, Extent, Color, false, -1.f, 0, Thickness);
+		}
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs SpatialIndexStatsDumpCommand(
+	TEXT("MassSpatialIndex.Stats.Dump"),
+	TEXT("输出统一空间索引各层与快照的格子占用、最拥挤的格子以及查询的平均候选数量与候选/命中比。参数：Top= Reset"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&UE::MassSpatialIndex::Stats::Dump));
+
+/**
+ * 记录 CSV 统计并绘制热力图。查询计数每帧记录；占用统计需要遍历所有槽位，
+ * CSV 采集时每隔 OccupancyCsvInterval 秒记录一次，热力图打开时每帧计算
+ * @param DeltaSeconds 本帧时长
+ */
+void UMassSpatialIndexSubsystem::RecordStats(const float DeltaSeconds)
+{
+	using namespace UE::MassSpatialIndex::Stats;
+
+	const UWorld* World = GetWorld();
+	const UMassSpatialIndexSnapshotSubsystem* SnapshotSubsystem = World->GetSubsystem<UMassSpatialIndexSnapshotSubsystem>();
+
+#if CSV_PROFILER
+	if (FCsvProfiler::Get()->IsCapturing())
+	{
+		if (bEnabled)
+		{
+			RecordQueriesCsv(TEXT("Live"), LiveQueries, LastLiveSample);
+			RecordQueriesCsv(TEXT("Snapshot"), SnapshotQueries, LastSnapshotSample);
+		}
+
+		TimeSinceOccupancyCsv += DeltaSeconds;
+		if (OccupancyCsvInterval > 0.f && TimeSinceOccupancyCsv >= OccupancyCsvInterval)
+		{
+			TimeSinceOccupancyCsv = 0.f;
+
+			TArray<FLevelOccupancy> Levels;
+			CollectOccupancy(*this, Levels);
+			for (int32 LevelIndex = 0; LevelIndex < Levels.Num(); LevelIndex++)
+			{
+				RecordLevelCsv(FString::Printf(TEXT("Level%d"), LevelIndex), Levels[LevelIndex]);
+			}
+
+			if (SnapshotSubsystem)
+			{
+				FLevelOccupancy SnapshotLevel;
+				CollectOccupancy(SnapshotSubsystem->GetSnapshot(), SnapshotLevel);
+				RecordLevelCsv(TEXT("Snapshot"), SnapshotLevel);
+			}
+		}
+	}
+	else
+	{
+		// 下一次采集开始时立即记录一次占用
+		TimeSinceOccupancyCsv = OccupancyCsvInterval;
+	}
+#endif
+
+	if (HeatmapMode == 1)
+	{
+		TArray<FLevelOccupancy> Levels;
+		CollectOccupancy(*this, Levels);
+		for (int32 LevelIndex = 0; LevelIndex < Levels.Num(); LevelIndex++)
+		{
+			DrawHeatmap(*World, Levels[LevelIndex], 2.f * (LevelIndex + 1));
+		}
+	}
+	else if (HeatmapMode == 2 && SnapshotSubsystem)
+	{
+		FLevelOccupancy SnapshotLevel;
+		CollectOccupancy(SnapshotSubsystem->GetSnapshot(), SnapshotLevel);
+		DrawHeatmap(*World, SnapshotLevel, 2.f);
+	}
+}
+
+#endif
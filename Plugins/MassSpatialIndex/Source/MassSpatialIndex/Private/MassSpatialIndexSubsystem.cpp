@@ -0,0 +1,362 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "MassSpatialIndexSubsystem.h"
+
+#include "MassEntityTypes.h"
+#include "MassExecutionContext.h"
+#include "MassSimulationSubsystem.h"
+#include "MassSpatialIndexSnapshotSubsystem.h"
+#include "HAL/IConsoleManager.h"
+
+//是否根据查询的候选数自动调整格子边长
+static bool bAutoCellSize = true;
+static FAutoConsoleVariableRef CVarAutoCellSize(TEXT("MassSpatialIndex.AutoCellSize.Enable"), bAutoCellSize, TEXT("是否根据查询的候选数自动调整统一空间索引与快照的格子边长"));
+
+//自动调整的边长下限与上限
+static float MinAutoCellSize = 50.f;
+static FAutoConsoleVariableRef CVarMinAutoCellSize(TEXT("MassSpatialIndex.AutoCellSize.Min"), MinAutoCellSize, TEXT("自动调整的格子边长下限"));
+static float MaxAutoCellSize = 3200.f;
+static FAutoConsoleVariableRef CVarMaxAutoCellSize(TEXT("MassSpatialIndex.AutoCellSize.Max"), MaxAutoCellSize, TEXT("自动调整的格子边长上限"));
+
+//典型查询范围的边长，也是自动调整的边长下限：碰撞以 半径 + 最大半径 为半边长查询，FAgentRadiusFragment 的默认半径40时为160
+static float AutoCellQueryDiameter = 160.f;
+static FAutoConsoleVariableRef CVarAutoCellQueryDiameter(TEXT("MassSpatialIndex.AutoCellSize.QueryDiameter"), AutoCellQueryDiameter, TEXT("典型查询范围的边长，自动调整的格子边长不小于该值"));
+
+//每次查询的目标平均候选数
+static float TargetCandidatesPerQuery = 8.f;
+static FAutoConsoleVariableRef CVarTargetCandidatesPerQuery(TEXT("MassSpatialIndex.AutoCellSize.TargetCandidates"), TargetCandidatesPerQuery, TEXT("自动调整格子边长时每次查询的目标平均候选数"));
+
+//两次调整的间隔（秒）
+static float AutoCellSizeInterval = 1.f;
+static FAutoConsoleVariableRef CVarAutoCellSizeInterval(TEXT("MassSpatialIndex.AutoCellSize.Interval"), AutoCellSizeInterval, TEXT("两次调整格子边长的间隔（秒）"));
+
+//新旧边长之比超过该值才重建网格，避免在两个边长之间来回重建
+static float AutoCellSizeThreshold = 1.25f;
+static FAutoConsoleVariableRef CVarAutoCellSizeThreshold(TEXT("MassSpatialIndex.AutoCellSize.Threshold"), AutoCellSizeThreshold, TEXT("新旧格子边长之比超过该值才重建网格"));
+
+/**
+ * 注册图层，同名图层只注册一次
+ * @param LayerName 图层名
+ * @param MembershipType 决定成员资格的片段或标签类型
+ * @return 图层掩码，图层已满时返回0
+ */
+FMassSpatialIndexLayerMask UMassSpatialIndexSubsystem::RegisterLayer(const FName LayerName, const UScriptStruct* MembershipType)
+{
+	check(MembershipType);
+
+	const FMassSpatialIndexLayerMask ExistingMask = GetLayerMask(LayerName);
+	if (ExistingMask != 0)
+	{
+		ensureMsgf(Layers[FMath::CountTrailingZeros(ExistingMask)].MembershipType == MembershipType,
+			TEXT("Spatial index layer %s registered twice with different membership types"), *LayerName.ToString());
+		return ExistingMask;
+	}
+
+	if (Layers.Num() >= sizeof(FMassSpatialIndexLayerMask) * 8)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MassSpatialIndex: cannot register layer %s, all %d layers are in use"), *LayerName.ToString(), Layers.Num());
+		return 0;
+	}
+
+	Layers.Add({ LayerName, MembershipType });
+	return FMassSpatialIndexLayerMask(1) << (Layers.Num() - 1);
+}
+
+/**
+ * 按名字获取图层掩码
+ * @param LayerName 图层名
+ * @return 未注册时返回0
+ */
+FMassSpatialIndexLayerMask UMassSpatialIndexSubsystem::GetLayerMask(const FName LayerName) const
+{
+	const int32 LayerIndex = Layers.IndexOfByPredicate([LayerName](const FLayer& Layer) { return Layer.Name == LayerName; });
+	return LayerIndex != INDEX_NONE ? FMassSpatialIndexLayerMask(1) << LayerIndex : 0;
+}
+
+/**
+ * 按当前区块的原型计算所属图层
+ * @param Context 正在处理的区块
+ * @return 原型包含其成员类型的所有图层
+ */
+FMassSpatialIndexLayerMask UMassSpatialIndexSubsystem::CalcLayerMask(const FMassExecutionContext& Context) const
+{
+	FMassSpatialIndexLayerMask LayerMask = 0;
+	for (int32 LayerIndex = 0; LayerIndex < Layers.Num(); LayerIndex++)
+	{
+		const UScriptStruct& MembershipType = *Layers[LayerIndex].MembershipType;
+		const bool bMember = MembershipType.IsChildOf(FMassTag::StaticStruct())
+			? Context.DoesArchetypeHaveTag(MembershipType)
+			: Context.DoesArchetypeHaveFragment(MembershipType);
+		if (bMember)
+		{
+			LayerMask |= FMassSpatialIndexLayerMask(1) << LayerIndex;
+		}
+	}
+	return LayerMask;
+}
+
+/**
+ * 查询与范围重叠、且属于任一指定图层的槽位
+ * @param Bounds 查询范围
+ * @param LayerMask 图层掩码
+ * @param OutSlots 追加输出的槽位
+ */
+void UMassSpatialIndexSubsystem::Query(const FBox& Bounds, const FMassSpatialIndexLayerMask LayerMask, TArray<int32>& OutSlots) const
+{
+	const int32 FirstResult = OutSlots.Num();
+	Grid.Query(Bounds, OutSlots);
+
+	// 原地去掉不属于指定图层的槽位
+	int32 NumKept = FirstResult;
+	for (int32 Index = FirstResult; Index < OutSlots.Num(); Index++)
+	{
+		const int32 Slot = OutSlots[Index];
+		if ((LayerMasks[Slot] & LayerMask) != 0)
+		{
+			OutSlots[NumKept++] = Slot;
+		}
+	}
+	MASSSPATIALINDEX_RECORD_QUERIES(LiveQueries, 1, OutSlots.Num() - FirstResult, NumKept - FirstResult);
+	OutSlots.SetNum(NumKept, EAllowShrinking::No);
+}
+
+/**
+ * 与 Query 相同，输出实体句柄
+ * @param Bounds 查询范围
+ * @param LayerMask 图层掩码
+ * @param OutEntities 追加输出的实体
+ */
+void UMassSpatialIndexSubsystem::QueryEntities(const FBox& Bounds, const FMassSpatialIndexLayerMask LayerMask, TArray<FMassEntityHandle>& OutEntities) const
+{
+	TArray<int32> Slots;
+	Query(Bounds, LayerMask, Slots);
+
+	OutEntities.Reserve(OutEntities.Num() + Slots.Num());
+	for (const int32 Slot : Slots)
+	{
+		OutEntities.Add(Entities[Slot]);
+	}
+}
+
+/**
+ * 统计属于任一指定图层的实体数量
+ * @param LayerMask 图层掩码
+ * @return 实体数量
+ */
+int32 UMassSpatialIndexSubsystem::GetNumItems(const FMassSpatialIndexLayerMask LayerMask) const
+{
+	int32 NumItems = 0;
+	for (int32 Slot = 0; Slot < Entities.Num(); Slot++)
+	{
+		NumItems += Entities[Slot].IsValid() && (LayerMasks[Slot] & LayerMask) != 0;
+	}
+	return NumItems;
+}
+
+/**
+ * 初始化子系统，在每帧 PrePhysics 阶段开始时调整格子边长；统计编译进来时同时记录 CSV 统计并绘制热力图
+ * @param Collection 子系统集合
+ */
+void UMassSpatialIndexSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (UMassSimulationSubsystem* SimulationSubsystem = Collection.InitializeDependency<UMassSimulationSubsystem>())
+	{
+		PhaseStartedHandle = SimulationSubsystem->GetOnProcessingPhaseStarted(EMassProcessingPhase::PrePhysics)
+			.AddUObject(this, &UMassSpatialIndexSubsystem::OnPhaseStarted);
+	}
+}
+
+void UMassSpatialIndexSubsystem::Deinitialize()
+{
+	if (UMassSimulationSubsystem* SimulationSubsystem = GetWorld()->GetSubsystem<UMassSimulationSubsystem>())
+	{
+		SimulationSubsystem->GetOnProcessingPhaseStarted(EMassProcessingPhase::PrePhysics).Remove(PhaseStartedHandle);
+	}
+	PhaseStartedHandle.Reset();
+
+	Super::Deinitialize();
+}
+
+void UMassSpatialIndexSubsystem::OnPhaseStarted(const float DeltaSeconds)
+{
+	TuneCellSize(DeltaSeconds);
+
+#if WITH_MASSSPATIALINDEX_STATS
+	RecordStats(DeltaSeconds);
+#endif
+}
+
+bool UMassSpatialIndexSubsystem::IsCellSizeAutoTuned()
+{
+	return bAutoCellSize;
+}
+
+/**
+ * 按每次查询的平均候选数调整格子边长
+ *
+ * 边长为 C 的格子中，边长为 D 的查询访问的格子覆盖约 (D + C)^2 的面积，候选数与它成正比。
+ * 打开 MassSpatialIndex.Stats.Enable 时候选数取自上一次调整以来实时索引与快照上实际记录的平均值；
+ * 否则由上一帧快照的平均占用估算：以实体为中心的查询平均覆盖 (1 + D / C)^2 个格子。
+ * 新边长取候选数不超过 TargetCandidatesPerQuery 的最大值，即 (D + C) * sqrt(目标 / 当前) - D；
+ * 边长不小于典型查询直径 D，查询最多覆盖 2x2 个格子，稀疏的人群也只在候选数仍然很少时才继续增大边长。
+ * 每次最多调整2倍，新旧边长之比没有超过阈值时不重建，层级数由网格类型决定，不在调整范围内。
+ *
+ * @param DeltaSeconds 本帧时长
+ */
+void UMassSpatialIndexSubsystem::TuneCellSize(const float DeltaSeconds)
+{
+	TimeSinceCellSizeTune += DeltaSeconds;
+	if (!bAutoCellSize || TimeSinceCellSizeTune < AutoCellSizeInterval)
+	{
+		return;
+	}
+	TimeSinceCellSizeTune = 0.f;
+
+	const UMassSpatialIndexSnapshotSubsystem* SnapshotSubsystem = GetWorld()->GetSubsystem<UMassSpatialIndexSnapshotSubsystem>();
+	const FMassSpatialIndexSnapshot* Snapshot = SnapshotSubsystem ? &SnapshotSubsystem->GetSnapshot() : nullptr;
+	if (!Snapshot || Snapshot->GetNumCells() == 0)
+	{
+		return;
+	}
+
+	const float QueryDiameter = FMath::Max(AutoCellQueryDiameter, 1.f);
+	const float Occupancy = static_cast<float>(Snapshot->Num()) / Snapshot->GetNumCells();
+	float MeasuredCellSize = Snapshot->GetCellSize();
+	float CandidatesPerQuery = Occupancy * FMath::Square(1.f + QueryDiameter / MeasuredCellSize);
+
+#if WITH_MASSSPATIALINDEX_STATS
+	{
+		using namespace UE::MassSpatialIndex::Stats;
+		const int64 NumQueries = LiveQueries.NumQueries.load(std::memory_order_relaxed) + SnapshotQueries.NumQueries.load(std::memory_order_relaxed);
+		const int64 NumCandidates = LiveQueries.NumCandidates.load(std::memory_order_relaxed) + SnapshotQueries.NumCandidates.load(std::memory_order_relaxed);
+		const int64 NewQueries = NumQueries - LastTuneNumQueries;
+		const int64 NewCandidates = NumCandidates - LastTuneNumCandidates;
+		LastTuneNumQueries = NumQueries;
+		LastTuneNumCandidates = NumCandidates;
+
+		// 统计在这段时间内被重置时差值没有意义，这一次仍用估算；两次调整之间的查询都使用当前的边长
+		if (bEnabled && NewQueries > 0 && NewCandidates >= 0)
+		{
+			CandidatesPerQuery = static_cast<float>(NewCandidates) / NewQueries;
+			MeasuredCellSize = CellSize;
+		}
+	}
+#endif
+
+	const float TargetCandidates = FMath::Max(TargetCandidatesPerQuery, 1.f);
+	const float DesiredCellSize = (QueryDiameter + MeasuredCellSize) * FMath::Sqrt(TargetCandidates / FMath::Max(CandidatesPerQuery, UE_SMALL_NUMBER)) - QueryDiameter;
+	const float MinCellSize = FMath::Max3(MinAutoCellSize, QueryDiameter, 1.f);
+	const float NewCellSize = FMath::Clamp(FMath::Clamp(DesiredCellSize, MeasuredCellSize * 0.5f, MeasuredCellSize * 2.f), MinCellSize, FMath::Max(MaxAutoCellSize, MinCellSize));
+
+	const float Ratio = NewCellSize > CellSize ? NewCellSize / CellSize : CellSize / NewCellSize;
+	if (Ratio < AutoCellSizeThreshold)
+	{
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("MassSpatialIndex: %d items, %.2f items per occupied cell, %.2f candidates per query at cell size %.0f, rebuilding grid with cell size %.0f"),
+		Snapshot->Num(), Occupancy, CandidatesPerQuery, MeasuredCellSize, NewCellSize);
+	RebuildGrid(NewCellSize);
+}
+
+/**
+ * 以新的格子边长重建网格
+ * @param NewCellSize 最底层网格的格子边长
+ */
+void UMassSpatialIndexSubsystem::RebuildGrid(const float NewCellSize)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(RebuildSpatialIndexGrid)
+
+	CellSize = FMath::Max(NewCellSize, 1.f);
+	Grid = FMassSpatialIndexGrid(CellSize);
+	for (int32 Slot = 0; Slot < Entities.Num(); Slot++)
+	{
+		if (Entities[Slot].IsValid())
+		{
+			CellLocations[Slot] = Grid.Add(Slot, FBox::BuildAABB(Locations[Slot], FVector(Radii[Slot])));
+		}
+	}
+}
+
+/**
+ * 分配槽位并加入网格，优先复用已归还的槽位
+ * @return 分配的槽位
+ */
+int32 UMassSpatialIndexSubsystem::AddSlot(const FMassEntityHandle Entity, const FVector& Location, const float Radius, const FMassSpatialIndexLayerMask LayerMask)
+{
+	int32 Slot;
+	if (FreeSlots.Num() > 0)
+	{
+		Slot = FreeSlots.Pop(EAllowShrinking::No);
+		Entities[Slot] = Entity;
+	}
+	else
+	{
+		Slot = Entities.Add(Entity);
+		Locations.AddUninitialized();
+		Radii.AddUninitialized();
+		LayerMasks.AddUninitialized();
+		CellLocations.AddDefaulted();
+		Resting.AddUninitialized();
+	}
+
+	Locations[Slot] = Location;
+	Radii[Slot] = Radius;
+	LayerMasks[Slot] = LayerMask;
+	Resting[Slot] = 0;
+	CellLocations[Slot] = Grid.Add(Slot, FBox::BuildAABB(Location, FVector(Radius)));
+	return Slot;
+}
+
+/**
+ * 从网格中移除并归还槽位
+ * @param Slot 槽位
+ */
+void UMassSpatialIndexSubsystem::RemoveSlot(const int32 Slot)
+{
+	Grid.Remove(Slot, CellLocations[Slot]);
+	Entities[Slot].Reset();
+	LayerMasks[Slot] = 0;
+	Resting[Slot] = 0;
+	FreeSlots.Add(Slot);
+}
+
+/**
+ * 本帧更新之后再移动单个槽位，只能在单线程中调用
+ * @param Slot 槽位
+ * @param Location 新位置
+ */
+void UMassSpatialIndexSubsystem::MoveSlot(const int32 Slot, const FVector& Location)
+{
+	Locations[Slot] = Location;
+	CellLocations[Slot] = Grid.Move(Slot, CellLocations[Slot], FBox::BuildAABB(Location, FVector(Radii[Slot])));
+}
+
+/**
+ * 写入槽位的数据并计算新的格子，可在多个工作线程上同时调用
+ * @return 格子是否变化
+ */
+bool UMassSpatialIndexSubsystem::UpdateSlot(const int32 Slot, const FVector& Location, const float Radius, const FMassSpatialIndexLayerMask LayerMask,
+	FMassSpatialIndexGrid::FCellLocation& OutNewCellLocation)
+{
+	Locations[Slot] = Location;
+	Radii[Slot] = Radius;
+	LayerMasks[Slot] = LayerMask;
+
+	OutNewCellLocation = Grid.CalcCellLocation(FBox::BuildAABB(Location, FVector(Radius)));
+	return !(OutNewCellLocation == CellLocations[Slot]);
+}
+
+/**
+ * 把槽位移到 UpdateSlot 算出的新格子
+ * @param Slot 槽位
+ * @param NewCellLocation 新的格子
+ */
+void UMassSpatialIndexSubsystem::ApplyCellChange(const int32 Slot, const FMassSpatialIndexGrid::FCellLocation& NewCellLocation)
+{
+	Grid.Move(Slot, CellLocations[Slot], NewCellLocation);
+	CellLocations[Slot] = NewCellLocation;
+}
@@ -0,0 +1,36 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTraitBase.h"
+#include "MassEntityTypes.h"
+#include "MassSpatialIndexFragments.generated.h"
+
+//带有该片段的实体加入统一空间索引，所属图层由原型中的片段与标签决定
+USTRUCT()
+struct MASSSPATIALINDEX_API FMassSpatialIndexFragment : public FMassFragment
+{
+	GENERATED_BODY()
+
+	//在 UMassSpatialIndexSubsystem 中的槽位，加入索引前为 INDEX_NONE
+	int32 Slot = INDEX_NONE;
+
+	//没有 FAgentRadiusFragment 的实体在网格中占据的半径
+	UPROPERTY(EditAnywhere, Category = "Spatial Index")
+	float Radius = 25.f;
+};
+
+
+//把实体加入统一空间索引；各插件的特性也会在模板中没有该片段时自动添加
+UCLASS()
+class MASSSPATIALINDEX_API UMassSpatialIndexTrait : public UMassEntityTraitBase
+{
+	GENERATED_BODY()
+
+public:
+	virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+
+	UPROPERTY(EditAnywhere, Category = "Spatial Index")
+	FMassSpatialIndexFragment SpatialIndexFragment;
+};
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassObserverProcessor.h"
+#include "MassProcessor.h"
+#include "MassSpatialIndexSubsystem.h"
+#include "MassSpatialIndexProcessors.generated.h"
+
+//实体加入统一空间索引时分配槽位并插入网格
+UCLASS()
+class MASSSPATIALINDEX_API UMassSpatialIndexInitializerProcessor : public UMassObserverProcessor
+{
+	GENERATED_BODY()
+	UMassSpatialIndexInitializerProcessor();
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+	FMassEntityQuery EntityQuery;
+};
+
+//实体销毁或移除 FMassSpatialIndexFragment 时从网格中移除并归还槽位
+UCLASS()
+class MASSSPATIALINDEX_API UMassSpatialIndexDestroyProcessor : public UMassObserverProcessor
+{
+	GENERATED_BODY()
+	UMassSpatialIndexDestroyProcessor();
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+	FMassEntityQuery EntityQuery;
+};
+
+//网格更新的增量：并行阶段记录换了格子的槽位，之后统一修改网格
+struct FMassSpatialIndexCellDelta
+{
+	int32 Slot = INDEX_NONE;
+	FMassSpatialIndexGrid::FCellLocation NewCellLocation;
+};
+
+//每帧一次的并行更新：写入所有索引实体的位置与图层，再在单线程中应用换格子的增量，最后构建下一帧发布的只读快照
+//在 Avoidance 组之前执行，之后读取实时索引的处理器应声明对 UMassSpatialIndexSubsystem 的依赖并排在它之后；
+//可以接受一帧延迟的处理器改为只读依赖 UMassSpatialIndexSnapshotSubsystem，不受这一顺序约束
+UCLASS()
+class MASSSPATIALINDEX_API UMassSpatialIndexProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+	UMassSpatialIndexProcessor();
+	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+	FMassEntityQuery EntityQuery;
+
+	//本帧换了格子的槽位，各工作线程通过 CellDeltasLock 合并
+	TArray<FMassSpatialIndexCellDelta> CellDeltas;
+	FCriticalSection CellDeltasLock;
+};
@@ -0,0 +1,266 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityHandle.h"
+#include "MassExternalSubsystemTraits.h"
+#include "MassSpatialIndexSubsystem.h"
+#include "MassSubsystemBase.h"
+#include "MassSpatialIndexSnapshotSubsystem.generated.h"
+
+/** 快照中的一个实体，同一格子的实体在数组中连续存放 */
+struct FMassSpatialIndexSnapshotItem
+{
+	FVector3f Location = FVector3f::ZeroVector;
+	float Radius = 0.f;
+	FMassSpatialIndexLayerMask LayerMask = 0;
+
+	/** 在 UMassSpatialIndexSubsystem 中的槽位 */
+	int32 Slot = INDEX_NONE;
+
+	FMassEntityHandle Entity;
+};
+
+/** 半径与最近邻查询的结果，附带快照中记录的位置与到查询点的距离平方，调用者不必再查找片段 */
+struct FMassSpatialIndexQueryResult
+{
+	FMassEntityHandle Entity;
+
+	/** 在 UMassSpatialIndexSubsystem 中的槽位 */
+	int32 Slot = INDEX_NONE;
+
+	FVector3f Location = FVector3f::ZeroVector;
+	float DistanceSq = 0.f;
+};
+
+namespace UE::MassSpatialIndex
+{
+	/** 格子坐标的莫顿码（Z 序），相邻的格子大多得到相近的值；负坐标先平移到无符号范围，保持排序与坐标一致 */
+	MASSSPATIALINDEX_API uint64 CalcMortonCode(const FIntPoint& Cell);
+}
+
+/**
+ * 一批查询的结果，第 QueryIndex 个查询的结果连续存放，通过 Get 取得
+ *
+ * 每个工作线程（例如 ParallelForEachEntityChunk 中的每个区块）各持有一份并反复使用，已分配的内存会被复用。
+ */
+struct MASSSPATIALINDEX_API FMassSpatialIndexBatchResults
+{
+	/** 第 QueryIndex 个查询的结果，顺序不保证 */
+	TConstArrayView<FMassSpatialIndexQueryResult> Get(const int32 QueryIndex) const
+	{
+		return MakeArrayView(Results.GetData() + Offsets[QueryIndex], Offsets[QueryIndex + 1] - Offsets[QueryIndex]);
+	}
+
+	int32 NumQueries() const { return FMath::Max(Offsets.Num() - 1, 0); }
+
+	/** 所有查询的结果总数 */
+	int32 NumResults() const { return Results.Num(); }
+
+private:
+	friend struct FMassSpatialIndexSnapshot;
+
+	TArray<FMassSpatialIndexQueryResult> Results;
+
+	/** 第 i 个查询的结果位于 [Offsets[i], Offsets[i+1]) */
+	TArray<int32> Offsets;
+
+	/** 按中心格子的莫顿码排序的查询下标 */
+	TArray<TPair<uint64, int32>> SortedQueries;
+
+	/** 遍历格子时收集的 (查询下标, 结果)，最后按查询下标分散到 Results */
+	TArray<TPair<int32, FMassSpatialIndexQueryResult>> Scattered;
+
+	/** 分散结果时每个查询的写入位置 */
+	TArray<int32> Cursors;
+};
+
+/**
+ * 统一空间索引某一帧的只读快照
+ *
+ * 按单层均匀网格组织：实体按所在格子排序后连续存放，每个格子只记录起始下标与数量，查询时顺序读取，
+ * 不再经过分层网格的链表。构建后不再修改，任意数量的工作线程可以同时查询。
+ * 与实时索引相同，Query 返回包围盒（以实体半径为半边长）与查询范围在 XY 平面上重叠的实体；
+ * QueryRadius 与 QueryNearest 则按实体中心到查询点的三维距离精确判断。
+ */
+struct MASSSPATIALINDEX_API FMassSpatialIndexSnapshot
+{
+	/**
+	 * 从实时索引重建快照
+	 * @param SpatialIndex 本帧已更新的实时索引
+	 * @param InCellSize 格子边长
+	 * @param InFrameNumber 快照对应的帧号
+	 */
+	void Build(const UMassSpatialIndexSubsystem& SpatialIndex, const float InCellSize, const uint64 InFrameNumber);
+
+	/**
+	 * 查询与范围重叠、且属于任一指定图层的槽位
+	 * @param Bounds 查询范围
+	 * @param LayerMask 图层掩码
+	 * @param OutSlots 追加输出的槽位
+	 */
+	void Query(const FBox& Bounds, const FMassSpatialIndexLayerMask LayerMask, TArray<int32>& OutSlots) const;
+
+	/**
+	 * 与 Query 相同，输出实体句柄；实体可能在快照之后已被销毁，使用前需检查有效性
+	 * @param Bounds 查询范围
+	 * @param LayerMask 图层掩码
+	 * @param OutEntities 追加输出的实体
+	 */
+	void QueryEntities(const FBox& Bounds, const FMassSpatialIndexLayerMask LayerMask, TArray<FMassEntityHandle>& OutEntities) const;
+
+	/**
+	 * 精确的半径查询：输出中心到 Center 的距离不超过 Radius、且属于任一指定图层的实体，顺序不保证
+	 * @param Center 查询点
+	 * @param Radius 查询半径
+	 * @param LayerMask 图层掩码
+	 * @param OutResults 追加输出的结果
+	 */
+	void QueryRadius(const FVector& Center, const float Radius, const FMassSpatialIndexLayerMask LayerMask, TArray<FMassSpatialIndexQueryResult>& OutResults) const;
+
+	/**
+	 * 批量的半径查询，结果与逐个调用 QueryRadius 相同
+	 *
+	 * 查询先按中心格子的莫顿码排序，中心落在同一格子的查询组成一组，每组需要的格子只查找、遍历一次，
+	 * 格子中的每个实体与组内所有查询比较后把结果分散到各自的区间。相邻的组访问的格子大多相同，
+	 * 按莫顿码的顺序处理也能让这些格子留在缓存中。只读，可在多个工作线程上同时调用。
+	 *
+	 * @param Centers 查询点
+	 * @param Radius 所有查询共用的半径
+	 * @param LayerMask 图层掩码
+	 * @param OutResults 输出，调用前的内容会被清空
+	 */
+	void QueryRadiusBatch(TConstArrayView<FVector> Centers, const float Radius, const FMassSpatialIndexLayerMask LayerMask,
+		FMassSpatialIndexBatchResults& OutResults) const;
+
+	/**
+	 * 最近邻查询：从 Center 所在的格子开始逐圈向外搜索，已找到 K 个结果且第 K 个比下一圈的最近可能距离更近时提前结束
+	 * @param Center 查询点
+	 * @param K 最多输出的实体数量
+	 * @param LayerMask 图层掩码
+	 * @param MaxDistance 只考虑距离不超过该值的实体
+	 * @param OutResults 输出按距离从近到远排序的结果；调用前的内容会被清空，已分配的内存会被复用
+	 */
+	void QueryNearest(const FVector& Center, const int32 K, const FMassSpatialIndexLayerMask LayerMask, const float MaxDistance,
+		TArray<FMassSpatialIndexQueryResult>& OutResults) const;
+
+	/** 快照中的实体数量 */
+	int32 Num() const { return Items.Num(); }
+
+	/** 快照中非空格子的数量 */
+	int32 GetNumCells() const { return Cells.Num(); }
+
+	/** 快照对应的帧号，尚未构建时为0 */
+	uint64 GetFrameNumber() const { return FrameNumber; }
+
+	float GetCellSize() const { return CellSize; }
+
+	TConstArrayView<FMassSpatialIndexSnapshotItem> GetItems() const { return Items; }
+
+	/** 按坐标顺序遍历非空格子，Func(格子坐标, 格子中的实体) */
+	template<typename TFunc>
+	void ForEachNonEmptyCell(TFunc&& Func) const
+	{
+		for (const FCell& Cell : Cells)
+		{
+			Func(Cell.Coord, MakeArrayView(Items.GetData() + Cell.First, Cell.Num));
+		}
+	}
+
+private:
+	struct FCell
+	{
+		FIntPoint Coord = FIntPoint::ZeroValue;
+		int32 First = 0;
+		int32 Num = 0;
+	};
+
+	FIntPoint CalcCell(const FVector::FReal X, const FVector::FReal Y) const
+	{
+		return FIntPoint(FMath::FloorToInt32(X / CellSize), FMath::FloorToInt32(Y / CellSize));
+	}
+
+	/** 遍历坐标范围内的非空格子，返回这些格子中的实体总数 */
+	template<typename TFunc>
+	int32 ForEachCell(const FIntPoint& MinCell, const FIntPoint& MaxCell, TFunc&& Func) const;
+
+	/** 按格子遍历与范围重叠的实体，返回访问过的格子中的实体总数 */
+	template<typename TFunc>
+	int32 ForEachOverlapping(const FBox& Bounds, const FMassSpatialIndexLayerMask LayerMask, TFunc&& Func) const;
+
+	/** 按格子排序的实体 */
+	TArray<FMassSpatialIndexSnapshotItem> Items;
+
+	/** 非空格子，按坐标排序（先 X 后 Y） */
+	TArray<FCell> Cells;
+
+	/** 格子坐标到 Cells 下标 */
+	TMap<FIntPoint, int32> CellLookup;
+
+	/** 非空格子坐标的范围，最近邻查询搜索到这里为止 */
+	FIntPoint MinCellCoord = FIntPoint::ZeroValue;
+	FIntPoint MaxCellCoord = FIntPoint::ZeroValue;
+
+	/** 构建时的排序键，保留以复用内存 */
+	TArray<TPair<uint64, int32>> SortKeys;
+
+	float CellSize = 100.f;
+
+	/** 所有实体中的最大半径，决定查询需要扩展的格子范围 */
+	float MaxRadius = 0.f;
+
+	uint64 FrameNumber = 0;
+};
+
+/**
+ * 统一空间索引的双缓冲只读快照
+ *
+ * UMassSpatialIndexProcessor 在第 N 帧更新完实时索引后把它复制到后台缓冲，第 N+1 帧的 PrePhysics 阶段开始时
+ * （此时没有任何处理器在运行）交换前后台缓冲。于是第 N+1 帧中读取快照的处理器看到的是第 N 帧的索引，
+ * 而写入者只写后台缓冲，两者不会同时访问同一份数据。
+ *
+ * 读取者只需声明对本子系统的只读依赖，不必依赖 UMassSpatialIndexSubsystem，因此不会被排在索引更新之后，
+ * 可以与之并行执行。代价是快照中的位置比实时索引晚一帧，需要精确结果的读取者应按每帧的最大位移扩大查询范围，
+ * 并用实体当前的片段做最终判断。写入者有意不声明对本子系统的依赖，双缓冲保证了它与读取者互不干扰。
+ */
+UCLASS()
+class MASSSPATIALINDEX_API UMassSpatialIndexSnapshotSubsystem : public UMassSubsystemBase
+{
+	GENERATED_BODY()
+
+public:
+	/** 上一帧发布的快照，只读，可在多个工作线程上同时查询 */
+	const FMassSpatialIndexSnapshot& GetSnapshot() const { return Snapshots[PublishedIndex]; }
+
+	/** 后台缓冲，只由 UMassSpatialIndexProcessor 写入 */
+	FMassSpatialIndexSnapshot& GetBackBuffer() { return Snapshots[PublishedIndex ^ 1]; }
+
+	/** 标记后台缓冲已构建完成，下一次阶段开始时发布 */
+	void MarkBackBufferReady() { bBackBufferReady = true; }
+
+protected:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+	/** 在 PrePhysics 阶段开始时交换前后台缓冲 */
+	void PublishSnapshot(const float DeltaSeconds);
+
+	FMassSpatialIndexSnapshot Snapshots[2];
+
+	int32 PublishedIndex = 0;
+
+	bool bBackBufferReady = false;
+
+	FDelegateHandle PhaseStartedHandle;
+};
+
+template<>
+struct TMassExternalSubsystemTraits<UMassSpatialIndexSnapshotSubsystem> final
+{
+	enum
+	{
+		GameThreadOnly = false
+	};
+};
@@ -0,0 +1,109 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include <atomic>
+
+/** 空间索引的统计（查询开销计数、占用统计、控制台输出、CSV 与热力图），发行版本中整体编译掉 */
+#ifndef WITH_MASSSPATIALINDEX_STATS
+#define WITH_MASSSPATIALINDEX_STATS !UE_BUILD_SHIPPING
+#endif
+
+class UMassSpatialIndexSubsystem;
+struct FMassSpatialIndexSnapshot;
+
+#if WITH_MASSSPATIALINDEX_STATS
+
+/**
+ * @brief 统一空间索引的统计
+ *
+ * 查询开销只在 MassSpatialIndex.Stats.Enable 打开时累计，候选是查询在网格中检查过的元素，命中是最终输出的结果。
+ * 占用统计在需要时从索引重新计算，不在每帧的更新中维护。
+ */
+namespace UE::MassSpatialIndex::Stats
+{
+	/** 是否累计查询开销 */
+	extern MASSSPATIALINDEX_API bool bEnabled;
+
+	/** 一类查询的累计开销，可在多个工作线程上同时累加 */
+	struct FQueryCounters
+	{
+		std::atomic<int64> NumQueries = 0;
+		std::atomic<int64> NumCandidates = 0;
+		std::atomic<int64> NumHits = 0;
+
+		void Add(const int64 Queries, const int64 Candidates, const int64 Hits)
+		{
+			NumQueries.fetch_add(Queries, std::memory_order_relaxed);
+			NumCandidates.fetch_add(Candidates, std::memory_order_relaxed);
+			NumHits.fetch_add(Hits, std::memory_order_relaxed);
+		}
+
+		void Reset()
+		{
+			NumQueries = 0;
+			NumCandidates = 0;
+			NumHits = 0;
+		}
+	};
+
+	/** 实时索引（UMassSpatialIndexSubsystem）上的查询，候选是网格返回的槽位，命中是通过图层过滤的槽位 */
+	extern MASSSPATIALINDEX_API FQueryCounters LiveQueries;
+
+	/** 快照上的查询，候选是访问过的格子中的实体，命中是满足范围或距离条件的实体 */
+	extern MASSSPATIALINDEX_API FQueryCounters SnapshotQueries;
+
+	/** 占用直方图的区间数：1、2、3-4、5-8 ... 129 个及以上 */
+	constexpr int32 NumHistogramBuckets = 9;
+
+	/** 一个非空格子 */
+	struct FCellOccupancy
+	{
+		FIntPoint Coord = FIntPoint::ZeroValue;
+		int32 NumItems = 0;
+
+		/** 格子中实体的平均高度，用于绘制热力图 */
+		float AverageZ = 0.f;
+	};
+
+	/** 一层网格的占用情况 */
+	struct FLevelOccupancy
+	{
+		float CellSize = 0.f;
+		int32 NumItems = 0;
+		int32 MaxItems = 0;
+
+		/** 非空格子，顺序不保证 */
+		TArray<FCellOccupancy> Cells;
+
+		/** 第 i 个区间统计实体数量在 (2^(i-1), 2^i] 内的格子数 */
+		int32 Histogram[NumHistogramBuckets] = {};
+	};
+
+	/**
+	 * 统计实时索引各层的占用情况
+	 * @param SpatialIndex 实时索引
+	 * @param OutLevels 输出每层一项
+	 */
+	MASSSPATIALINDEX_API void CollectOccupancy(const UMassSpatialIndexSubsystem& SpatialIndex, TArray<FLevelOccupancy>& OutLevels);
+
+	/**
+	 * 统计快照的占用情况
+	 * @param Snapshot 快照
+	 * @param OutLevel 快照只有一层
+	 */
+	MASSSPATIALINDEX_API void CollectOccupancy(const FMassSpatialIndexSnapshot& Snapshot, FLevelOccupancy& OutLevel);
+}
+
+/** 记录一次或一批查询的开销，统计关闭时只有一次分支 */
+#define MASSSPATIALINDEX_RECORD_QUERIES(Counters, Queries, Candidates, Hits) \
+	do { if (UE::MassSpatialIndex::Stats::bEnabled) { UE::MassSpatialIndex::Stats::Counters.Add((Queries), (Candidates), (Hits)); } } while (0)
+
+#else
+
+// 参数只在这里使用时避免未使用变量的警告
+#define MASSSPATIALINDEX_RECORD_QUERIES(Counters, Queries, Candidates, Hits) \
+	do { (void)(Queries); (void)(Candidates); (void)(Hits); } while (0)
+
+#endif
@@ -0,0 +1,205 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HierarchicalHashGrid2D.h"
+#include "MassEntityHandle.h"
+#include "MassExternalSubsystemTraits.h"
+#include "MassSpatialIndexStats.h"
+#include "MassSubsystemBase.h"
+#include "MassSpatialIndexSubsystem.generated.h"
+
+struct FMassExecutionContext;
+
+/*
+* 所有插件共用的分层哈希网格
+* 2 表示层级数，4 表示上层单元格是下层的 4 倍；网格中存储的是 UMassSpatialIndexSubsystem 中的槽位下标。
+*/
+typedef THierarchicalHashGrid2D<2, 4, int32> FMassSpatialIndexGrid;
+
+/** 单个图层在掩码中占一位，最多32个图层 */
+typedef uint32 FMassSpatialIndexLayerMask;
+
+/**
+ * 统一的空间索引
+ *
+ * 以前 RTS 编队、BulletHell、碰撞与哈希网格示例各自维护一份哈希网格，同时属于多个系统的实体会被重复索引、每帧重复更新。
+ * 现在所有带 FMassSpatialIndexFragment 的实体只在这里索引一次：每个实体占一个槽位，网格中存储槽位下标，
+ * 槽位记录实体的位置、半径与所属图层的掩码。
+ *
+ * 图层按名字注册，并绑定一个片段或标签类型；原型中包含该类型的实体自动属于该图层，因此实体改变标签后图层随之更新。
+ * 查询时传入图层掩码，只返回属于其中任一图层的实体。
+ *
+ * 槽位数据由 UMassSpatialIndexProcessor 在每帧的一次并行更新中写入，之后的处理器可以在多个线程上同时查询。
+ * 不需要本帧位置的查询者可以改用 UMassSpatialIndexSnapshotSubsystem 中上一帧的只读快照。
+ */
+UCLASS()
+class MASSSPATIALINDEX_API UMassSpatialIndexSubsystem : public UMassSubsystemBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * 注册图层，同名图层只注册一次
+	 * @param LayerName 图层名
+	 * @param MembershipType 决定成员资格的片段或标签类型
+	 * @return 图层掩码，图层已满时返回0
+	 */
+	FMassSpatialIndexLayerMask RegisterLayer(const FName LayerName, const UScriptStruct* MembershipType);
+
+	/** 按名字获取图层掩码，未注册时返回0 */
+	FMassSpatialIndexLayerMask GetLayerMask(const FName LayerName) const;
+
+	/**
+	 * 按当前区块的原型计算所属图层
+	 * @param Context 正在处理的区块
+	 */
+	FMassSpatialIndexLayerMask CalcLayerMask(const FMassExecutionContext& Context) const;
+
+	/**
+	 * 查询与范围重叠、且属于任一指定图层的槽位；只读，可在多个工作线程上同时调用
+	 * @param Bounds 查询范围
+	 * @param LayerMask 图层掩码
+	 * @param OutSlots 追加输出的槽位
+	 */
+	void Query(const FBox& Bounds, const FMassSpatialIndexLayerMask LayerMask, TArray<int32>& OutSlots) const;
+
+	/**
+	 * 与 Query 相同，输出实体句柄
+	 * @param Bounds 查询范围
+	 * @param LayerMask 图层掩码
+	 * @param OutEntities 追加输出的实体
+	 */
+	void QueryEntities(const FBox& Bounds, const FMassSpatialIndexLayerMask LayerMask, TArray<FMassEntityHandle>& OutEntities) const;
+
+	/** 槽位总数（含空闲槽位），可用于为按槽位索引的数组分配空间 */
+	int32 GetNumSlots() const { return Entities.Num(); }
+
+	/** 属于任一指定图层的实体数量 */
+	int32 GetNumItems(const FMassSpatialIndexLayerMask LayerMask) const;
+
+	FMassEntityHandle GetEntity(const int32 Slot) const { return Entities[Slot]; }
+	const FVector& GetLocation(const int32 Slot) const { return Locations[Slot]; }
+	float GetRadius(const int32 Slot) const { return Radii[Slot]; }
+	FMassSpatialIndexLayerMask GetSlotLayerMask(const int32 Slot) const { return LayerMasks[Slot]; }
+
+	/**
+	 * 分配槽位并加入网格，由 UMassSpatialIndexInitializerProcessor 调用
+	 * @return 分配的槽位
+	 */
+	int32 AddSlot(const FMassEntityHandle Entity, const FVector& Location, const float Radius, const FMassSpatialIndexLayerMask LayerMask);
+
+	/** 从网格中移除并归还槽位 */
+	void RemoveSlot(const int32 Slot);
+
+	/**
+	 * 本帧更新之后再移动单个槽位，例如碰撞阶段把快速移动的实体停在接触前；只能在单线程中调用
+	 * @param Slot 槽位
+	 * @param Location 新位置
+	 */
+	void MoveSlot(const int32 Slot, const FVector& Location);
+
+	/**
+	 * 写入槽位的位置、半径与图层，并计算新的格子；每个槽位只写自己的数据，可在多个工作线程上同时调用
+	 * @param OutNewCellLocation 格子变化时输出新的格子
+	 * @return 格子是否变化，变化时需要随后在单线程中调用 ApplyCellChange
+	 */
+	bool UpdateSlot(const int32 Slot, const FVector& Location, const float Radius, const FMassSpatialIndexLayerMask LayerMask,
+		FMassSpatialIndexGrid::FCellLocation& OutNewCellLocation);
+
+	/** 把槽位移到 UpdateSlot 算出的新格子 */
+	void ApplyCellChange(const int32 Slot, const FMassSpatialIndexGrid::FCellLocation& NewCellLocation);
+
+	/**
+	 * 标记槽位的实体是否静止，静止的槽位在每帧的更新中只刷新图层，位置与格子保持不变；
+	 * 由知道实体是否静止的系统（例如碰撞的睡眠）写入，解除标记的一方负责在实体移动前后用 MoveSlot 同步位置。
+	 * 每个槽位只写自己的标记，可在多个工作线程上同时调用
+	 */
+	void SetSlotResting(const int32 Slot, const bool bResting) { Resting[Slot] = bResting; }
+	bool IsSlotResting(const int32 Slot) const { return Resting[Slot] != 0; }
+
+	/** 只写入槽位的图层，用于跳过位置更新的静止槽位；可在多个工作线程上同时调用 */
+	void SetSlotLayerMask(const int32 Slot, const FMassSpatialIndexLayerMask LayerMask) { LayerMasks[Slot] = LayerMask; }
+
+	const FMassSpatialIndexGrid& GetGrid() const { return Grid; }
+
+	/** 槽位当前所在的格子 */
+	const FMassSpatialIndexGrid::FCellLocation& GetCellLocation(const int32 Slot) const { return CellLocations[Slot]; }
+
+	/** 最底层网格的格子边长；自动调整打开时快照也使用该值 */
+	float GetCellSize() const { return CellSize; }
+
+	/** 是否根据查询的候选数自动调整格子边长 */
+	static bool IsCellSizeAutoTuned();
+
+	/**
+	 * 以新的格子边长重建网格，所有槽位重新插入；只能在没有处理器读写索引时调用
+	 * @param NewCellSize 最底层网格的格子边长
+	 */
+	void RebuildGrid(const float NewCellSize);
+
+protected:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+private:
+	/** 在 PrePhysics 阶段开始时（此时没有处理器在读写索引）调整格子边长并记录统计 */
+	void OnPhaseStarted(const float DeltaSeconds);
+
+	/**
+	 * 按每次查询的平均候选数（打开统计时取实际记录的值，否则由上一帧快照的占用估算）调整格子边长，
+	 * 与当前边长相差足够大时重建网格
+	 * @param DeltaSeconds 本帧时长
+	 */
+	void TuneCellSize(const float DeltaSeconds);
+
+#if WITH_MASSSPATIALINDEX_STATS
+	/** 记录 CSV 统计并绘制热力图，实现在 MassSpatialIndexStats.cpp */
+	void RecordStats(const float DeltaSeconds);
+#endif
+
+	FDelegateHandle PhaseStartedHandle;
+
+	struct FLayer
+	{
+		FName Name;
+		const UScriptStruct* MembershipType = nullptr;
+	};
+
+	TArray<FLayer> Layers;
+
+	float CellSize = 100.f;
+
+	FMassSpatialIndexGrid Grid = FMassSpatialIndexGrid(CellSize);
+
+	/** 距离上一次调整格子边长的时间 */
+	float TimeSinceCellSizeTune = 0.f;
+
+#if WITH_MASSSPATIALINDEX_STATS
+	/** 上一次调整格子边长时查询计数器的值，用于计算这段时间内每次查询的候选数 */
+	int64 LastTuneNumQueries = 0;
+	int64 LastTuneNumCandidates = 0;
+#endif
+
+	/** 槽位所属的实体，空闲槽位为无效句柄 */
+	TArray<FMassEntityHandle> Entities;
+	TArray<FVector> Locations;
+	TArray<float> Radii;
+	TArray<FMassSpatialIndexLayerMask> LayerMasks;
+	TArray<FMassSpatialIndexGrid::FCellLocation> CellLocations;
+
+	/** 见 SetSlotResting */
+	TArray<uint8> Resting;
+
+	TArray<int32> FreeSlots;
+};
+
+template<>
+struct TMassExternalSubsystemTraits<UMassSpatialIndexSubsystem> final
+{
+	enum
+	{
+		GameThreadOnly = false
+	};
+};
@@ -18,31 +18,31 @@ EStateTreeRunStatus FMW_FindRandomLocationTask::EnterState(FStateTreeExecutionCo
 	const FStateTreeTransitionResult& Transition) const
 {
 	/**
- * ִ״̬ڵ߼ڲλ
+ * 执行状态节点逻辑，用于查找随机位置
  * 
- * @param Context ״ִ̬ģʵݺⲿݵķʽӿ
- * @param Transition ״̬תϢ״̬ı
- * @return EStateTreeRunStatus::Running ״̬ʾڵִ
+ * @param Context 状态树执行上下文，包含实例数据和外部数据的访问接口
+ * @param Transition 状态转换信息，包含状态改变类型
+ * @return EStateTreeRunStatus::Running 返回运行状态，表示节点仍在执行中
  * 
- * úȼ״̬Ƿı䣬ûиıֱӷ״̬
- * ״̬ı䣬һƫλã洢ʵݵλС
+ * 该函数首先检查状态是否发生改变，如果没有改变则直接返回运行状态。
+ * 如果状态发生改变，则计算一个随机偏移位置，并将其存储在实例数据的输出位置中。
  */
 if (Transition.ChangeType != EStateTreeStateChangeType::Changed) { return EStateTreeRunStatus::Running; }
-// ʼCPUܷ¼Χܼ
+// 开始CPU性能分析器事件范围，用于性能监控
 
 	TRACE_CPUPROFILER_EVENT_SCOPE(ST_FindRandomLocation)
 
-	// ȡʵãΧ
+	// 获取实例数据引用，包含范围参数
 	FInstanceDataType& InstanceData = Context.GetInstanceData(*this);
 	const float Range = InstanceData.Range;
 	
-	// ȡⲿ任ݣڼ㵱ǰλ
+	// 获取外部变换数据，用于计算当前位置
 	FTransformFragment& Transform = Context.GetExternalData(TransformHandle);
 	
-	// ƫλãXYڷΧһɣZΪ0
+	// 计算随机偏移位置，X和Y坐标在范围的一半内随机生成，Z坐标为0
 	const auto NewOffset = FVector(FMath::RandRange(Range / 2 * -1, Range / 2), FMath::RandRange(Range / 2 * -1, Range / 2), 0.f);
 
-	// ǰλƫӣõµĿλò洢
+	// 将当前位置与随机偏移相加，得到新的目标位置并存储到输出变量中
 	InstanceData.OutLocation = Transform.GetTransform().GetLocation() + NewOffset;
 
 	return EStateTreeRunStatus::Running;
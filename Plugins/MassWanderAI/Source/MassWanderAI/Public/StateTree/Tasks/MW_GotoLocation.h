@@ -11,10 +11,10 @@ struct FTransformFragment;
 struct FMassMoveTargetFragment;
 
 /**
- * @brief GotoLocationΪڵʵݽṹ
+ * @brief GotoLocation行为节点的实例数据结构体
  * 
- * ýṹڴ洢ʹGotoLocationΪڵִйеݣ
- * Ŀλú嵱ǰλõϢ
+ * 该结构体用于存储和传递GotoLocation行为节点在执行过程中的数据，
+ * 包含目标位置和智能体当前位置等信息。
  */
 USTRUCT()
 struct MASSWANDERAI_API FMW_GotoLocationInstanceData
@@ -22,25 +22,25 @@ struct MASSWANDERAI_API FMW_GotoLocationInstanceData
 	GENERATED_BODY()
 
 	/**
-	 * @brief Ŀλ
+	 * @brief 目标位置
 	 * 
-	 * 洢ҪǰĿλ
+	 * 存储智能体需要前往的目标世界坐标位置
 	 */
 	UPROPERTY(EditAnywhere, Category = Input)
 	FVector Destination;
 
 	/**
-	 * @brief 嵱ǰλ
+	 * @brief 智能体当前位置
 	 * 
-	 * 洢嵱ǰλãͨΪʹ
+	 * 存储智能体当前的世界坐标位置，通常作为输出数据使用
 	 */
 	UPROPERTY(EditAnywhere, Category = Output)
 	FVector AgentLocation;
 
 	/**
-	 * @brief ĬϹ캯
+	 * @brief 默认构造函数
 	 * 
-	 * ʹĬʵֳʼṹԱ
+	 * 使用默认实现初始化结构体成员
 	 */
 	FMW_GotoLocationInstanceData() = default;
 };
@@ -1,278 +0,0 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-
-#include "RTSAgentProcessors.h"
-
-#include "MassCommonFragments.h"
-#include "MassEntitySubsystem.h"
-#include "MassExecutionContext.h"
-#include "RTSAgentTraits.h"
-#include "Engine/World.h"
-
-//----------------------------------------------------------------------//
-//  URTSUpdateHashPosition
-//
-//  :
-//      ڸʵڹϣеλáͨѯضƬκͱǩʵ壬
-//      ʵ嵱ǰλ뾶Ϣ¼ڵԪλãµϵͳС
-//
-//  ִ:
-//      1. Ҫʵѯ
-//      2. ִн׶αзʵ飨chunk
-//      3. ÿʵȡ任ǰλü뾶ݣ
-//      4. λø¸ʵڹϣеλã
-//----------------------------------------------------------------------//
-
-//----------------------------------------------------------------------//
-//  ConfigureQueries
-//
-//  :
-//       EntityQuery ѯƬκͱǩҪԱɸѡʵ弯.
-//
-//  ˵:
-//      EntityManager - ʵãڷʺ͹ϵͳڵʵ弰Դ.
-//
-//  ֵ˵:
-//      ޷ֵ.
-//
-//  ע:
-//      
-//          - FTransformFragment: ֻʣڻȡʵꣻ
-//          - FRTSCellLocFragment: дʣ¼ʵԪλã
-//          - FAgentRadiusFragment: ֻʣʾʵӰ췶Χײ뾶
-//          - FRTSAgentHashTag: ڴ˱ǩԱʶ RTS ϣϵͳĴ
-//          - URTSAgentSubsystem: дȨޣʵʽйϣĲ
-//----------------------------------------------------------------------//
-void URTSUpdateHashPosition::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
-{
-	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
-	EntityQuery.AddRequirement<FRTSCellLocFragment>(EMassFragmentAccess::ReadWrite);
-	EntityQuery.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly);
-	EntityQuery.AddTagRequirement<FRTSAgentHashTag>(EMassFragmentPresence::All);
-	EntityQuery.AddSubsystemRequirement<URTSAgentSubsystem>(EMassFragmentAccess::ReadWrite);
-}
-
-//----------------------------------------------------------------------//
-//  캯
-//
-//  :
-//      ʼ URTSUpdateHashPosition ʵ EntityQuery ǰ.
-//
-//  ˵:
-//      ʽʹóʼб EntityQuery  *this .
-//
-//  ֵ˵:
-//      ޷ֵ.
-//----------------------------------------------------------------------//
-URTSUpdateHashPosition::URTSUpdateHashPosition()
-	: EntityQuery(*this)
-{
-}
-
-//----------------------------------------------------------------------//
-//  Execute
-//
-//  :
-//      ִ߼ƥѯʵ鲢ڹϣеλ.
-//
-//  ˵:
-//      EntityManager - ʵãṩʵϵͳķ
-//      Context       - ǰִģڴһʵ弰ͼ
-//
-//  ֵ˵:
-//      ޷ֵ.
-//
-//  ؼ˵:
-//      1. ʹ EntityQuery зҪʵ飻
-//      2. ȡƬεͼֻͿɱƬΣ
-//      3. ѭÿһеÿһʵ壻
-//      4. µı߽򣬲 AgentSubsystem ¹ϣеλã
-//----------------------------------------------------------------------//
-void URTSUpdateHashPosition::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
-{
-	// ѯʵ(chunk)
-	EntityQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
-		{
-			// ȡƬεֻ/дͼ
-			TConstArrayView<FTransformFragment> TransformFragments = Context.GetFragmentView<FTransformFragment>();
-			auto CellLocFragments = Context.GetMutableFragmentView<FRTSCellLocFragment>();
-			TConstArrayView<FAgentRadiusFragment> RadiusFragments = Context.GetFragmentView<FAgentRadiusFragment>();
-			auto& AgentSubsystem = Context.GetMutableSubsystemChecked<URTSAgentSubsystem>();
-
-			// ǰ chunk еʵ
-			for (int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); ++EntityIndex)
-			{
-				// ȡǰʵ
-				auto& CellLocFragment = CellLocFragments[EntityIndex];
-				const FVector& Location = TransformFragments[EntityIndex].GetTransform().GetLocation();
-				const float Radius = RadiusFragments[EntityIndex].Radius;
-
-				// µİΧУZ仯XYƽӰ췶Χ
-				const FBox NewBounds(Location - FVector(Radius, Radius, 0.f), Location + FVector(Radius, Radius, 0.f));
-
-				// ϵͳӿƶʵڹϣеλ
-				CellLocFragment.CellLoc = AgentSubsystem.AgentHashGrid.Move(Context.GetEntity(EntityIndex), CellLocFragment.CellLoc, NewBounds);
-			}
-		});
-}
-
-//----------------------------------------------------------------------//
-//  URTSInitializeHashPosition
-//
-//  :
-//    ڳʼʵڹϣеλϢ̳ EntityQueryͨѯض͵ʵΪϣ꣬
-//    Щʵעᵽ URTSAgentSubsystem нͳһͬʱΪʵ FRTSAgentHashTag ǩԱʶѴϡ
-//
-//  캯˵:
-//    URTSInitializeHashPosition()
-//      ʼ ObservedType Ϊ FRTSFormationAgent ͽṹ壬 Operation Ϊ Addʾôע¼Ĵʵ
-//
-//----------------------------------------------------------------------//
-URTSInitializeHashPosition::URTSInitializeHashPosition()
-	: EntityQuery(*this)
-{
-	ObservedType = FRTSFormationAgent::StaticStruct();
-	Operation = EMassObservedOperation::Add;
-}
-
-
-//----------------------------------------------------------------------//
-//  ConfigureQueries
-//
-//  :
-//    õǰʹõ EntityQuery ѯҪд Fragment  Subsystem Ҫ
-//
-//  ˵:
-//    EntityManager - ʵãעòѯ߼
-//
-//----------------------------------------------------------------------//
-void URTSInitializeHashPosition::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
-{
-	// Ӷ FRTSCellLocFragment ĶдȨҪڼ¼λã
-	EntityQuery.AddRequirement<FRTSCellLocFragment>(EMassFragmentAccess::ReadWrite);
-
-	// Ӷ FTransformFragment ֻȨҪ󣨻ȡʵ꣩
-	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
-
-	// Ӷ FAgentRadiusFragment ֻȨҪ󣨻ȡ뾶ڹ߽
-	EntityQuery.AddRequirement<FAgentRadiusFragment>(EMassFragmentAccess::ReadOnly);
-
-	// Ҫʵ岻 FRTSAgentHashTag ǩظ
-	EntityQuery.AddTagRequirement<FRTSAgentHashTag>(EMassFragmentPresence::None);
-
-	// Ӷ URTSAgentSubsystem ϵͳĶдȨޣϣʵ壩
-	EntityQuery.AddSubsystemRequirement<URTSAgentSubsystem>(EMassFragmentAccess::ReadWrite);
-
-	// ˲ѯ뵱ǰ Processor Աִʱʹ
-	EntityQuery.RegisterWithProcessor(*this);
-}
-
-//----------------------------------------------------------------------//
-//  Execute
-//
-//  :
-//    ִ߼зʵ飨chunkÿʵλò뵽ϣУȻϱǩֹٴδ
-//
-//  ˵:
-//    EntityManager - ʵṩʵݵĲӿ
-//    Context       - ǰִģǰεͼִл
-//
-//----------------------------------------------------------------------//
-void URTSInitializeHashPosition::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
-{
-	// ÿһʵе
-	EntityQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
-		{
-			// ȡ任ƬΡԪλƬԼ뾶Ƭεֻ/ɱͼ
-			TConstArrayView<FTransformFragment> TransformFragments = Context.GetFragmentView<FTransformFragment>();
-			auto CellLocFragments = Context.GetMutableFragmentView<FRTSCellLocFragment>();
-			TConstArrayView<FAgentRadiusFragment> RadiusFragments = Context.GetFragmentView<FAgentRadiusFragment>();
-
-			// ȡ RTS Agent ϵͳʵҿ޸ģ
-			auto& AgentSubsystem = Context.GetMutableSubsystemChecked<URTSAgentSubsystem>();
-
-			// ǰ chunk ڵʵ
-			for (int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); ++EntityIndex)
-			{
-				// ȡǰʵӦ CellLoc Ƭ
-				auto& CellLocFragment = CellLocFragments[EntityIndex];
-
-				// ȡʵ
-				const FVector& Location = TransformFragments[EntityIndex].GetTransform().GetLocation();
-
-				// ȡʵײ뾶
-				const float Radius = RadiusFragments[EntityIndex].Radius;
-
-				// ڵǰλúͰ뾶һάΧУ Z 仯
-				const FBox NewBounds(Location - FVector(Radius, Radius, 0.f), Location + FVector(Radius, Radius, 0.f));
-
-				// ־ǰϣеʵ;
-				UE_LOG(LogTemp, Log, TEXT("Agents: %d"), AgentSubsystem.AgentHashGrid.GetItems().Num());
-
-				// ǰʵ弰Χӽϣ񣬲ڵ
-				CellLocFragment.CellLoc = AgentSubsystem.AgentHashGrid.Add(Context.GetEntity(EntityIndex), NewBounds);
-
-				// ƳִУǰʵ FRTSAgentHashTag ǩɳʼ
-				Context.Defer().AddTag<FRTSAgentHashTag>(Context.GetEntity(EntityIndex));
-			}
-		});
-}
-//----------------------------------------------------------------------//
-//  URTSRemoveHashPosition
-//----------------------------------------------------------------------//
-
-/**
- * 캯ʼURTSRemoveHashPositionѯ
- * ù۲ʵΪFRTSFormationAgentṹ
- * òΪƳ
- */
-URTSRemoveHashPosition::URTSRemoveHashPosition()
-	: EntityQuery(*this)
-{
-	ObservedType = FRTSFormationAgent::StaticStruct();
-	Operation = EMassObservedOperation::Remove;
-}
-
-/**
- * òѯʵƬκϵͳҪ
- * @param EntityManager ʵãעòѯ
- */
-void URTSRemoveHashPosition::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
-{
-	// ֻĵԪλƬ
-	EntityQuery.AddRequirement<FRTSCellLocFragment>(EMassFragmentAccess::ReadOnly);
-	// ӶдȨ޵RTSϵͳ
-	EntityQuery.AddSubsystemRequirement<URTSAgentSubsystem>(EMassFragmentAccess::ReadWrite);
-	// ѯעᵽǰ
-	EntityQuery.RegisterWithProcessor(*this);
-}
-
-/**
- * ִƳϣλõĲ
- * зʵ飬ӴϵͳĹϣƳʵλϢ
- * @param EntityManager ʵ
- * @param Context ִģǰʵϢ
- */
-void URTSRemoveHashPosition::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
-{
-	// ʵ
-	EntityQuery.ForEachEntityChunk(Context, [this](FMassExecutionContext& Context)
-		{
-			// ȡԪλƬͼ
-			auto CellLocFragments = Context.GetFragmentView<FRTSCellLocFragment>();
-			// ȡɱĴϵͳ
-			auto& AgentSubsystem = Context.GetMutableSubsystemChecked<URTSAgentSubsystem>();
-
-			// ǰеʵ
-			for (int32 EntityIndex = 0; EntityIndex < Context.GetNumEntities(); ++EntityIndex)
-			{
-				// ȡǰRTSĵԪλϢ
-				const auto& RTSAgent = CellLocFragments[EntityIndex];
-
-				// ӹϣƳʵ弰λϢ
-				AgentSubsystem.AgentHashGrid.Remove(Context.GetEntity(EntityIndex), RTSAgent.CellLoc);
-			}
-		});
-}
-
-
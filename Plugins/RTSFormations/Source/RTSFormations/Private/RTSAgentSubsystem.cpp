@@ -6,41 +6,73 @@
 #include "LaunchEntityProcessor.h"
 #include "MassCommandBuffer.h"
 #include "MassEntitySubsystem.h"
+#include "RTSAgentTraits.h"
 #include "Engine/World.h"
 
+const FName URTSAgentSubsystem::LayerName = FName(TEXT("RTSAgent"));
+
 /**
- * ָλúͰ뾶Χʵ
+ * 初始化子系统，在统一空间索引中注册 RTS 智能体图层
  * 
- * @param Location ʵλ
- * @param Radius ʵİ뾶Χ
+ * @param Collection 子系统集合
+ */
+void URTSAgentSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SpatialIndex = Collection.InitializeDependency<UMassSpatialIndexSubsystem>();
+	SpatialIndexSnapshot = Collection.InitializeDependency<UMassSpatialIndexSnapshotSubsystem>();
+	if (SpatialIndex)
+	{
+		LayerMask = SpatialIndex->RegisterLayer(LayerName, FRTSFormationAgent::StaticStruct());
+	}
+}
+
+/**
+ * 在指定位置和半径范围内启动实体
+ * 
+ * @param Location 启动实体的位置坐标
+ * @param Radius 搜索实体的半径范围
  */
 void URTSAgentSubsystem::LaunchEntities(const FVector& Location, float Radius) const
 {
 	TRACE_CPUPROFILER_EVENT_SCOPE(TEXT("LaunchEntities"));
 
-	// ȡеʵϵͳ
+	// 获取世界中的实体子系统
 	UMassEntitySubsystem* EntitySubsystem = GetWorld()->GetSubsystem<UMassEntitySubsystem>();
 
-	// ѯ뾶Χڵʵ
+	// 查询半径范围内的实体
 	TArray<FMassEntityHandle> Entities;
-	const FBox Bounds(Location - FVector(Radius, Radius, 0.f), Location + FVector(Radius, Radius, 0.f));
-	AgentHashGrid.QuerySmall(Bounds, Entities);
+	if (SpatialIndexSnapshot)
+	{
+		TArray<FMassSpatialIndexQueryResult> Results;
+		SpatialIndexSnapshot->GetSnapshot().QueryRadius(Location, Radius, LayerMask, Results);
+		Entities.Reserve(Results.Num());
+		for (const FMassSpatialIndexQueryResult& Result : Results)
+		{
+			Entities.Add(Result.Entity);
+		}
+	}
 
 	if (EntitySubsystem)
 	{
-		// ʵƬβò
+		// 快照来自上一帧，其中的实体可能已被销毁
+		const FMassEntityManager& EntityManager = EntitySubsystem->GetEntityManager();
+		Entities.RemoveAllSwap([&EntityManager](const FMassEntityHandle& Entity) { return !EntityManager.IsEntityValid(Entity); });
+
+		// 创建启动实体片段并设置参数
 		FLaunchEntityFragment LaunchEntityFragment;
 		LaunchEntityFragment.Origin = Location;
 		LaunchEntityFragment.Magnitude = 500.f;
 
-		// ΪѯÿʵƬ
+		// 为查询到的每个实体添加启动片段
 		for (const FMassEntityHandle& Entity : Entities)
 		{
 			EntitySubsystem->GetEntityManager().Defer().PushCommand<FMassCommandAddFragmentInstances>(Entity,
 				LaunchEntityFragment);
 		}
 		
-		// ӳźŸӰʵ壨Ϊ۲߻Ƶ
+		// 发送延迟信号给所有受影响的实体（作为观察者机制的替代方案）
 		if (Entities.Num())
 			GetWorld()->GetSubsystem<UMassSignalSubsystem>()->DelaySignalEntities(LaunchEntity, Entities, 0.1f);
 	}
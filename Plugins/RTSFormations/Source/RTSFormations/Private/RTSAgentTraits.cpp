@@ -6,31 +6,38 @@
 #include "MassCommonFragments.h"
 #include "MassEntitySubsystem.h"
 #include "MassEntityTemplateRegistry.h"
+#include "MassSpatialIndexFragments.h"
 #include "MassObserverRegistry.h"
 #include "Engine/World.h"
 
 /**
- * ʵģ壬RTSӴĳʼ
+ * 构建实体模板，用于RTS编队代理的初始化配置
  * 
- * @param BuildContext ʵģ幹ģƬκ͹Ƭεʵģ
- * @param World ǰϷãڻȡʵϵͳʵ
+ * @param BuildContext 实体模板构建上下文，用于添加片段和共享片段到实体模板中
+ * @param World 当前游戏世界对象的引用，用于获取实体子系统和实体管理器
  */
 void URTSFormationAgentTraits::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
 {
-	// ȡеʵϵͳʵ
+	// 获取世界中的实体子系统实例
 	UMassEntitySubsystem* EntitySubsystem = UWorld::GetSubsystem<UMassEntitySubsystem>(&World);
 	
-	// ȡеʵ
+	// 获取世界中的实体管理器引用
 	FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
 	check(EntitySubsystem);
 
-	// RTSӴƬ
+	// 添加RTS编队代理所需的片段
 	BuildContext.AddFragment<FRTSFormationAgent>();
 
-	// ȡ򴴽ùƬΣӵ
+	// 获取或创建编队设置共享片段，并将其添加到构建上下文中
 	auto& FormationSettingsSharedStruct = EntityManager.GetOrCreateConstSharedFragment<FRTSFormationSettings>(FormationSettings);
 	BuildContext.AddConstSharedFragment(FormationSettingsSharedStruct);
 
-	// ӱ任ƬΣڴ洢ʵλáתϢ
+	// 添加变换片段，用于存储实体的位置、旋转和缩放信息
 	BuildContext.AddFragment<FTransformFragment>();
+
+	// 加入统一空间索引，按 FRTSFormationAgent 归入 RTSAgent 图层；其他特性已经添加时不再重复添加
+	if (!BuildContext.HasFragment<FMassSpatialIndexFragment>())
+	{
+		BuildContext.AddFragment<FMassSpatialIndexFragment>();
+	}
 }
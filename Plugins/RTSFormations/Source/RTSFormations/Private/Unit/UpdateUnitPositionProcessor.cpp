@@ -15,7 +15,7 @@ void UUnitProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& Enti
 	EntityQuery.AddSharedRequirement<FUnitFragment>(EMassFragmentAccess::ReadWrite);
 }
 
-//ÿ֡ʱִУԷʵλúתƽֵ
+//在引擎每帧更新时执行，对符合条件的实体进行位置和旋转的平滑插值更新
 void UUnitProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
 {
 	EntityManager.ForEachSharedFragment<FUnitFragment>([&Context](FUnitFragment& UnitFragment)
@@ -6,7 +6,7 @@
 #include "Engine/DataAsset.h"
 #include "FormationPresets.generated.h"
 
-//ö٣ֱ κԲ
+//枚举，定义了两种编队类型 ，矩形和圆形
 UENUM()
 enum class EFormationType : uint8
 {
@@ -17,7 +17,7 @@ enum class EFormationType : uint8
  * 
  */
 
-//ʲڴ洢õıӲ
+//数据资产，用于存储可配置的编队参数
 UCLASS(Blueprintable)
 class RTSFORMATIONS_API UFormationPresets : public UDataAsset
 {
@@ -25,23 +25,23 @@ class RTSFORMATIONS_API UFormationPresets : public UDataAsset
 	
 public:
 
-	//ͣĬϾΣ
+	//编队类型（默认矩形）
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	EFormationType Formation = EFormationType::Rectangle;
 
-	// ӳȣĬ8
+	// 编队长度（默认8）
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	int FormationLength = 8;
 
-	//ӵλࣨĬ100
+	//编队单位间距（默认100）
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	float BufferDistance = 100.f;
 
-	// ԲαӻԲαЧĬ2
+	// 圆形编队环数（仅对圆形编队有效，默认2）
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	int Rings = 2;
 
-	//ԲαǷΪ
+	//圆形编队是否为空心
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	bool bHollow = false;
 };
@@ -14,7 +14,7 @@
  */
 const FName LaunchEntity = FName(TEXT("LaunchEntity"));
 
-// Ӧ LaunchEntityźţ LaunchEntity źŴʱԷʵִз߼
+// 用于响应 LaunchEntity信号，当 LaunchEntity 信号触发时，对符合条件的实体执行发射逻辑
 UCLASS()
 class RTSFORMATIONS_API ULaunchEntityProcessor : public UMassSignalProcessorBase
 {
@@ -28,7 +28,7 @@ class RTSFORMATIONS_API ULaunchEntityProcessor : public UMassSignalProcessorBase
 	TObjectPtr<URTSFormationSubsystem> FormationSubsystem;
 };
 
-// Դʵ˶߼ɸѡҪʵ壬ʵʩ˶״̬
+// 用于周期性处理实体的运动力逻辑，筛选出需要处理的实体，并对实体施加力，更新其运动状态。
 UCLASS()
 class RTSFORMATIONS_API UMoveForceProcessor : public UMassProcessor
 {
@@ -40,7 +40,7 @@ class RTSFORMATIONS_API UMoveForceProcessor : public UMassProcessor
 	FMassEntityQuery EntityQuery = FMassEntityQuery(*this);
 };
 
-// ڴ洢ʵĲ㣬
+// 用于存储发射实体的参数，发射起点，发射力度
 USTRUCT()
 struct RTSFORMATIONS_API FLaunchEntityFragment : public FMassFragment
 {
@@ -53,7 +53,7 @@ struct RTSFORMATIONS_API FLaunchEntityFragment : public FMassFragment
 	float Magnitude = 500.f;
 };
 
-//ͨñǩɸѡմʵ壬ִгʼ߼óʼٶȡ󶨺˶
+//处理器可通过该标签快速筛选出刚触发发射的实体，执行初始化逻辑（如设置初始速度、绑定后续运动处理器）。
 USTRUCT()
 struct RTSFORMATIONS_API FInitLaunchFragment : public FMassTag
 {
@@ -1,59 +0,0 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "MassProcessor.h"
-
-#include "MassObserverProcessor.h"
-
-#include "RTSAgentProcessors.generated.h"
-
-/**
- * 
- */
- // ҪRTSϣʵ
-USTRUCT()
-struct FRTSAgentHashTag : public FMassTag
-{
-	GENERATED_BODY();
-};
-
-// ʵʱʵRTSϣеλ
-UCLASS()
-class RTSFORMATIONS_API URTSUpdateHashPosition : public UMassProcessor
-{
-	GENERATED_BODY()
-
-	URTSUpdateHashPosition();
-	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;;
-	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
-
-	FMassEntityQuery EntityQuery;
-};
-
-// ʵ崴״ FRTSAgentHashTag ǩʱʼΪϣĳԱʼλò
-UCLASS()
-class RTSFORMATIONS_API URTSInitializeHashPosition : public UMassObserverProcessor
-{
-	GENERATED_BODY()
-
-	URTSInitializeHashPosition();
-	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
-	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
-
-	FMassEntityQuery EntityQuery;
-};
-
-// ʵ屻ٻҪϣʱƳ FRTSAgentHashTag ǩӹϣƳ
-UCLASS()
-class RTSFORMATIONS_API URTSRemoveHashPosition : public UMassObserverProcessor
-{
-	GENERATED_BODY()
-
-	URTSRemoveHashPosition();
-	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
-	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
-
-	FMassEntityQuery EntityQuery;
-};
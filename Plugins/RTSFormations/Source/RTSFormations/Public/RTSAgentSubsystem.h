@@ -5,15 +5,15 @@
 #include "CoreMinimal.h"
 #include "Subsystems/WorldSubsystem.h"
 
-#include "HierarchicalHashGrid2D.h"
 #include "MassEntityHandle.h"
 #include "MassExternalSubsystemTraits.h"
+#include "MassSpatialIndexSnapshotSubsystem.h"
+#include "MassSpatialIndexSubsystem.h"
 #include "RTSAgentSubsystem.generated.h"
 
 
-typedef THierarchicalHashGrid2D<2, 4, FMassEntityHandle> RTSAgentHashGrid2D;
 /**
- * 
+ * 带有 FRTSFormationAgent 的实体属于统一空间索引中的 RTSAgent 图层，本子系统负责注册图层与按区域查询
  */
 UCLASS()
 class RTSFORMATIONS_API URTSAgentSubsystem : public UWorldSubsystem
@@ -21,11 +21,24 @@ class RTSFORMATIONS_API URTSAgentSubsystem : public UWorldSubsystem
 	GENERATED_BODY()
 
 public:
-	RTSAgentHashGrid2D AgentHashGrid = RTSAgentHashGrid2D();
+	/** 统一空间索引中的图层名 */
+	static const FName LayerName;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 
 	UFUNCTION(BlueprintCallable, BlueprintPure = false)
 	void LaunchEntities(const FVector& Location, float Radius) const;
-	
+
+private:
+	UPROPERTY(Transient)
+	TObjectPtr<UMassSpatialIndexSubsystem> SpatialIndex;
+
+	/** 上一帧的只读快照，查询时不必等待本帧的索引更新 */
+	UPROPERTY(Transient)
+	TObjectPtr<UMassSpatialIndexSnapshotSubsystem> SpatialIndexSnapshot;
+
+	/** RTS 智能体在统一空间索引中的图层掩码 */
+	FMassSpatialIndexLayerMask LayerMask = 0;
 };
 
 template<>
@@ -24,22 +24,11 @@ struct RTSFORMATIONS_API FRTSFormationAgent : public FMassFragment
 
 	FRTSFormationAgent() = default;
 
-	//ʵڵλӣеƫ
+	//实体在单位（编队）中的偏移
 	FVector3f Offset;
 };
 
-USTRUCT()
-struct FRTSCellLocFragment : public FMassFragment
-{
-	GENERATED_BODY()
-
-	FRTSCellLocFragment() = default;
-	
-	//洢ʵ嵱ǰڵԪڿٿռѯ
-	RTSAgentHashGrid2D::FCellLocation CellLoc;
-};
-
-//λʵ˶
+//单位中实体的运动配置
 USTRUCT()
 struct RTSFORMATIONS_API FRTSFormationSettings : public FMassConstSharedFragment
 {
@@ -9,19 +9,19 @@
  */
 namespace RTS::Unit::Signals
 {
-	// źƳռ
-	// ڶ嵥λصźűʶ
+	// 信号名称常量定义命名空间
+	// 用于定义单位相关的信号标识符
 	
-	// µλλź
-	// λλ÷仯ʱź
+	// 更新单位位置信号
+	// 当单位位置发生变化时触发此信号
 	const FName UpdateUnitPosition = FName(TEXT("UpdateUnitPosition"));
 	
-	// Ӹź
-	// λϢʱź
+	// 编队更新信号
+	// 当单位编队信息发生变更时触发此信号
 	const FName FormationUpdated = FName(TEXT("FormationUpdated"));
 	
-	// ź
-	// ҪµλϢʱź
+	// 更新索引信号
+	// 当需要更新单位索引信息时触发此信号
 	const FName UpdateIndex = FName(TEXT("UpdateIndex"));
 }
 
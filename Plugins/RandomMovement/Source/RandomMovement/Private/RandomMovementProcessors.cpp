@@ -88,19 +88,19 @@ void URandomMovementSignalProcessor::SignalEntities(FMassEntityManager& EntityMa
 }
 
 /**
- * ʼURandomMovementSignalProcessor
+ * 初始化URandomMovementSignalProcessor处理器
  * 
- * @param Owner ߶
- * @param EntityManager ʵĹ
+ * @param Owner 处理器的所有者对象引用
+ * @param EntityManager 实体管理器的共享引用
  */
 void URandomMovementSignalProcessor::InitializeInternal(UObject& Owner, const TSharedRef<FMassEntityManager>& EntityManager)
 {
-	// øĳʼ
+	// 调用父类的初始化方法
 	Super::InitializeInternal(Owner, EntityManager);
 
-	// ȡеMassźϵͳʵ
+	// 获取世界中的Mass信号子系统实例
 	UMassSignalSubsystem* SignalSubsystem = UWorld::GetSubsystem<UMassSignalSubsystem>(Owner.GetWorld());
 
-	// ƶλõź
+	// 订阅随机移动的位置到达信号
 	SubscribeToSignal(*SignalSubsystem, RandomMovement::LocationReached);
 }
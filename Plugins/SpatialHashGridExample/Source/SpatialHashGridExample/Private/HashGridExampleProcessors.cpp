@@ -5,26 +5,16 @@
 
 #include "HashGridFragments.h"
 #include "HashGridSubsystem.h"
+#include "MassCommandBuffer.h"
 #include "MassCommonFragments.h"
 #include "MassExecutionContext.h"
+#include "MassSpatialIndexFragments.h"
 #include "MassSignalSubsystem.h"
 
 
 /**
- * ̬壬ʾϣһ뷶Χֵڿռ仮ּ
- */
-static float HalfRange = 25.f;
-
-/**
- * UHashGridInitializeProcessorĹ캯
- * ʼʵѯ󣬲ù۲ƬͺͲ
- * 
- * 캯ʼб
- * - EntityQuery(*this): ʹõǰʼʵѯ
- * 
- * Աʼ
- * - ObservedType: ΪFHashGridFragmentľ̬ṹϢ
- * - Operation: ΪӲ
+ * UHashGridInitializeProcessor类的构造函数
+ * 观察FHashGridFragment的添加操作
  */
 UHashGridInitializeProcessor::UHashGridInitializeProcessor() :
 	EntityQuery(*this)
@@ -35,173 +25,46 @@ UHashGridInitializeProcessor::UHashGridInitializeProcessor() :
 }
 
 /**
- * ʵѯƬκϵͳҪ
+ * 配置实体查询所需的片段要求
  * 
- * @param EntityManager ʵĹãڹʵƬ
+ * @param EntityManager 实体管理器的共享引用，用于管理实体和片段
  * 
- * úΪEntityQueryҪ
- * - FHashGridFragmentƬεĶдȨ
- * - FTransformFragmentƬεֻȨ  
- * - UHashGridSubsystemϵͳĶдȨ
+ * 该函数为EntityQuery添加以下要求：
+ * - FHashGridFragment片段的只读访问权限
+ * - FMassSpatialIndexFragment片段可选，已经在统一空间索引中的实体不再重复添加
  */
 void UHashGridInitializeProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
-	EntityQuery.AddRequirement<FHashGridFragment>(EMassFragmentAccess::ReadWrite);
-	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
-	EntityQuery.AddSubsystemRequirement<UHashGridSubsystem>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FHashGridFragment>(EMassFragmentAccess::ReadOnly);
+	EntityQuery.AddRequirement<FMassSpatialIndexFragment>(EMassFragmentAccess::ReadOnly, EMassFragmentPresence::Optional);
 }
 /**
- * @brief ִйϣʼΪʵϣԪλ
+ * @brief 为新的哈希网格实体添加统一空间索引片段
  * 
- * úзʵ飬Ϊÿʵڹϣеλã
- * ʵӵӦԪС
+ * 该函数遍历所有符合条件的实体块，为尚未加入统一空间索引的实体延迟添加 FMassSpatialIndexFragment，
+ * 空间索引的观察者随后为其分配槽位；实体因带有 FHashGridFragment 而属于 HashGridExample 图层。
  * 
- * @param EntityManager ʵãڹʵ
- * @param Context ִãǰʵϢϵͳʽӿ
+ * @param EntityManager 实体管理器引用，用于管理实体数据
+ * @param Context 执行上下文引用，包含当前处理的实体信息
  */
 void UHashGridInitializeProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
 {
-    // ʵ飬ÿдʵĹϣʼ
     EntityQuery.ForEachEntityChunk(Context, [](FMassExecutionContext& Context)
         {
-            // ȡɱĹϣϵͳ
-            auto& HashGridSubsystem = Context.GetMutableSubsystemChecked<UHashGridSubsystem>();
-
-            // ȡ任Ƭκ͹ϣƬεֻͼ
-            const auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
-            const auto HashGridFragments = Context.GetMutableFragmentView<FHashGridFragment>();
-
-            // ǰеʵ壬ΪÿʵϣԪλ
-            const int32 NumEntities = Context.GetNumEntities();
-            for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
+            // 模板中已经包含空间索引片段的实体由空间索引直接处理
+            if (Context.GetFragmentView<FMassSpatialIndexFragment>().Num() > 0)
             {
-                auto& HashGridFragment = HashGridFragments[EntityIdx];
-                auto& TransformFragment = TransformFragments[EntityIdx];
-                auto Location = TransformFragment.GetTransform().GetLocation();
-
-                // ʵλü߽򣬲ʵӵϣݽṹ
-                FBox Bounds = { Location - HalfRange, Location + HalfRange };
-                HashGridFragment.CellLocation = HashGridSubsystem.HashGridData.Add(Context.GetEntity(EntityIdx), Bounds);
+                return;
             }
-        });
-}
 
-/**
- * 캯ʼUHashGridDestroyProcessor
- * 
- * ʼEntityQueryԱù۲ʵΪFHashGridFragmentṹ壬
- * ΪƳ
- */
-UHashGridDestroyProcessor::UHashGridDestroyProcessor() :
-    EntityQuery(*this)
-{
-    ObservedType = FHashGridFragment::StaticStruct();
-    Operation = EMassObservedOperation::Remove;
-}
-
-/**
- * òѯΪʵѯӱҪƬκϵͳҪ
- * 
- * @param EntityManager õʵòѯ
- * 
- * ˺ΪEntityQueryҪ
- * 1. ֻFHashGridFragmentƬ
- * 2. дUHashGridSubsystemϵͳ
- */
-void UHashGridDestroyProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
-{
-    EntityQuery.AddRequirement<FHashGridFragment>(EMassFragmentAccess::ReadOnly);
-    EntityQuery.AddSubsystemRequirement<UHashGridSubsystem>(EMassFragmentAccess::ReadWrite);
-}
-
-/**
- * @brief ִйϣٴӹϣݽṹƳʵ
- * 
- * úзʵ飬ӹϣϵͳƳÿʵĹϣݡ
- * Ҫʵʱڿռϣеá
- * 
- * @param EntityManager ʵãṩʵݵķ
- * @param Context ִãǰʵϢϵͳʽӿ
- */
-void UHashGridDestroyProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
-{
-    // ʵ飬ÿеʵִйϣ
-    EntityQuery.ForEachEntityChunk(Context, [](FMassExecutionContext& Context)
-        {
-            // ȡɱĹϣϵͳã޸Ĺϣ
-            auto& HashGridSubsystem = Context.GetMutableSubsystemChecked<UHashGridSubsystem>();
-
-            // ȡǰʵĹϣƬͼ
             const auto HashGridFragments = Context.GetFragmentView<FHashGridFragment>();
 
-            // ǰеʵ壬ӹϣƳ
-            const int32 NumEntities = Context.GetNumEntities();
-            for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
-            {
-                // ȡǰʵĹϣƬϢ
-                const auto& HashGridFragment = HashGridFragments[EntityIdx];
-
-                // ӹϣƳʵ弰ӦλϢ
-                HashGridSubsystem.HashGridData.Remove(Context.GetEntity(EntityIdx), HashGridFragment.CellLocation);
-            }
-        });
-}
-
-
-/**
- * 캯ʼUHashGridProcessor
- * ͨʼбʼEntityQuery
- */
-UHashGridProcessor::UHashGridProcessor() :
-    EntityQuery(*this)
-{
-}
-
-/**
- * òѯƬκϵͳҪ
- * @param EntityManager ʵĹãڹʵƬ
- */
-void UHashGridProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
-{
-    // ӹϣƬεĶдȨҪ
-    EntityQuery.AddRequirement<FHashGridFragment>(EMassFragmentAccess::ReadWrite);
-    // ӱ任ƬεֻȨҪ
-    EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadOnly);
-    // ӹϣϵͳĶдȨҪ
-    EntityQuery.AddSubsystemRequirement<UHashGridSubsystem>(EMassFragmentAccess::ReadWrite);
-}
-
-/**
- * ִд߼ʵڹϣеλø
- * @param EntityManager ʵãڹʵ
- * @param Context ִãṩִлϢ
- */
-void UHashGridProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
-{
-    // ÿʵ鲢ʵڹϣеλ
-    EntityQuery.ForEachEntityChunk(Context, [](FMassExecutionContext& Context)
-        {
-            // ȡɱĹϣϵͳ
-            auto& HashGridSubsystem = Context.GetMutableSubsystemChecked<UHashGridSubsystem>();
-
-            // ȡ任Ƭκ͹ϣƬεͼ
-            const auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
-            const auto HashGridFragments = Context.GetMutableFragmentView<FHashGridFragment>();
-
-            // ȡǰʵ
             const int32 NumEntities = Context.GetNumEntities();
-            
-            // ʵ壬ڹϣеλ
             for (int EntityIdx = 0; EntityIdx < NumEntities; EntityIdx++)
             {
-                auto& HashGridFragment = HashGridFragments[EntityIdx];
-                auto& TransformFragment = TransformFragments[EntityIdx];
-                const auto& Location = TransformFragment.GetTransform().GetLocation();
-
-                // ʵλü߽򣬲ƶʵ嵽µԪ
-                FBox Bounds = { Location - HalfRange, Location + HalfRange };
-                auto NewCellLocation = HashGridSubsystem.HashGridData.Move(Context.GetEntity(EntityIdx), HashGridFragment.CellLocation, Bounds);
-                HashGridFragment.CellLocation = NewCellLocation;
+                FMassSpatialIndexFragment SpatialIndexFragment;
+                SpatialIndexFragment.Radius = HashGridFragments[EntityIdx].Radius;
+                Context.Defer().PushCommand<FMassCommandAddFragmentInstances>(Context.GetEntity(EntityIdx), SpatialIndexFragment);
             }
         });
 }
@@ -209,9 +72,9 @@ void UHashGridProcessor::Execute(FMassEntityManager& EntityManager, FMassExecuti
 
 
 /**
- * ʼڲ״̬
- * @param Owner ߶
- * @param EntityManager ʵĹ
+ * 初始化处理器内部状态
+ * @param Owner 处理器的所有者对象引用
+ * @param EntityManager 实体管理器的共享引用
  */
 void UHashGridQueryProcessor::InitializeInternal(UObject& Owner, const TSharedRef<FMassEntityManager>& EntityManager)
 {
@@ -221,8 +84,8 @@ void UHashGridQueryProcessor::InitializeInternal(UObject& Owner, const TSharedRe
 }
 
 /**
- * òѯƬҪ
- * @param EntityManager ʵĹ
+ * 配置查询所需的片段要求
+ * @param EntityManager 实体管理器的共享引用
  */
 void UHashGridQueryProcessor::ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager)
 {
@@ -230,15 +93,15 @@ void UHashGridQueryProcessor::ConfigureQueries(const TSharedRef<FMassEntityManag
 }
 
 /**
- * źŲִʵ
- * @param EntityManager ʵ
- * @param Context ִ
- * @param EntitySignals ʵźƲ
+ * 处理信号并执行实体操作
+ * @param EntityManager 实体管理器引用
+ * @param Context 执行上下文引用
+ * @param EntitySignals 实体信号名称查找引用
  */
 void UHashGridQueryProcessor::SignalEntities(FMassEntityManager& EntityManager, FMassExecutionContext& Context,
     FMassSignalNameLookup& EntitySignals)
 {
-    // ʵ鲢еʵ
+    // 遍历所有实体块并处理其中的实体
     EntityQuery.ForEachEntityChunk(Context, [](FMassExecutionContext& Context)
         {
             const auto TransformFragments = Context.GetFragmentView<FTransformFragment>();
@@ -248,7 +111,7 @@ void UHashGridQueryProcessor::SignalEntities(FMassEntityManager& EntityManager,
             {
                 auto& TransformFragment = TransformFragments[EntityIdx];
 
-                // ٽյźŵʵ岢лƵԵ
+                // 销毁接收到信号的实体并在世界中绘制调试点
                 Context.Defer().DestroyEntity(Context.GetEntity(EntityIdx));
 
                 DrawDebugPoint(Context.GetWorld(), TransformFragment.GetTransform().GetLocation(), 50.f, FColor::Red, true);
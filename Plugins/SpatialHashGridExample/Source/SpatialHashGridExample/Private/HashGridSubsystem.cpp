@@ -7,28 +7,60 @@
 #include "MassEntityUtils.h"
 #include "MassSignalSubsystem.h"
 
+const FName UHashGridSubsystem::LayerName = FName(TEXT("HashGridExample"));
+
 /**
- * ָѡʵ
+ * 初始化子系统，在统一空间索引中注册本示例的图层
  * 
- * @param SelectedLocation ѡλ
- * @param Radius ѡİ뾶Χ
+ * @param Collection 子系统集合
+ */
+void UHashGridSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	SpatialIndex = Collection.InitializeDependency<UMassSpatialIndexSubsystem>();
+	SpatialIndexSnapshot = Collection.InitializeDependency<UMassSpatialIndexSnapshotSubsystem>();
+	if (SpatialIndex)
+	{
+		LayerMask = SpatialIndex->RegisterLayer(LayerName, FHashGridFragment::StaticStruct());
+	}
+}
+
+/**
+ * 在指定区域中选择实体
+ * 
+ * @param SelectedLocation 选择区域的中心位置
+ * @param Radius 选择区域的半径范围
  */
 void UHashGridSubsystem::SelectEntitiesInArea(const FVector& SelectedLocation, float Radius)
 {
-	// ѯ߽
-	FBox Bounds = { SelectedLocation - Radius, SelectedLocation + Radius };
 	TArray<FMassEntityHandle> EntitiesQueried;
 	
-	// ڹϣвѯָ߽ڵʵ
-	HashGridData.Query(Bounds, EntitiesQueried);
+	// 在统一空间索引上一帧的快照中查询半径范围内属于本示例图层的实体，不必等待本帧的索引更新
+	if (SpatialIndexSnapshot)
+	{
+		TArray<FMassSpatialIndexQueryResult> Results;
+		SpatialIndexSnapshot->GetSnapshot().QueryRadius(SelectedLocation, Radius, LayerMask, Results);
+		EntitiesQueried.Reserve(Results.Num());
+		for (const FMassSpatialIndexQueryResult& Result : Results)
+		{
+			EntitiesQueried.Add(Result.Entity);
+		}
+	}
 
-	// ȡʵźϵͳ
+	// 获取实体管理器和信号子系统
 	auto EntityManager = UE::Mass::Utils::GetEntityManager(GetWorld());
 	auto EntitySignalSubsystem = GetWorld()->GetSubsystem<UMassSignalSubsystem>();
+
+	// 快照中的实体可能已被销毁
+	if (EntityManager)
+	{
+		EntitiesQueried.RemoveAllSwap([&EntityManager](const FMassEntityHandle& Entity) { return !EntityManager->IsEntityValid(Entity); });
+	}
 	
-	// ûвѯʵֱӷ
+	// 如果没有查询到实体则直接返回
 	if (EntitiesQueried.IsEmpty()) { return; } 
 
-	// ѯʵ巢ź
+	// 向查询到的实体发送信号
 	EntitySignalSubsystem->SignalEntities(HashGridExample::Signals::EntityQueried, EntitiesQueried);
 }
@@ -12,7 +12,7 @@
 #include "HashGridExampleProcessors.generated.h"
 
 /**
- * 实体初始化时添加到哈希网格
+ * 实体获得 FHashGridFragment 时加入统一空间索引，之后的网格更新与移除都由空间索引负责
  */
 UCLASS()
 class SPATIALHASHGRIDEXAMPLE_API UHashGridInitializeProcessor : public UMassObserverProcessor
@@ -25,28 +25,6 @@ class SPATIALHASHGRIDEXAMPLE_API UHashGridInitializeProcessor : public UMassObse
 	
 };
 
-// 实体销毁时从哈希网格中移除
-UCLASS()
-class SPATIALHASHGRIDEXAMPLE_API UHashGridDestroyProcessor : public UMassObserverProcessor
-{
-	GENERATED_BODY()
-	UHashGridDestroyProcessor();
-	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
-	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
-	FMassEntityQuery EntityQuery;
-};
-
-// 实体移动时更新其在哈希网格中的位置
-UCLASS()
-class SPATIALHASHGRIDEXAMPLE_API UHashGridProcessor : public UMassProcessor
-{
-	GENERATED_BODY()
-	UHashGridProcessor();
-	virtual void ConfigureQueries(const TSharedRef<FMassEntityManager>& EntityManager) override;
-	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
-	FMassEntityQuery EntityQuery;
-};
-
 
 
 
@@ -4,7 +4,7 @@
 
 #include "CoreMinimal.h"
 
-#include "HashGridSubsystem.h"
+#include "MassEntityTypes.h"
 
 #include "HashGridFragments.generated.h"
 
@@ -12,31 +12,32 @@
  * 
  */
 /**
- * @brief ռHashGridExample::Signals˹ϣʾʹõź
+ * @brief 命名空间HashGridExample::Signals定义了哈希网格示例中使用的信号名称
  * 
- * ռʵѯ¼źűʶϵͳе¼ͨŻʹ
+ * 该命名空间包含了用于实体查询事件的信号标识符，供系统中的事件通信机制使用
  */
 namespace HashGridExample::Signals
 {
 	/**
-	 * @brief ʵѯ¼ź
+	 * @brief 实体查询事件的信号名称
 	 * 
-	 * ʵ屻ѯʱ¼ʶϵͳ䴫ʵѯϢ
+	 * 当实体被查询时触发的事件标识符，用于在系统组件间传递实体查询消息
 	 */
 	const FName EntityQueried = FName(TEXT("EntityQueried"));
 }
 
 /**
- * @brief ϣƬνṹ
+ * @brief 哈希网格片段结构体
  * 
- * ̳FMassFragmentĽṹ壬ڴ洢ʵڹϣеλϢ
- * ýṹΪECSܹеƬʵڵԪλ
+ * 继承自FMassFragment的结构体，标记实体属于示例的哈希网格。
+ * 带有该片段的实体会被加入统一空间索引的 HashGridExample 图层，网格位置由空间索引维护
  */
 USTRUCT()
 struct SPATIALHASHGRIDEXAMPLE_API FHashGridFragment : public FMassFragment
 {
 	GENERATED_BODY()
 public:
-	/** ʵڹϣеĵԪλϢ */
-	FHashGridExample::FCellLocation CellLocation;
+	/** 加入统一空间索引时在网格中占据的半径 */
+	UPROPERTY(EditAnywhere)
+	float Radius = 25.f;
 };
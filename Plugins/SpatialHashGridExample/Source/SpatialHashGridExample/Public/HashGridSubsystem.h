@@ -4,10 +4,10 @@
 
 #include "CoreMinimal.h"
 
-#include "HierarchicalHashGrid2D.h"
-
 #include "MassEntityTypes.h"
 
+#include "MassSpatialIndexSnapshotSubsystem.h"
+#include "MassSpatialIndexSubsystem.h"
 #include "MassSubsystemBase.h"
 
 #include "Subsystems/WorldSubsystem.h"
@@ -15,22 +15,9 @@
 
 
 /**
- * @brief һάλϣ͵ı
- * 
- * ͶһרڴFMassEntityHandleʵĶάλϣṹ
- * ģָĲ㼶ṹá
- * 
- * ģ˵
- * - һ(3)ʾĵһά
- * - ڶ(4)ʾĵڶά
- * - FMassEntityHandleʾ洢еʵ
- */
-typedef THierarchicalHashGrid2D<3, 4, FMassEntityHandle> FHashGridExample;
-
-/**
- * ϣϵͳ
- * ڹͲѯڹϣĿռݽṹ
- * ̳UMassSubsystemBase
+ * 哈希网格子系统类
+ * 带有 FHashGridFragment 的实体属于统一空间索引中的 HashGridExample 图层，本子系统只负责注册图层与按区域查询
+ * 继承自UMassSubsystemBase基类
  */
 UCLASS()
 class SPATIALHASHGRIDEXAMPLE_API UHashGridSubsystem : public UMassSubsystemBase
@@ -39,32 +26,44 @@ class SPATIALHASHGRIDEXAMPLE_API UHashGridSubsystem : public UMassSubsystemBase
 
 
 public:
-	/** ϣʵڴ洢͹ʵĿռֲϢ */
-	FHashGridExample HashGridData;
+	/** 统一空间索引中的图层名 */
+	static const FName LayerName;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
 
 	/**
-	 * ָѡʵ
-	 * ݸλúͰ뾶ΧҲѡڵʵ
+	 * 在指定区域内选择实体
+	 * 根据给定的位置和半径范围，查找并选择该区域内的所有实体
 	 * 
-	 * @param SelectedLocation ѡλ
-	 * @param Radius ѡİ뾶С
+	 * @param SelectedLocation 选择区域的中心位置坐标
+	 * @param Radius 选择区域的半径大小
 	 */
 	UFUNCTION(BlueprintCallable)
 	void SelectEntitiesInArea(const FVector& SelectedLocation, float Radius);
-	
+
+private:
+	UPROPERTY(Transient)
+	TObjectPtr<UMassSpatialIndexSubsystem> SpatialIndex;
+
+	/** 上一帧的只读快照，查询时不必等待本帧的索引更新 */
+	UPROPERTY(Transient)
+	TObjectPtr<UMassSpatialIndexSnapshotSubsystem> SpatialIndexSnapshot;
+
+	/** 本示例在统一空间索引中的图层掩码 */
+	FMassSpatialIndexLayerMask LayerMask = 0;
 };
 
 /**
- * UHashGridSubsystemⲿϵͳģػ
- * ϵͳǷϷ߳
+ * UHashGridSubsystem的外部子系统特性模板特化
+ * 定义该子系统是否仅在游戏线程中运行
  */
 template<>
 struct TMassExternalSubsystemTraits<UHashGridSubsystem> final
 {
-	/** ϵͳ߳ö */
+	/** 子系统线程特性枚举 */
 	enum
 	{
-		/** ǷϷ߳еı־falseʾڶ߳ */
+		/** 是否仅在游戏线程运行的标志，false表示可以在多个线程中运行 */
 		GameThreadOnly = false
 	};
 };
@@ -26,7 +26,7 @@ public class SpatialHashGridExample : ModuleRules
 			new string[]
 			{
 				"Core",
-                "MassEntity", "AIModule", "MassSignals"
+                "MassEntity", "AIModule", "MassSignals", "MassSpatialIndex"
 
                
 				// ... add other public dependencies that you statically link with here ...
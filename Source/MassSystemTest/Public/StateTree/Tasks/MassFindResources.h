@@ -17,10 +17,10 @@ struct FTransformFragment;
 struct FResourceUserFragment;
 
 /**
- * FMassFindResourceInstanceData ṹ
+ * FMassFindResourceInstanceData 结构体
  * 
- * ڴģ̬ϵͳвԴʵݽṹ
- * ҽϢѡԼԴò
+ * 用于在大规模生态系统中查找资源实例的数据结构。
+ * 包含查找结果信息、候选插槽以及资源配置参数。
  */
 USTRUCT()
 struct MASSSYSTEMTEST_API FMassFindResourceInstanceData
@@ -28,23 +28,23 @@ struct MASSSYSTEMTEST_API FMassFindResourceInstanceData
 	GENERATED_BODY()
 
 	
-	/** ܶĽ־ʾǷҵ˷Դ */
+	/** 查找智能对象的结果标志，表示是否找到了符合条件的资源 */
 	UPROPERTY(EditAnywhere, Category = Output)
 	bool bFoundSmartObject = false;
 
-	/** ҵܶѡۼϣ洢õԴλϢ */
+	/** 找到的智能对象候选插槽集合，存储可用的资源位置信息 */
 	UPROPERTY(EditAnywhere, Category = Output)
 	FMassSmartObjectCandidateSlots FoundSlots;
 
-	/** ľԴǩڱʶɸѡľ͵Դ */
+	/** 木材资源标签，用于标识和筛选木材类型的资源 */
 	UPROPERTY(EditAnywhere, Category = Parameter)
 	FGameplayTag WoodResourceTag;
 
-	/** ʯͷԴǩڱʶɸѡʯͷ͵Դ */
+	/** 石头资源标签，用于标识和筛选石头类型的资源 */
 	UPROPERTY(EditAnywhere, Category = Parameter)
 	FGameplayTag RockResourceTag;
 
-	/** ܶIDڸٺ͹Դ */
+	/** 智能对象请求ID，用于跟踪和管理资源查找请求 */
 	FMassSmartObjectRequestID RequestID;
 };
 